@@ -19,18 +19,19 @@
 #include <new>
 #include "CommandLineInterface.h"
 #include "CommandParser.h"
-#include "CppTimer.h"
+#include "CommandRecorder.h"
 #include "CppTimerManager.h"
 #include "CrashHandler.h"
+#include "InspectorNotifier.h"
+#include "InspectorTreeTracker.h"
 #include "Interrupter.h"
 #include "JsAppImpl.h"
+#include "MemoryStats.h"
 #include "PreviewerEngineLog.h"
 #include "SharedData.h"
 #include "TraceTool.h"
 #include "VirtualScreenImpl.h"
 
-static const int NOTIFY_INTERVAL_TIME = 1000; // Unit millisecond
-
 static void ApplyConfig()
 {
     std::string richConfigArgs = CommandParser::GetInstance().GetConfigPath();
@@ -42,37 +43,27 @@ static void ApplyConfig()
 
 static void NotifyInspectorChanged()
 {
-    if (!VirtualScreenImpl::GetInstance().isFrameUpdated) {
-        return;
-    }
-    VirtualScreenImpl::GetInstance().isFrameUpdated = false;
-
-    static std::string jsonTreeLast = "";
     std::string jsonTree = JsAppImpl::GetInstance().GetJSONTree();
-    if (jsonTree == jsonTreeLast) {
+    Json2::Value notification = JsonReader::CreateObject();
+    if (!InspectorTreeTracker::GetInstance().Update(jsonTree, notification)) {
         return;
     }
-
-    jsonTreeLast = jsonTree;
-    Json2::Value commandResult = JsonReader::CreateObject();
-    commandResult.Add("version", CommandLineInterface::COMMAND_VERSION.c_str());
-    commandResult.Add("command", "inspector");
-    commandResult.Add("result", jsonTree.c_str());
-    CommandLineInterface::GetInstance().SendJsonData(commandResult);
+    CommandLineInterface::GetInstance().SendJsonData(notification);
     ILOG("Send inspector json tree.");
 }
 
 static void ProcessCommand()
 {
-    static CppTimer inspectorNotifytimer(NotifyInspectorChanged);
-    inspectorNotifytimer.Start(NOTIFY_INTERVAL_TIME); // Notify per second
-    CppTimerManager::GetTimerManager().AddCppTimer(inspectorNotifytimer);
+    InspectorNotifier::GetInstance().SetRefreshCallback(NotifyInspectorChanged);
 
     VirtualScreenImpl::GetInstance().InitFrameCountTimer();
     while (!Interrupter::IsInterrupt()) {
         CommandLineInterface::GetInstance().ProcessCommand();
+        if (VirtualScreenImpl::GetInstance().isFrameUpdated.exchange(false)) {
+            InspectorNotifier::GetInstance().OnFrameUpdated();
+        }
         CppTimerManager::GetTimerManager().RunTimerTick();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CommandLineInterface::GetInstance().WaitForCommand(CppTimerManager::GetTimerManager().GetNextTimeout());
     }
     JsAppImpl::GetInstance().Stop();
 }
@@ -98,6 +89,7 @@ static void NewHandler()
 
 int main(int argc, char* argv[])
 {
+    MemoryStats::InstallJsonHooks();
     ILOG("RichPreviewer enter the main function.");
     std::set_new_handler(NewHandler); // 设置全局new处理函数
     auto richCrashHandler = std::make_unique<CrashHandler>();
@@ -110,9 +102,18 @@ int main(int argc, char* argv[])
         return ret;
     }
     InitSharedData();
-    if (parser.IsSet("s")) {
+    if (parser.IsSet("replay")) {
+        if (!CommandLineInterface::GetInstance().InitReplay(parser.GetReplayPath(), parser.GetReplaySpeed(),
+            parser.GetReplayReportPath())) {
+            FLOG("Replay recording can not be read.");
+            return 11; // 11: the code of invalid startup parameters
+        }
+    } else if (parser.IsSet("s")) {
         CommandLineInterface::GetInstance().Init(parser.Value("s"));
     }
+    if (parser.IsSet("record")) {
+        CommandRecorder::GetInstance().Start(parser.GetRecordPath());
+    }
 
     TraceTool::GetInstance().HandleTrace("Enter the main function");
 
@@ -22,11 +22,14 @@
 #include "CommandLineFactory.h"
 #include "CommandLineInterface.h"
 #include "CommandParser.h"
+#include "CommandRecorder.h"
 #include "CppTimerManager.h"
 #include "CrashHandler.h"
 #include "Interrupter.h"
 #include "JsAppImpl.h"
+#include "MemoryStats.h"
 #include "ModelManager.h"
+#include "PerfStats.h"
 #include "PreviewerEngineLog.h"
 #include "SharedData.h"
 #include "TimerTaskHandler.h"
@@ -94,11 +97,16 @@ static void SendJsHeapData()
 {
     OHOS::ACELite::JSHeapStatus status;
     OHOS::ACELite::JSI::GetJSHeapStatus(status);
+    PerfStats& stats = PerfStats::GetInstance();
+    stats.GetGauge(PerfMetric::JS_HEAP_TOTAL).Set(static_cast<int64_t>(status.totalBytes));
+    stats.GetGauge(PerfMetric::JS_HEAP_ALLOC).Set(static_cast<int64_t>(status.allocBytes));
+    stats.GetGauge(PerfMetric::JS_HEAP_PEAK).Set(static_cast<int64_t>(status.peakAllocBytes));
     CommandLineInterface::GetInstance().SendJSHeapMemory(status.totalBytes, status.allocBytes, status.peakAllocBytes);
 }
 
 int main(int argc, char* argv[])
 {
+    MemoryStats::InstallJsonHooks();
     ILOG("ThinPreviewer enter the main function.");
     std::set_new_handler(NewHandler);
     // thin device global exception handler
@@ -114,9 +122,18 @@ int main(int argc, char* argv[])
     }
     InitSharedData();
     InitSettings();
-    if (parser.IsSet("s")) {
+    if (parser.IsSet("replay")) {
+        if (!CommandLineInterface::GetInstance().InitReplay(parser.GetReplayPath(), parser.GetReplaySpeed(),
+            parser.GetReplayReportPath())) {
+            FLOG("Replay recording can not be read.");
+            return 11; // 11: the code of invalid startup parameters
+        }
+    } else if (parser.IsSet("s")) {
         CommandLineInterface::GetInstance().Init(parser.Value("s"));
     }
+    if (parser.IsSet("record")) {
+        CommandRecorder::GetInstance().Start(parser.GetRecordPath());
+    }
     ApplyConfig();
     JsAppImpl::GetInstance().InitJsApp();
     TraceTool::GetInstance().HandleTrace("Enter the main function");
@@ -135,7 +152,7 @@ int main(int argc, char* argv[])
     while (!Interrupter::IsInterrupt()) {
         CommandLineInterface::GetInstance().ProcessCommand();
         manager.RunTimerTick();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CommandLineInterface::GetInstance().WaitForCommand(manager.GetNextTimeout());
     }
     JsAppImpl::GetInstance().Stop();
     std::this_thread::sleep_for(std::chrono::milliseconds(500)); // sleep 500 ms
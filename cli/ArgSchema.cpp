@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ArgSchema.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "cJSON.h"
+#include "PreviewerEngineLog.h"
+
+bool ArgSchemaBase::AddField(Field&& field)
+{
+    if (fields.size() >= MAX_FIELDS) {
+        ELOG("ArgSchema: %s is one field too many", field.key.c_str());
+        return false;
+    }
+    fields.push_back(std::move(field));
+    return true;
+}
+
+bool ArgSchemaBase::Match(const Json2::Value& args, Json2::Value (&found)[MAX_FIELDS]) const
+{
+    if (!args.IsObject()) {
+        ELOG("Invalid number of arguments!");
+        return false;
+    }
+    for (const cJSON* item = args.GetJsonPtr()->child; item != nullptr; item = item->next) {
+        if (item->string == nullptr) {
+            continue;
+        }
+        for (size_t i = 0; i < fields.size(); i++) {
+            // The first of repeated keys counts, as for a lookup by key.
+            if (found[i].IsNull() && std::strcmp(fields[i].key.c_str(), item->string) == 0) {
+                found[i] = Json2::Value(const_cast<cJSON*>(item), false);
+                break;
+            }
+        }
+    }
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (found[i].IsNull()) {
+            if (fields[i].isRequired) {
+                ELOG("Invalid %s of arguments!", fields[i].key.c_str());
+                return false;
+            }
+            continue;
+        }
+        if (!IsFieldValid(fields[i], found[i])) {
+            ELOG("Invalid %s of arguments!", fields[i].key.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ArgSchemaBase::IsFieldValid(const Field& field, const Json2::Value& value) const
+{
+    switch (field.type) {
+        case FieldType::INT:
+            return value.IsInt() && value.AsInt() >= field.min && value.AsInt() <= field.max;
+        case FieldType::UINT:
+            return value.IsUInt() && value.AsUInt() >= field.min && value.AsUInt() <= field.max;
+        case FieldType::DOUBLE:
+            return value.IsDouble() && value.AsDouble() >= field.min && value.AsDouble() <= field.max;
+        case FieldType::BOOL:
+            return value.IsBool();
+        case FieldType::STRING:
+            return value.IsString() && (field.values.empty() ||
+                std::find(field.values.begin(), field.values.end(), value.AsString()) != field.values.end());
+        default:
+            return false;
+    }
+}
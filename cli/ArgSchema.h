@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ARGSCHEMA_H
+#define ARGSCHEMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "JsonReader.h"
+
+// The field checks of a schema, independent of the struct the fields go to.
+class ArgSchemaBase {
+public:
+    static constexpr size_t MAX_FIELDS = 8;
+
+protected:
+    enum class FieldType { INT, UINT, DOUBLE, BOOL, STRING };
+    struct Field {
+        std::string key;
+        FieldType type;
+        bool isRequired = true;
+        double min = 0;
+        double max = 0;
+        std::vector<std::string> values; // the strings allowed, any when empty
+    };
+
+    // Walks the members of args once. found[i] views the value of fields[i], or stays null when
+    // an optional field is absent. A member no field names is ignored, as are repeated keys.
+    bool Match(const Json2::Value& args, Json2::Value (&found)[MAX_FIELDS]) const;
+    bool IsFieldValid(const Field& field, const Json2::Value& value) const;
+    bool AddField(Field&& field);
+
+    std::vector<Field> fields;
+};
+
+// The arguments of a command, declared once: each field names its key, its type, the range or the
+// values it may take, and the member of Args it fills. Parse validates the arguments and fills Args
+// in the same walk, so the run reads the struct instead of looking the keys up again.
+//     static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+//         .Int("width", &SetArgs::width, minWidth, maxWidth)
+//         .String("reason", &SetArgs::reason, { "rotation", "resize" }).Optional();
+template <typename Args>
+class ArgSchema : public ArgSchemaBase {
+public:
+    ArgSchema& Int(const char* key, int32_t Args::* member, int32_t min = std::numeric_limits<int32_t>::min(),
+        int32_t max = std::numeric_limits<int32_t>::max())
+    {
+        return Add(key, FieldType::INT, member, min, max);
+    }
+    ArgSchema& UInt(const char* key, uint32_t Args::* member, uint32_t min = 0,
+        uint32_t max = std::numeric_limits<uint32_t>::max())
+    {
+        return Add(key, FieldType::UINT, member, min, max);
+    }
+    ArgSchema& Double(const char* key, double Args::* member, double min = std::numeric_limits<double>::lowest(),
+        double max = std::numeric_limits<double>::max())
+    {
+        return Add(key, FieldType::DOUBLE, member, min, max);
+    }
+    ArgSchema& Bool(const char* key, bool Args::* member)
+    {
+        return Add(key, FieldType::BOOL, member, 0, 0);
+    }
+    ArgSchema& String(const char* key, std::string Args::* member, std::vector<std::string> values = {})
+    {
+        return Add(key, FieldType::STRING, member, 0, 0, std::move(values));
+    }
+    // The field declared last may be left out, its member keeps the default of Args.
+    ArgSchema& Optional()
+    {
+        if (!fields.empty()) {
+            fields.back().isRequired = false;
+        }
+        return *this;
+    }
+
+    // Resets parsed to the defaults of Args and fills it. False if args do not match the schema.
+    bool Parse(const Json2::Value& args, Args& parsed) const
+    {
+        Json2::Value found[MAX_FIELDS];
+        if (!Match(args, found)) {
+            return false;
+        }
+        parsed = Args();
+        for (size_t i = 0; i < members.size(); i++) {
+            if (found[i].IsNull()) {
+                continue;
+            }
+            std::visit([&parsed, &found, i](auto member) { Assign(parsed.*member, found[i]); }, members[i]);
+        }
+        return true;
+    }
+
+private:
+    using Member = std::variant<int32_t Args::*, uint32_t Args::*, double Args::*, bool Args::*,
+        std::string Args::*>;
+
+    template <typename T>
+    ArgSchema& Add(const char* key, FieldType type, T Args::* member, double min, double max,
+        std::vector<std::string> values = {})
+    {
+        Field field;
+        field.key = key;
+        field.type = type;
+        field.min = min;
+        field.max = max;
+        field.values = std::move(values);
+        if (AddField(std::move(field))) {
+            members.push_back(member);
+        }
+        return *this;
+    }
+
+    static void Assign(int32_t& target, const Json2::Value& value)
+    {
+        target = value.AsInt();
+    }
+    static void Assign(uint32_t& target, const Json2::Value& value)
+    {
+        target = value.AsUInt();
+    }
+    static void Assign(double& target, const Json2::Value& value)
+    {
+        target = value.AsDouble();
+    }
+    static void Assign(bool& target, const Json2::Value& value)
+    {
+        target = value.AsBool();
+    }
+    static void Assign(std::string& target, const Json2::Value& value)
+    {
+        target = value.AsString();
+    }
+
+    std::vector<Member> members; // members[i] is filled from fields[i]
+};
+
+#endif // ARGSCHEMA_H
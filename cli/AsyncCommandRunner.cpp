@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncCommandRunner.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "PreviewerEngineLog.h"
+
+AsyncCommandRunner& AsyncCommandRunner::GetInstance()
+{
+    static AsyncCommandRunner instance;
+    return instance;
+}
+
+AsyncCommandRunner::AsyncCommandRunner() : isJobRunning(false), isRunningCancelled(false), isStopped(false)
+{
+}
+
+AsyncCommandRunner::~AsyncCommandRunner()
+{
+    Stop();
+}
+
+void AsyncCommandRunner::SetNotifier(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    notifier = std::move(callback);
+}
+
+void AsyncCommandRunner::Submit(const std::string& command, const std::string& requestId, uint32_t frameRequestId,
+    Job job)
+{
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        if (isStopped) {
+            ELOG("AsyncCommandRunner::Submit %s after stop", command.c_str());
+            return;
+        }
+        Task task;
+        task.completion.command = command;
+        task.completion.requestId = requestId;
+        task.completion.frameRequestId = frameRequestId;
+        task.job = std::move(job);
+        tasks.push_back(std::move(task));
+        if (!worker.joinable()) {
+            worker = std::thread(&AsyncCommandRunner::RunWorker, this);
+        }
+    }
+    tasksCondition.notify_one();
+}
+
+bool AsyncCommandRunner::Cancel(const std::string& requestId, Completion& cancelled)
+{
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    auto task = std::find_if(tasks.begin(), tasks.end(),
+        [&requestId](const Task& item) { return item.completion.requestId == requestId; });
+    if (task != tasks.end()) {
+        cancelled = std::move(task->completion);
+        tasks.erase(task);
+        return true;
+    }
+    auto completion = std::find_if(completed.begin(), completed.end(),
+        [&requestId](const Completion& item) { return item.requestId == requestId; });
+    if (completion != completed.end()) {
+        cancelled = std::move(*completion);
+        completed.erase(completion);
+        return true;
+    }
+    if (isJobRunning && running.requestId == requestId && !isRunningCancelled) {
+        // The job runs to its end, its reply is dropped.
+        isRunningCancelled = true;
+        cancelled = running;
+        return true;
+    }
+    return false;
+}
+
+void AsyncCommandRunner::TakeCompleted(std::vector<Completion>& completions)
+{
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    if (completions.empty()) {
+        completions.swap(completed);
+        return;
+    }
+    std::move(completed.begin(), completed.end(), std::back_inserter(completions));
+    completed.clear();
+}
+
+size_t AsyncCommandRunner::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    return tasks.size() + completed.size() + (isJobRunning ? 1 : 0);
+}
+
+void AsyncCommandRunner::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        isStopped = true;
+        tasks.clear();
+    }
+    tasksCondition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void AsyncCommandRunner::RunWorker()
+{
+    std::unique_lock<std::mutex> lock(tasksMutex);
+    while (true) {
+        tasksCondition.wait(lock, [this]() { return isStopped || !tasks.empty(); });
+        if (isStopped) {
+            return;
+        }
+        Task task = std::move(tasks.front());
+        tasks.pop_front();
+        running.command = task.completion.command;
+        running.requestId = task.completion.requestId;
+        running.frameRequestId = task.completion.frameRequestId;
+        isJobRunning = true;
+        isRunningCancelled = false;
+        lock.unlock();
+        task.job(task.completion.reply);
+        lock.lock();
+        isJobRunning = false;
+        if (isRunningCancelled) {
+            continue;
+        }
+        completed.push_back(std::move(task.completion));
+        std::function<void()> callback = notifier;
+        lock.unlock();
+        if (callback) {
+            callback();
+        }
+        lock.lock();
+    }
+}
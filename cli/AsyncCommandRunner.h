@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNCCOMMANDRUNNER_H
+#define ASYNCCOMMANDRUNNER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A reply ready to be written to the command pipe.
+struct CommandReply {
+    std::string data; // JSON text, or the deflated JSON text when isDeflated
+    bool isDeflated = false; // only in the framed protocol, as a TYPE_JSON_DEFLATE frame
+};
+
+// Finishes commands that carry a request id on a worker thread, so the command thread takes the next
+// command meanwhile. Jobs must not touch the engine, that work is done on the command thread before
+// submitting. Finished replies are written by the command thread, in the order they finished.
+class AsyncCommandRunner {
+public:
+    using Job = std::function<void(CommandReply& reply)>;
+    struct Completion {
+        std::string command;
+        std::string requestId;
+        uint32_t frameRequestId = 0;
+        CommandReply reply;
+    };
+
+    AsyncCommandRunner(const AsyncCommandRunner&) = delete;
+    AsyncCommandRunner& operator=(const AsyncCommandRunner&) = delete;
+    static AsyncCommandRunner& GetInstance();
+
+    // Called on the worker thread whenever a reply is ready, to wake up the command thread.
+    void SetNotifier(std::function<void()> callback);
+    void Submit(const std::string& command, const std::string& requestId, uint32_t frameRequestId, Job job);
+    // Drops the job or its reply. cancelled gets what is needed to answer the request instead.
+    bool Cancel(const std::string& requestId, Completion& cancelled);
+    void TakeCompleted(std::vector<Completion>& completions);
+    // Jobs submitted and not taken yet.
+    size_t GetPendingCount();
+    // Drops the queued jobs and joins the worker thread. Also runs on destruction.
+    void Stop();
+
+private:
+    AsyncCommandRunner();
+    ~AsyncCommandRunner();
+    struct Task {
+        Completion completion;
+        Job job;
+    };
+    void RunWorker();
+
+    std::mutex tasksMutex; // guards everything below
+    std::condition_variable tasksCondition;
+    std::deque<Task> tasks;
+    std::vector<Completion> completed;
+    Completion running; // ids of the job on the worker thread, its reply stays with the job
+    bool isJobRunning;
+    bool isRunningCancelled;
+    bool isStopped;
+    std::function<void()> notifier;
+    std::thread worker; // started by the first job
+};
+
+#endif // ASYNCCOMMANDRUNNER_H
@@ -16,29 +16,61 @@
 #include "CommandLine.h"
 
 #include <algorithm>
+#include <memory>
 #include <regex>
 #include <sstream>
 
+#include "CommandLineFactory.h"
 #include "CommandLineInterface.h"
 #include "CommandParser.h"
+#include "Compression.h"
+#include "InspectorNotifier.h"
+#include "InspectorTreeTracker.h"
 #include "Interrupter.h"
 #include "JsApp.h"
 #include "JsAppImpl.h"
 #include "JsonReader.h"
 #include "LanguageManagerImpl.h"
+#include "MemoryStats.h"
 #include "ModelConfig.h"
 #include "ModelManager.h"
 #include "MouseInputImpl.h"
 #include "MouseWheelImpl.h"
 #include "KeyInputImpl.h"
+#include "PerfOverlay.h"
+#include "PerfStats.h"
+#include "PerfStatsPublisher.h"
 #include "PreviewerEngineLog.h"
 #include "SharedData.h"
+#include "TraceEvent.h"
 #include "VirtualMessageImpl.h"
 #include "VirtualScreenImpl.h"
 
+const std::vector<std::string> CommandLine::liteSupportedLanguages = {"zh-CN", "en-US"};
+const std::vector<std::string> CommandLine::richSupportedLanguages = {
+    "zh_CN", "zh_HK", "zh_TW", "en_US", "en_GB", "ar_AE", "bg_BG", "bo_CN", "cs_CZ", "da_DK",
+    "de_DE", "el_GR", "en_PH", "es_ES", "es_LA", "fi_FI", "fr_FR", "he_IL", "hi_IN", "hu_HU",
+    "id_ID", "it_IT", "ja_JP", "kk_KZ", "ms_MY", "nl_NL", "no_NO", "pl_PL", "pt_BR", "pt_PT",
+    "ro_RO", "ru_RU", "sr_RS", "sv_SE", "th_TH", "tr_TR", "ug_CN", "uk_UA", "vi_VN"
+};
+const std::vector<std::string> CommandLine::LoadDocDevs = {
+    "phone", "tablet", "wearable", "car", "tv", "2in1", "default"
+};
+CommandReply CommandLine::sharedReply;
+const std::vector<std::string> BatchCommand::batchCommands = {
+    "ColorMode", "Orientation", "Language", "ResolutionSwitch", "FontSelect", "AvoidArea"
+};
+
 CommandLine::CommandLine(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : args(arg), cliSocket(socket), type(commandType), commandName("")
+    : argsView(const_cast<cJSON*>(arg.GetJsonPtr()), false), cliSocket(socket), type(commandType), commandName("")
+{
+}
+
+void CommandLine::Reset(CommandType commandType, const Json2::Value& arg)
 {
+    argsView = Json2::Value(const_cast<cJSON*>(arg.GetJsonPtr()), false);
+    type = commandType; // the results were cleared when they were sent
+    isSetArgsParsed = false;
 }
 
 CommandLine::~CommandLine()
@@ -59,14 +91,91 @@ void CommandLine::CheckAndRun()
 
 void CommandLine::SendResult()
 {
+    if (isResultSubmitted) {
+        isResultSubmitted = false;
+        return;
+    }
     if (commandResult.IsNull() || !commandResult.IsValid()) {
         return;
     }
-    cliSocket << commandResult.ToStyledString();
-    ELOG("SendResult commandResult: %s", commandResult.ToStyledString().c_str());
+    size_t threshold = isResultCompressible ? CommandLineInterface::GetInstance().GetCompressionThreshold() : 0;
+    EncodeResult(commandResult, commandName, cliSocket.IsMessageFramed(), threshold, sharedReply);
+    WriteReply(cliSocket, sharedReply, frameRequestId);
+    if (sharedReply.data.capacity() > MAX_SHARED_REPLY_CAPACITY) {
+        std::string().swap(sharedReply.data); // a rare huge reply does not keep its memory
+    }
     commandResult.Clear();
 }
 
+void CommandLine::SendResultAsync()
+{
+    if (clientRequestId.empty() || commandResult.IsNull() || !commandResult.IsValid()) {
+        return;
+    }
+    size_t threshold = isResultCompressible ? CommandLineInterface::GetInstance().GetCompressionThreshold() : 0;
+    auto result = std::make_shared<Json2::Value>(std::move(commandResult));
+    commandResult = JsonReader::CreateObject();
+    isResultSubmitted = true;
+    std::string command = commandName;
+    bool isFramed = cliSocket.IsMessageFramed();
+    AsyncCommandRunner::GetInstance().Submit(commandName, clientRequestId, frameRequestId,
+        [result, command, isFramed, threshold](CommandReply& reply) {
+            EncodeResult(*result, command, isFramed, threshold, reply);
+        });
+}
+
+void CommandLine::EncodeResult(Json2::Value& result, const std::string& command, bool isFramed, size_t threshold,
+                               CommandReply& reply)
+{
+    result.PrintTo(reply.data);
+    reply.isDeflated = false;
+    if (threshold == 0 || reply.data.size() < threshold) {
+        ELOG("SendResult commandResult: %s", reply.data.c_str());
+        return;
+    }
+    size_t size = reply.data.size();
+    std::string compressed;
+    if (isFramed) {
+        // The whole reply goes into a binary frame.
+        if (!Compression::Deflate(reply.data, compressed)) {
+            return;
+        }
+        reply.data.assign(compressed); // copied, the buffer keeps its capacity for the next reply
+        reply.isDeflated = true;
+    } else {
+        // The text protocol has to stay JSON, only the result string is replaced.
+        std::string content = result["result"].AsString();
+        if (!Compression::Deflate(content, compressed)) {
+            return;
+        }
+        Json2::Value data = JsonReader::CreateObject();
+        data.Add("encoding", "deflate");
+        data.Add("length", static_cast<int64_t>(content.size()));
+        data.Add("data", Compression::EncodeBase64(compressed).c_str());
+        result.Replace("result", data);
+        result.PrintTo(reply.data);
+    }
+    ILOG("SendResult %s compressed from %zu to %zu bytes", command.c_str(), size, compressed.size());
+}
+
+void CommandLine::WriteReply(const LocalSocket& socket, const CommandReply& reply, uint32_t frameRequestId)
+{
+    bool isFramed = socket.IsMessageFramed();
+    if (!reply.isDeflated) {
+        if (isFramed) {
+            socket.WriteFrame(MessageFrame::TYPE_JSON, frameRequestId, reply.data.data(), reply.data.size());
+        } else {
+            socket.WriteMessage(reply.data);
+        }
+        return;
+    }
+    if (!isFramed) {
+        ELOG("CommandLine::WriteReply deflated reply after a switch to the text protocol");
+        return;
+    }
+    socket.WriteFrame(MessageFrame::TYPE_JSON_DEFLATE, frameRequestId, reply.data.data(), reply.data.size());
+}
+
 void CommandLine::RunAndSendResultToManager()
 {
     Run();
@@ -78,11 +187,11 @@ void CommandLine::SendResultToManager()
     if (commandResultToManager.IsNull() || !commandResultToManager.IsValid()) {
         return;
     }
-    cliSocket << commandResultToManager.ToStyledString();
+    cliSocket.WriteMessage(commandResultToManager.ToString(), frameRequestId);
     commandResultToManager.Clear();
 }
 
-bool CommandLine::IsArgValid() const
+bool CommandLine::IsArgValid()
 {
     if (type == CommandType::GET) {
         return IsGetArgValid();
@@ -110,10 +219,23 @@ void CommandLine::SetCommandName(std::string command)
     this->commandName = command;
 }
 
+void CommandLine::SetClientRequestId(const std::string& requestId)
+{
+    clientRequestId = requestId;
+}
+
+void CommandLine::SetFrameRequestId(uint32_t requestId)
+{
+    frameRequestId = requestId;
+}
+
 void CommandLine::SetCommandResult(const std::string& resultType, const Json2::Value& resultContent)
 {
     this->commandResult.Add("version", CommandLineInterface::COMMAND_VERSION.c_str());
     this->commandResult.Add("command", this->commandName.c_str());
+    if (!clientRequestId.empty()) {
+        this->commandResult.Add("requestId", clientRequestId.c_str());
+    }
     this->commandResult.Add(resultType.c_str(), resultContent);
 }
 
@@ -141,15 +263,7 @@ void TouchAndMouseCommand::SetEventParams(EventParams& params)
     if (CommandParser::GetInstance().GetScreenMode() == CommandParser::ScreenMode::STATIC) {
         return;
     }
-    MouseInputImpl::GetInstance().SetMousePosition(params.x, params.y);
-    MouseInputImpl::GetInstance().SetMouseStatus(params.type);
-    MouseInputImpl::GetInstance().SetMouseButton(params.button);
-    MouseInputImpl::GetInstance().SetMouseAction(params.action);
-    MouseInputImpl::GetInstance().SetSourceType(params.sourceType);
-    MouseInputImpl::GetInstance().SetSourceTool(params.sourceTool);
-    MouseInputImpl::GetInstance().SetPressedBtns(params.pressedBtnsVec);
-    MouseInputImpl::GetInstance().SetAxisValues(params.axisVec);
-    MouseInputImpl::GetInstance().DispatchOsTouchEvent();
+    InputCoalescer::GetInstance().Push(params);
     std::stringstream ss;
     ss << "[";
     for (double val : params.axisVec) {
@@ -324,19 +438,21 @@ void TouchMoveCommand::RunAction()
 }
 
 PowerCommand::PowerCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool PowerCommand::IsSetArgValid() const
+const ArgSchema<PowerCommand::SetArgs>& PowerCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("Power") || !args["Power"].IsDouble()) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    double val = args["Power"].AsDouble();
-    if (!SharedData<double>::IsValid(SharedDataType::BATTERY_LEVEL, val)) {
-        ELOG("PowerCommand invalid value: %f", val);
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Double("Power", &SetArgs::power);
+    return schema;
+}
+
+bool PowerCommand::IsSetValueValid() const
+{
+    if (!SharedData<double>::IsValid(SharedDataType::BATTERY_LEVEL, setArgs.power)) {
+        ELOG("PowerCommand invalid value: %f", setArgs.power);
         return false;
     }
     return true;
@@ -353,14 +469,13 @@ void PowerCommand::RunGet()
 
 void PowerCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("Power") || !args["Power"].IsDouble()) {
+    if (!ParseSetArgs()) {
         ELOG("Invalid parameter of arguments!");
         return;
     }
-    double val = args["Power"].AsDouble();
-    SharedData<double>::SetData(SharedDataType::BATTERY_LEVEL, val);
+    SharedData<double>::SetData(SharedDataType::BATTERY_LEVEL, setArgs.power);
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set power run finished, the value is: %f", val);
+    ILOG("Set power run finished, the value is: %f", setArgs.power);
 }
 
 VolumeCommand::VolumeCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
@@ -368,7 +483,7 @@ VolumeCommand::VolumeCommand(CommandType commandType, const Json2::Value& arg, c
 {
 }
 
-bool VolumeCommand::IsSetArgValid() const
+bool VolumeCommand::IsSetArgValid()
 {
     return true;
 }
@@ -386,19 +501,21 @@ void VolumeCommand::RunSet()
 }
 
 BarometerCommand::BarometerCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool BarometerCommand::IsSetArgValid() const
+const ArgSchema<BarometerCommand::SetArgs>& BarometerCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("Barometer") || !args["Barometer"].IsUInt()) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    uint32_t val = args["Barometer"].AsUInt();
-    if (!SharedData<uint32_t>::IsValid(SharedDataType::PRESSURE_VALUE, val)) {
-        ELOG("Barometer invalid value: %d", val);
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .UInt("Barometer", &SetArgs::barometer);
+    return schema;
+}
+
+bool BarometerCommand::IsSetValueValid() const
+{
+    if (!SharedData<uint32_t>::IsValid(SharedDataType::PRESSURE_VALUE, setArgs.barometer)) {
+        ELOG("Barometer invalid value: %d", setArgs.barometer);
         return false;
     }
     return true;
@@ -415,190 +532,117 @@ void BarometerCommand::RunGet()
 
 void BarometerCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("Barometer") || !args["Barometer"].IsUInt()) {
+    if (!ParseSetArgs()) {
         ELOG("Invalid parameter of arguments!");
         return;
     }
-    uint32_t val = args["Barometer"].AsUInt();
-    SharedData<uint32_t>::SetData(SharedDataType::PRESSURE_VALUE, val);
+    SharedData<uint32_t>::SetData(SharedDataType::PRESSURE_VALUE, setArgs.barometer);
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set barometer run finished, the value is: %d", val);
+    ILOG("Set barometer run finished, the value is: %d", setArgs.barometer);
 }
 
 ResolutionSwitchCommand::ResolutionSwitchCommand(CommandType commandType,
                                                  const Json2::Value& arg,
                                                  const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool ResolutionSwitchCommand::IsSetArgValid() const
+const ArgSchema<ResolutionSwitchCommand::SetArgs>& ResolutionSwitchCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("originWidth") || !args.IsMember("originHeight") || !args.IsMember("width") ||
-        !args.IsMember("height") || !args.IsMember("screenDensity")) {
-        ELOG("Invalid param of arguments!");
-        return false;
-    }
-    if (!args["originWidth"].IsInt() || !args["originHeight"].IsInt() ||
-        !args["screenDensity"].IsInt() || !args["width"].IsInt() || !args["height"].IsInt()) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!IsIntValValid()) {
-        return false;
-    }
-    if (args.IsMember("reason")) {
-        if (!args["reason"].IsString()) {
-            return false;
-        }
-        std::string reason = args["reason"].AsString();
-        if (reason != "rotation" && reason != "resize" && reason != "undefined") {
-            ELOG("Invalid value of reason!");
-            return false;
-        }
-    }
-    return true;
-}
-
-bool ResolutionSwitchCommand::IsIntValValid() const
-{
-    if (args.IsNull() || !args.IsMember("originWidth") || !args["originWidth"].IsInt() ||
-        !args.IsMember("originHeight") || !args["originHeight"].IsInt() ||
-        !args.IsMember("width") || !args["width"].IsInt() ||
-        !args.IsMember("height") || !args["height"].IsInt() ||
-        !args.IsMember("screenDensity") || !args["screenDensity"].IsInt()) {
-        ELOG("Invalid parameters of arguments!");
-        return false;
-    }
-    if (args["originWidth"].AsInt() < minWidth || args["originWidth"].AsInt() > maxWidth ||
-        args["originHeight"].AsInt() < minWidth || args["originHeight"].AsInt() > maxWidth ||
-        args["width"].AsInt() < minWidth || args["width"].AsInt() > maxWidth ||
-        args["height"].AsInt() < minWidth || args["height"].AsInt() > maxWidth) {
-        ELOG("width or height is out of range %d-%d", minWidth, maxWidth);
-        return false;
-    }
-    if (args["screenDensity"].AsInt() < minDpi || args["screenDensity"].AsInt() > maxDpi) {
-        ELOG("screenDensity is out of range %d-%d", minDpi, maxDpi);
-        return false;
-    }
-    return true;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Int("originWidth", &SetArgs::originWidth, minWidth, maxWidth)
+        .Int("originHeight", &SetArgs::originHeight, minWidth, maxWidth)
+        .Int("width", &SetArgs::width, minWidth, maxWidth)
+        .Int("height", &SetArgs::height, minWidth, maxWidth)
+        .Int("screenDensity", &SetArgs::screenDensity, minDpi, maxDpi)
+        .String("reason", &SetArgs::reason, { "rotation", "resize", "undefined" }).Optional();
+    return schema;
 }
 
 void ResolutionSwitchCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("originWidth") || !args["originWidth"].IsInt() ||
-        !args.IsMember("originHeight") || !args["originHeight"].IsInt() ||
-        !args.IsMember("width") || !args["width"].IsInt() ||
-        !args.IsMember("height") || !args["height"].IsInt() ||
-        !args.IsMember("screenDensity") || !args["screenDensity"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    int32_t originWidth = args["originWidth"].AsInt();
-    int32_t originHeight = args["originHeight"].AsInt();
-    int32_t width = args["width"].AsInt();
-    int32_t height = args["height"].AsInt();
-    int32_t screenDensity = args["screenDensity"].AsInt();
-    std::string reason = "undefined";
-    if (args.IsMember("reason") || args["reason"].IsString()) {
-        reason = args["reason"].AsString();
-    }
-    ResolutionParam param(originWidth, originHeight, width, height);
-    JsAppImpl::GetInstance().ResolutionChanged(param, screenDensity, reason);
+    ResolutionParam param(setArgs.originWidth, setArgs.originHeight, setArgs.width, setArgs.height);
+    JsAppImpl::GetInstance().ResolutionChanged(param, setArgs.screenDensity, setArgs.reason);
     SetCommandResult("result", JsonReader::CreateBool(true));
     ILOG("ResolutionSwitch run finished.");
 }
 
 OrientationCommand::OrientationCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool OrientationCommand::IsSetArgValid() const
+const ArgSchema<OrientationCommand::SetArgs>& OrientationCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("Orientation") || !args["Orientation"].IsString()) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (args["Orientation"].AsString() != "portrait" && args["Orientation"].AsString() != "landscape") {
-        ELOG("Orientation just support [portrait,landscape].");
-        return false;
-    }
-    return true;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .String("Orientation", &SetArgs::orientation, { "portrait", "landscape" });
+    return schema;
 }
 
 void OrientationCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("Orientation") || !args["Orientation"].IsString()) {
+    if (!ParseSetArgs()) {
         ELOG("Invalid parameter of arguments!");
         return;
     }
-    std::string commandOrientation = args["Orientation"].AsString();
-    std::string currentOrientation = JsAppImpl::GetInstance().GetOrientation();
-    if (commandOrientation != currentOrientation) {
-        JsAppImpl::GetInstance().OrientationChanged(commandOrientation);
+    if (setArgs.orientation != JsAppImpl::GetInstance().GetOrientation()) {
+        JsAppImpl::GetInstance().OrientationChanged(setArgs.orientation);
     }
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set Orientation run finished, Orientation is: %s", args["Orientation"].AsString().c_str());
+    ILOG("Set Orientation run finished, Orientation is: %s", setArgs.orientation.c_str());
 }
 
 ColorModeCommand::ColorModeCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool ColorModeCommand::IsSetArgValid() const
+const ArgSchema<ColorModeCommand::SetArgs>& ColorModeCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("ColorMode") || !args["ColorMode"].IsString()) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-
-    if (args["ColorMode"].AsString() != "light" && args["ColorMode"].AsString() != "dark") {
-        ELOG("ColorMode just support [light,dark]");
-        return false;
-    }
-    return true;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .String("ColorMode", &SetArgs::colorMode, { "light", "dark" });
+    return schema;
 }
 
 void ColorModeCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("ColorMode") || !args["ColorMode"].IsString()) {
+    if (!ParseSetArgs()) {
         ELOG("Invalid parameter of arguments!");
         return;
     }
-    std::string commandColorMode = args["ColorMode"].AsString();
-    std::string currentColorMode = JsAppImpl::GetInstance().GetColorMode();
-    if (commandColorMode != currentColorMode) {
-        JsAppImpl::GetInstance().SetArgsColorMode(args["ColorMode"].AsString());
-        JsAppImpl::GetInstance().ColorModeChanged(commandColorMode);
+    if (setArgs.colorMode != JsAppImpl::GetInstance().GetColorMode()) {
+        JsAppImpl::GetInstance().SetArgsColorMode(setArgs.colorMode);
+        JsAppImpl::GetInstance().ColorModeChanged(setArgs.colorMode);
     }
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set ColorMode run finished, ColorMode is: %s", args["ColorMode"].AsString().c_str());
+    ILOG("Set ColorMode run finished, ColorMode is: %s", setArgs.colorMode.c_str());
 }
 
 FontSelectCommand::FontSelectCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool FontSelectCommand::IsSetArgValid() const
+const ArgSchema<FontSelectCommand::SetArgs>& FontSelectCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("FontSelect") || !args["FontSelect"].IsBool()) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    return true;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Bool("FontSelect", &SetArgs::fontSelect);
+    return schema;
 }
 
 void FontSelectCommand::RunSet()
 {
     SetCommandResult("result", JsonReader::CreateBool(true));
-    if (args.IsNull() || !args.IsMember("FontSelect") || !args["FontSelect"].IsBool()) {
+    if (!ParseSetArgs()) {
         ELOG("Invalid parameter of arguments!");
         return;
     }
-    ILOG("FontSelect finished, currentSelect is: %s", args["FontSelect"].AsBool() ? "true" : "false");
+    ILOG("FontSelect finished, currentSelect is: %s", setArgs.fontSelect ? "true" : "false");
 }
 
 MemoryRefreshCommand::MemoryRefreshCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
@@ -606,7 +650,7 @@ MemoryRefreshCommand::MemoryRefreshCommand(CommandType commandType, const Json2:
 {
 }
 
-bool MemoryRefreshCommand::IsSetArgValid() const
+bool MemoryRefreshCommand::IsSetArgValid()
 {
     if (args.IsNull()) {
         ELOG("Invalid MemoryRefresh of arguments!");
@@ -628,7 +672,7 @@ LoadDocumentCommand::LoadDocumentCommand(CommandType commandType, const Json2::V
 {
 }
 
-bool LoadDocumentCommand::IsSetArgValid() const
+bool LoadDocumentCommand::IsSetArgValid()
 {
     if (args.IsNull() || !args.IsMember("url") || !args.IsMember("className") || !args.IsMember("previewParam") ||
         !args["url"].IsString() || !args["className"].IsString() || !args["previewParam"].IsObject()) {
@@ -723,7 +767,7 @@ ReloadRuntimePageCommand::ReloadRuntimePageCommand(CommandType commandType,
 {
 }
 
-bool ReloadRuntimePageCommand::IsSetArgValid() const
+bool ReloadRuntimePageCommand::IsSetArgValid()
 {
     if (args.IsNull() || !args.IsMember("ReloadRuntimePage") || !args["ReloadRuntimePage"].IsString()) {
         ELOG("Invalid number of arguments!");
@@ -777,7 +821,7 @@ LanguageCommand::LanguageCommand(CommandType commandType, const Json2::Value& ar
 {
 }
 
-bool LanguageCommand::IsSetArgValid() const
+bool LanguageCommand::IsSetArgValid()
 {
     if (args.IsNull() || !args.IsMember("Language") || !args["Language"].IsString()) {
         ELOG("Invalid number of arguments!");
@@ -856,7 +900,7 @@ LocationCommand::LocationCommand(CommandType commandType, const Json2::Value& ar
 {
 }
 
-bool LocationCommand::IsSetArgValid() const
+bool LocationCommand::IsSetArgValid()
 {
     if (args.IsNull() || !args.IsMember("latitude") || !args.IsMember("longitude") || !args["latitude"].IsString() ||
         !args["longitude"].IsString()) {
@@ -963,7 +1007,7 @@ std::vector<char> DistributedCommunicationsCommand::StringToCharVector(std::stri
 KeepScreenOnStateCommand::KeepScreenOnStateCommand(CommandType commandType,
                                                    const Json2::Value& arg,
                                                    const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
@@ -977,31 +1021,24 @@ void KeepScreenOnStateCommand::RunGet()
 
 void KeepScreenOnStateCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("KeepScreenOnState") || !args["KeepScreenOnState"].IsBool()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    SharedData<bool>::SetData(SharedDataType::KEEP_SCREEN_ON, args["KeepScreenOnState"].AsBool());
+    SharedData<bool>::SetData(SharedDataType::KEEP_SCREEN_ON, setArgs.keepScreenOnState);
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set keepScreenOnState run finished, the value is: %s",
-        args["KeepScreenOnState"].AsBool() ? "true" : "false");
+    ILOG("Set keepScreenOnState run finished, the value is: %s", setArgs.keepScreenOnState ? "true" : "false");
 }
 
-bool KeepScreenOnStateCommand::IsSetArgValid() const
+const ArgSchema<KeepScreenOnStateCommand::SetArgs>& KeepScreenOnStateCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("KeepScreenOnState")) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!args["KeepScreenOnState"].IsBool()) {
-        ELOG("arg KeepScreenOnState id not bool");
-        return false;
-    }
-    return true;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Bool("KeepScreenOnState", &SetArgs::keepScreenOnState);
+    return schema;
 }
 
 WearingStateCommand::WearingStateCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
@@ -1015,26 +1052,24 @@ void WearingStateCommand::RunGet()
 
 void WearingStateCommand::RunSet()
 {
-    SharedData<bool>::SetData(SharedDataType::WEARING_STATE, args["WearingState"].AsBool());
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
+        return;
+    }
+    SharedData<bool>::SetData(SharedDataType::WEARING_STATE, setArgs.wearingState);
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set wearingState run finished, the value is: %s", args["WearingState"].AsBool() ? "true" : "false");
+    ILOG("Set wearingState run finished, the value is: %s", setArgs.wearingState ? "true" : "false");
 }
 
-bool WearingStateCommand::IsSetArgValid() const
+const ArgSchema<WearingStateCommand::SetArgs>& WearingStateCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("WearingState")) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!args["WearingState"].IsBool()) {
-        ILOG("arg WearingState is not bool");
-        return false;
-    }
-    return true;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Bool("WearingState", &SetArgs::wearingState);
+    return schema;
 }
 
 BrightnessModeCommand::BrightnessModeCommand(CommandType commandType, const Json2::Value& arg,
-    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+    const LocalSocket& socket) : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
@@ -1048,36 +1083,33 @@ void BrightnessModeCommand::RunGet()
 
 void BrightnessModeCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("BrightnessMode") || !args["BrightnessMode"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    SharedData<uint8_t>::SetData(SharedDataType::BRIGHTNESS_MODE,
-                                 static_cast<uint8_t>(args["BrightnessMode"].AsInt()));
+    SharedData<uint8_t>::SetData(SharedDataType::BRIGHTNESS_MODE, static_cast<uint8_t>(setArgs.brightnessMode));
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set brightnessMode run finished, the value is: %d", args["BrightnessMode"].AsInt());
+    ILOG("Set brightnessMode run finished, the value is: %d", setArgs.brightnessMode);
 }
 
-bool BrightnessModeCommand::IsSetArgValid() const
+const ArgSchema<BrightnessModeCommand::SetArgs>& BrightnessModeCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("BrightnessMode")) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!args["BrightnessMode"].IsInt()) {
-        ELOG("BrightnessMode is not int");
-        return false;
-    }
-    uint8_t temp = static_cast<uint8_t>(args["BrightnessMode"].AsInt());
-    if (!SharedData<uint8_t>::IsValid(SharedDataType::BRIGHTNESS_MODE, temp)) {
-        ELOG("BrightnessModeCommand invalid value: %d", temp);
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Int("BrightnessMode", &SetArgs::brightnessMode);
+    return schema;
+}
+
+bool BrightnessModeCommand::IsSetValueValid() const
+{
+    if (!SharedData<uint8_t>::IsValid(SharedDataType::BRIGHTNESS_MODE, static_cast<uint8_t>(setArgs.brightnessMode))) {
+        ELOG("BrightnessModeCommand invalid value: %d", setArgs.brightnessMode);
         return false;
     }
     return true;
 }
 
 ChargeModeCommand::ChargeModeCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
@@ -1091,36 +1123,33 @@ void ChargeModeCommand::RunGet()
 
 void ChargeModeCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("ChargeMode") || !args["ChargeMode"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    SharedData<uint8_t>::SetData(SharedDataType::BATTERY_STATUS,
-                                 static_cast<uint8_t>(args["ChargeMode"].AsInt()));
+    SharedData<uint8_t>::SetData(SharedDataType::BATTERY_STATUS, static_cast<uint8_t>(setArgs.chargeMode));
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set chargeMode run finished, the value is: %d", args["ChargeMode"].AsInt());
+    ILOG("Set chargeMode run finished, the value is: %d", setArgs.chargeMode);
 }
 
-bool ChargeModeCommand::IsSetArgValid() const
+const ArgSchema<ChargeModeCommand::SetArgs>& ChargeModeCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("ChargeMode")) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!args["ChargeMode"].IsInt()) {
-        ELOG("ChargeMode is not int");
-        return false;
-    }
-    uint8_t temp = static_cast<uint8_t>(args["ChargeMode"].AsInt());
-    if (!SharedData<uint8_t>::IsValid(SharedDataType::BATTERY_STATUS, temp)) {
-        ELOG("ChargeModeCommand invalid value: %d", temp);
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Int("ChargeMode", &SetArgs::chargeMode);
+    return schema;
+}
+
+bool ChargeModeCommand::IsSetValueValid() const
+{
+    if (!SharedData<uint8_t>::IsValid(SharedDataType::BATTERY_STATUS, static_cast<uint8_t>(setArgs.chargeMode))) {
+        ELOG("ChargeModeCommand invalid value: %d", setArgs.chargeMode);
         return false;
     }
     return true;
 }
 
 BrightnessCommand::BrightnessCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
@@ -1134,37 +1163,33 @@ void BrightnessCommand::RunGet()
 
 void BrightnessCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("Brightness") || !args["Brightness"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    SharedData<uint8_t>::SetData(SharedDataType::BRIGHTNESS_VALUE,
-                                 static_cast<uint8_t>(args["Brightness"].AsInt()));
-    Json2::Value result = JsonReader::CreateBool(true);
-    SetCommandResult("result", result);
-    ILOG("Set brightness run finished, the value is: %d", args["Brightness"].AsInt());
+    SharedData<uint8_t>::SetData(SharedDataType::BRIGHTNESS_VALUE, static_cast<uint8_t>(setArgs.brightness));
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set brightness run finished, the value is: %d", setArgs.brightness);
 }
 
-bool BrightnessCommand::IsSetArgValid() const
+const ArgSchema<BrightnessCommand::SetArgs>& BrightnessCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("Brightness")) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!args["Brightness"].IsInt()) {
-        ELOG("Brightness is not int");
-        return false;
-    }
-    uint8_t temp = static_cast<uint8_t>(args["Brightness"].AsInt());
-    if (!SharedData<uint8_t>::IsValid(SharedDataType::BRIGHTNESS_VALUE, temp)) {
-        ELOG("BrightnessCommand invalid value: ", temp);
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Int("Brightness", &SetArgs::brightness);
+    return schema;
+}
+
+bool BrightnessCommand::IsSetValueValid() const
+{
+    if (!SharedData<uint8_t>::IsValid(SharedDataType::BRIGHTNESS_VALUE, static_cast<uint8_t>(setArgs.brightness))) {
+        ELOG("BrightnessCommand invalid value: %d", setArgs.brightness);
         return false;
     }
     return true;
 }
 
 HeartRateCommand::HeartRateCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
@@ -1178,40 +1203,33 @@ void HeartRateCommand::RunGet()
 
 void HeartRateCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("HeartRate") || !args["HeartRate"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    SharedData<uint8_t>::SetData(SharedDataType::HEARTBEAT_VALUE,
-                                 static_cast<uint8_t>(args["HeartRate"].AsInt()));
+    SharedData<uint8_t>::SetData(SharedDataType::HEARTBEAT_VALUE, static_cast<uint8_t>(setArgs.heartRate));
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set heartRate run finished, the value is: %d", args["HeartRate"].AsInt());
+    ILOG("Set heartRate run finished, the value is: %d", setArgs.heartRate);
 }
 
-bool HeartRateCommand::IsSetArgValid() const
+const ArgSchema<HeartRateCommand::SetArgs>& HeartRateCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("HeartRate")) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!args["HeartRate"].IsInt()) {
-        ELOG("HeartRate is not int");
-        return false;
-    }
-    if (args["HeartRate"].AsInt() > UINT8_MAX) {
-        ELOG("Invalid arguments!");
-        return false;
-    }
-    uint8_t temp = static_cast<uint8_t>(args["HeartRate"].AsInt());
-    if (!SharedData<uint8_t>::IsValid(SharedDataType::HEARTBEAT_VALUE, temp)) {
-        ELOG("HeartRateCommand invalid value: %d", temp);
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Int("HeartRate", &SetArgs::heartRate, std::numeric_limits<int32_t>::min(), UINT8_MAX);
+    return schema;
+}
+
+bool HeartRateCommand::IsSetValueValid() const
+{
+    if (!SharedData<uint8_t>::IsValid(SharedDataType::HEARTBEAT_VALUE, static_cast<uint8_t>(setArgs.heartRate))) {
+        ELOG("HeartRateCommand invalid value: %d", setArgs.heartRate);
         return false;
     }
     return true;
 }
 
 StepCountCommand::StepCountCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
@@ -1225,30 +1243,26 @@ void StepCountCommand::RunGet()
 
 void StepCountCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("StepCount") || !args["StepCount"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    SharedData<uint32_t>::SetData(SharedDataType::SUMSTEP_VALUE,
-                                  static_cast<uint32_t>(args["StepCount"].AsInt()));
+    SharedData<uint32_t>::SetData(SharedDataType::SUMSTEP_VALUE, setArgs.stepCount);
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set stepCount run finished, the value is: %d", args["StepCount"].AsInt());
+    ILOG("Set stepCount run finished, the value is: %d", setArgs.stepCount);
 }
 
-bool StepCountCommand::IsSetArgValid() const
+const ArgSchema<StepCountCommand::SetArgs>& StepCountCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("StepCount")) {
-        ELOG("Invalid number of arguments!");
-        return false;
-    }
-    if (!args["StepCount"].IsUInt()) {
-        ELOG("StepCount is not int");
-        return false;
-    }
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .UInt("StepCount", &SetArgs::stepCount);
+    return schema;
+}
 
-    uint32_t temp = args["StepCount"].AsUInt();
-    if (!SharedData<uint32_t>::IsValid(SharedDataType::SUMSTEP_VALUE, temp)) {
-        ELOG("StepCountCommand invalid value: %d", temp);
+bool StepCountCommand::IsSetValueValid() const
+{
+    if (!SharedData<uint32_t>::IsValid(SharedDataType::SUMSTEP_VALUE, setArgs.stepCount)) {
+        ELOG("StepCountCommand invalid value: %d", setArgs.stepCount);
         return false;
     }
     return true;
@@ -1257,6 +1271,7 @@ bool StepCountCommand::IsSetArgValid() const
 InspectorJSONTree::InspectorJSONTree(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
     : CommandLine(commandType, arg, socket)
 {
+    isResultCompressible = true;
 }
 
 void InspectorJSONTree::RunAction()
@@ -1267,12 +1282,14 @@ void InspectorJSONTree::RunAction()
         str = "{\"children\":\"empty json tree\"}";
     }
     SetCommandResult("result", JsonReader::CreateString(str));
+    SendResultAsync();
     ILOG("SendJsonTree end!");
 }
 
 InspectorDefault::InspectorDefault(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
     : CommandLine(commandType, arg, socket)
 {
+    isResultCompressible = true;
 }
 
 void InspectorDefault::RunAction()
@@ -1280,9 +1297,108 @@ void InspectorDefault::RunAction()
     ILOG("GetDefaultJsonTree run!");
     std::string str = JsAppImpl::GetInstance().GetDefaultJSONTree();
     SetCommandResult("result", JsonReader::CreateString(str));
+    SendResultAsync();
     ILOG("SendDefaultJsonTree end!");
 }
 
+InspectorIncrementalCommand::InspectorIncrementalCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool InspectorIncrementalCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("enable") || !args["enable"].IsBool()) {
+        ELOG("Invalid InspectorIncremental of arguments!");
+        return false;
+    }
+    return true;
+}
+
+bool InspectorIncrementalCommand::IsActionArgValid() const
+{
+    if (!args.IsNull() && args.IsMember("treeVersion") && !args["treeVersion"].IsUInt()) {
+        ELOG("Invalid InspectorIncremental treeVersion!");
+        return false;
+    }
+    return true;
+}
+
+void InspectorIncrementalCommand::RunSet()
+{
+    bool enable = args["enable"].AsBool();
+    InspectorTreeTracker& tracker = InspectorTreeTracker::GetInstance();
+    tracker.SetIncremental(enable);
+    if (!enable) {
+        SetCommandResult("result", JsonReader::CreateBool(true));
+        return;
+    }
+    // The snapshot in the reply is the baseline for the patches that follow.
+    Json2::Value snapshot = JsonReader::CreateObject();
+    tracker.Resync(JsAppImpl::GetInstance().GetJSONTree(), -1, snapshot);
+    SetCommandResult("result", snapshot);
+    ILOG("Set InspectorIncremental run finished.");
+}
+
+void InspectorIncrementalCommand::RunAction()
+{
+    int64_t clientVersion = -1;
+    if (!args.IsNull() && args.IsMember("treeVersion")) {
+        clientVersion = args["treeVersion"].AsInt64();
+    }
+    Json2::Value snapshot = JsonReader::CreateObject();
+    InspectorTreeTracker::GetInstance().Resync(JsAppImpl::GetInstance().GetJSONTree(), clientVersion, snapshot);
+    SetCommandResult("result", snapshot);
+    ILOG("InspectorIncremental resync run finished.");
+}
+
+InspectorRefreshCommand::InspectorRefreshCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool InspectorRefreshCommand::IsSetArgValid()
+{
+    if (args.IsNull() || (!args.IsMember("debounce") && !args.IsMember("maxRate"))) {
+        ELOG("Invalid InspectorRefresh of arguments!");
+        return false;
+    }
+    if (args.IsMember("debounce") && (!args["debounce"].IsInt() || args["debounce"].AsInt() < 0 ||
+        args["debounce"].AsInt() > InspectorNotifier::MAX_DEBOUNCE_TIME)) {
+        ELOG("Invalid InspectorRefresh debounce!");
+        return false;
+    }
+    if (args.IsMember("maxRate") && (!args["maxRate"].IsInt() || args["maxRate"].AsInt() <= 0 ||
+        args["maxRate"].AsInt() > static_cast<int32_t>(InspectorNotifier::MAX_RATE))) {
+        ELOG("Invalid InspectorRefresh maxRate!");
+        return false;
+    }
+    return true;
+}
+
+void InspectorRefreshCommand::RunGet()
+{
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("debounce", InspectorNotifier::GetInstance().GetDebounceTime());
+    result.Add("maxRate", InspectorNotifier::GetInstance().GetMaxRate());
+    SetCommandResult("result", result);
+    ILOG("Get InspectorRefresh run finished.");
+}
+
+void InspectorRefreshCommand::RunSet()
+{
+    InspectorNotifier& notifier = InspectorNotifier::GetInstance();
+    if (args.IsMember("debounce")) {
+        notifier.SetDebounceTime(args["debounce"].AsInt());
+    }
+    if (args.IsMember("maxRate")) {
+        notifier.SetMaxRate(args["maxRate"].AsUInt());
+    }
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set InspectorRefresh debounce: %lld, maxRate: %u.", static_cast<long long>(notifier.GetDebounceTime()),
+        notifier.GetMaxRate());
+}
+
 ExitCommand::ExitCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
     : CommandLine(commandType, arg, socket)
 {
@@ -1358,34 +1474,27 @@ void FastPreviewMsgCommand::RunGet()
 }
 
 DropFrameCommand::DropFrameCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool DropFrameCommand::IsSetArgValid() const
+const ArgSchema<DropFrameCommand::SetArgs>& DropFrameCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("frequency") || !args["frequency"].IsInt()) {
-        ELOG("Invalid DropFrame of arguments!");
-        return false;
-    }
-    if (args["frequency"].AsInt() < 0) {
-        ELOG("DropFrame param frequency must greater than or equal to 0");
-        return false;
-    }
-    return true;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .Int("frequency", &SetArgs::frequency, 0);
+    return schema;
 }
 
 void DropFrameCommand::RunSet()
 {
     ILOG("Set DropFrame frequency start.");
-    if (args.IsNull() || !args.IsMember("frequency") || !args["frequency"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    int frequency = args["frequency"].AsInt();
-    VirtualScreenImpl::GetInstance().SetDropFrameFrequency(frequency);
+    VirtualScreenImpl::GetInstance().SetDropFrameFrequency(setArgs.frequency);
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set DropFrame frequency: %dms.", frequency);
+    ILOG("Set DropFrame frequency: %dms.", setArgs.frequency);
 }
 
 bool KeyPressCommand::IsActionArgValid() const
@@ -1465,6 +1574,7 @@ void KeyPressCommand::RunAction()
     bool isInputMethod = args["isInputMethod"].AsBool();
     if (isInputMethod) {
         VirtualScreen::inputMethodCountPerMinute++;
+        PerfStats::GetInstance().GetCounter(PerfMetric::INPUT_METHOD).Add();
         if (!args.IsMember("codePoint") || !args["codePoint"].IsInt()) {
             ELOG("Invalid parameter of arguments!");
             return;
@@ -1474,6 +1584,7 @@ void KeyPressCommand::RunAction()
         KeyInputImpl::GetInstance().DispatchOsInputMethodEvent();
     } else {
         VirtualScreen::inputKeyCountPerMinute++;
+        PerfStats::GetInstance().GetCounter(PerfMetric::INPUT_KEY).Add();
         if (!args.IsMember("keyCode") || !args["keyCode"].IsInt() ||
             !args.IsMember("keyAction") || !args["keyAction"].IsInt()||
             !args.IsMember("pressedCodes") || !args["pressedCodes"].IsArray()) {
@@ -1610,51 +1721,30 @@ void PointEventCommand::RunAction()
 }
 
 FoldStatusCommand::FoldStatusCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
-    : CommandLine(commandType, arg, socket)
+    : SchemaSetCommand(commandType, arg, socket)
 {
 }
 
-bool FoldStatusCommand::IsSetArgValid() const
+const ArgSchema<FoldStatusCommand::SetArgs>& FoldStatusCommand::GetSetSchema() const
 {
-    if (args.IsNull() || !args.IsMember("FoldStatus") || !args["FoldStatus"].IsString()) {
-        ELOG("Invalid FoldStatus of arguments!");
-        return false;
-    }
-    if (!args.IsMember("width") || !args["width"].IsInt() ||
-        !args.IsMember("height") || !args["height"].IsInt()) {
-        ELOG("Invalid width and height of arguments!");
-        return false;
-    }
-    if (args["width"].AsInt() < minWidth || args["width"].AsInt() > maxWidth ||
-        args["height"].AsInt() < minWidth || args["height"].AsInt() > maxWidth) {
-        ELOG("width or height is out of range %d-%d", minWidth, maxWidth);
-        return false;
-    }
-    if (args["FoldStatus"].AsString() == "fold" || args["FoldStatus"].AsString() == "unfold" ||
-        args["FoldStatus"].AsString() == "unknown" || args["FoldStatus"].AsString() == "half_fold") {
-        return true;
-    }
-    ELOG("FoldStatus param must be \"fold\" or \"unfold\" or \"unknown\" or \"half_fold\"");
-    return false;
+    static const ArgSchema<SetArgs> schema = ArgSchema<SetArgs>()
+        .String("FoldStatus", &SetArgs::foldStatus, { "fold", "unfold", "unknown", "half_fold" })
+        .Int("width", &SetArgs::width, minWidth, maxWidth)
+        .Int("height", &SetArgs::height, minWidth, maxWidth);
+    return schema;
 }
 
 void FoldStatusCommand::RunSet()
 {
-    if (args.IsNull() || !args.IsMember("FoldStatus") || !args["FoldStatus"].IsString() ||
-        !args.IsMember("width") || !args["width"].IsInt() ||
-        !args.IsMember("height") || !args["height"].IsInt()) {
-        ELOG("Invalid number of arguments!");
+    if (!ParseSetArgs()) {
+        ELOG("Invalid parameter of arguments!");
         return;
     }
-    std::string commandStatus = args["FoldStatus"].AsString();
-    int32_t width = args["width"].AsInt();
-    int32_t height = args["height"].AsInt();
-    std::string currentStatus = VirtualScreenImpl::GetInstance().GetFoldStatus();
-    if (commandStatus != currentStatus) {
-        JsAppImpl::GetInstance().FoldStatusChanged(commandStatus, width, height);
+    if (setArgs.foldStatus != VirtualScreenImpl::GetInstance().GetFoldStatus()) {
+        JsAppImpl::GetInstance().FoldStatusChanged(setArgs.foldStatus, setArgs.width, setArgs.height);
     }
     SetCommandResult("result", JsonReader::CreateBool(true));
-    ILOG("Set FoldStatus run finished, FoldStatus is: %s", args["FoldStatus"].AsString().c_str());
+    ILOG("Set FoldStatus run finished, FoldStatus is: %s", setArgs.foldStatus.c_str());
 }
 
 AvoidAreaCommand::AvoidAreaCommand(CommandType commandType, const Json2::Value& arg,
@@ -1662,7 +1752,7 @@ AvoidAreaCommand::AvoidAreaCommand(CommandType commandType, const Json2::Value&
 {
 }
 
-bool AvoidAreaCommand::IsSetArgValid() const
+bool AvoidAreaCommand::IsSetArgValid()
 {
     if (args.IsNull() || !args.IsMember("topRect") || !args.IsMember("bottomRect") ||
         !args.IsMember("leftRect") || !args.IsMember("rightRect")) {
@@ -1738,4 +1828,409 @@ void AvoidAreaChangedCommand::RunGet()
 {
     SetResultToManager("args", args, "AvoidAreaChanged");
     ILOG("Get AvoidAreaChangedCommand run finished.");
-}
\ No newline at end of file
+}
+
+ProtocolVersionCommand::ProtocolVersionCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool ProtocolVersionCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("version") || !args["version"].IsInt()) {
+        ELOG("Invalid ProtocolVersion of arguments!");
+        return false;
+    }
+    uint32_t version = args["version"].AsUInt();
+    if (version != MessageFrame::TEXT_PROTOCOL_VERSION && version != MessageFrame::FRAMED_PROTOCOL_VERSION) {
+        ELOG("Unsupported protocol version: %u", version);
+        return false;
+    }
+    return true;
+}
+
+void ProtocolVersionCommand::RunGet()
+{
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("version", CommandLineInterface::GetInstance().GetProtocolVersion());
+    SetCommandResult("result", result);
+    ILOG("Get ProtocolVersion run finished.");
+}
+
+void ProtocolVersionCommand::RunSet()
+{
+    uint32_t version = args["version"].AsUInt();
+    // The reply is still sent with the current protocol, the new one applies to the next message.
+    CommandLineInterface::GetInstance().SetProtocolVersion(version);
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set ProtocolVersion: %u.", version);
+}
+
+CompressionCommand::CompressionCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool CompressionCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("encoding") || !args["encoding"].IsString()) {
+        ELOG("Invalid Compression of arguments!");
+        return false;
+    }
+    std::string encoding = args["encoding"].AsString();
+    if (encoding != "deflate" && encoding != "none") {
+        ELOG("Unsupported compression encoding: %s", encoding.c_str());
+        return false;
+    }
+    if (args.IsMember("threshold") && (!args["threshold"].IsUInt() || args["threshold"].AsUInt() == 0)) {
+        ELOG("Invalid Compression threshold!");
+        return false;
+    }
+    return true;
+}
+
+void CompressionCommand::RunGet()
+{
+    size_t threshold = CommandLineInterface::GetInstance().GetCompressionThreshold();
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("encoding", (threshold == 0) ? "none" : "deflate");
+    result.Add("threshold", static_cast<int64_t>(threshold));
+    Json2::Value supported = JsonReader::CreateArray();
+    supported.Add("deflate");
+    result.Add("supported", supported);
+    SetCommandResult("result", result);
+    ILOG("Get Compression run finished.");
+}
+
+void CompressionCommand::RunSet()
+{
+    size_t threshold = 0;
+    if (args["encoding"].AsString() == "deflate") {
+        threshold = args.IsMember("threshold") ? args["threshold"].AsUInt() :
+            CommandLineInterface::DEFAULT_COMPRESSION_THRESHOLD;
+    }
+    CommandLineInterface::GetInstance().SetCompressionThreshold(threshold);
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set Compression threshold: %zu.", threshold);
+}
+
+LogLevelCommand::LogLevelCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool LogLevelCommand::IsSetArgValid()
+{
+    if (args.IsNull() || (!args.IsMember("level") && !args.IsMember("rateLimit"))) {
+        ELOG("Invalid LogLevel of arguments!");
+        return false;
+    }
+    int32_t level = PreviewerLog::LEVEL_INFO;
+    if (args.IsMember("level") && (!args["level"].IsString() ||
+        !PreviewerLog::ParseLevel(args["level"].AsString(), level))) {
+        ELOG("Invalid LogLevel level!");
+        return false;
+    }
+    if (args.IsMember("rateLimit") && (!args["rateLimit"].IsUInt() ||
+        args["rateLimit"].AsUInt() > PreviewerLog::MAX_RATE_LIMIT)) {
+        ELOG("Invalid LogLevel rateLimit!");
+        return false;
+    }
+    return true;
+}
+
+void LogLevelCommand::RunGet()
+{
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("level", PreviewerLog::GetLevelName(PreviewerLog::GetLevel()));
+    result.Add("rateLimit", static_cast<int64_t>(PreviewerLog::GetRateLimit()));
+    SetCommandResult("result", result);
+    ILOG("Get LogLevel run finished.");
+}
+
+void LogLevelCommand::RunSet()
+{
+    if (args.IsMember("level")) {
+        int32_t level = PreviewerLog::LEVEL_INFO;
+        PreviewerLog::ParseLevel(args["level"].AsString(), level);
+        PreviewerLog::SetLevel(level);
+    }
+    if (args.IsMember("rateLimit")) {
+        PreviewerLog::SetRateLimit(args["rateLimit"].AsUInt());
+    }
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set LogLevel level: %s, rateLimit: %u.", PreviewerLog::GetLevelName(PreviewerLog::GetLevel()),
+        PreviewerLog::GetRateLimit());
+}
+
+TraceEventCommand::TraceEventCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool TraceEventCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("enable") || !args["enable"].IsBool()) {
+        ELOG("Invalid TraceEvent of arguments!");
+        return false;
+    }
+    return true;
+}
+
+bool TraceEventCommand::IsActionArgValid() const
+{
+    if (args.IsNull() || !args.IsMember("path") || !args["path"].IsString() || args["path"].AsString().empty()) {
+        ELOG("Invalid TraceEvent of arguments!");
+        return false;
+    }
+    return true;
+}
+
+void TraceEventCommand::RunGet()
+{
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("enable", TraceEvent::IsEnabled());
+    result.Add("eventCount", static_cast<int64_t>(TraceEvent::GetInstance().GetEventCount()));
+    SetCommandResult("result", result);
+    ILOG("Get TraceEvent run finished.");
+}
+
+void TraceEventCommand::RunSet()
+{
+    TraceEvent::GetInstance().SetEnabled(args["enable"].AsBool());
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set TraceEvent enable: %d.", TraceEvent::IsEnabled());
+}
+
+void TraceEventCommand::RunAction()
+{
+    std::string path = args["path"].AsString();
+    int64_t eventCount = TraceEvent::GetInstance().Dump(path);
+    if (eventCount < 0) {
+        SetCommandResult("result", JsonReader::CreateBool(false));
+        return;
+    }
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("path", path.c_str());
+    result.Add("eventCount", eventCount);
+    SetCommandResult("result", result);
+    ILOG("Action TraceEvent run finished.");
+}
+
+PerfStatsCommand::PerfStatsCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool PerfStatsCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("subscribe") || !args["subscribe"].IsBool()) {
+        ELOG("Invalid PerfStats of arguments!");
+        return false;
+    }
+    if (args.IsMember("interval")) {
+        if (!args["interval"].IsInt() || args["interval"].AsInt() < PerfStatsPublisher::MIN_INTERVAL ||
+            args["interval"].AsInt() > PerfStatsPublisher::MAX_INTERVAL) {
+            ELOG("Invalid PerfStats interval, it must be in [%lld, %lld] ms.",
+                static_cast<long long>(PerfStatsPublisher::MIN_INTERVAL),
+                static_cast<long long>(PerfStatsPublisher::MAX_INTERVAL));
+            return false;
+        }
+    }
+    return true;
+}
+
+void PerfStatsCommand::RunGet()
+{
+    PerfStatsPublisher::SampleGauges();
+    PerfStats::Snapshot snapshot = PerfStats::GetInstance().TakeSnapshot();
+    Json2::Value result = JsonReader::CreateObject();
+    PerfStats::GetInstance().ToJson(snapshot, nullptr, result);
+    result.Add("subscribe", PerfStatsPublisher::GetInstance().IsSubscribed());
+    result.Add("interval", PerfStatsPublisher::GetInstance().GetInterval());
+    SetCommandResult("result", result);
+    ILOG("Get PerfStats run finished.");
+}
+
+void PerfStatsCommand::RunSet()
+{
+    PerfStatsPublisher& publisher = PerfStatsPublisher::GetInstance();
+    if (!args["subscribe"].AsBool()) {
+        publisher.Unsubscribe();
+        SetCommandResult("result", JsonReader::CreateBool(true));
+        ILOG("Set PerfStats unsubscribed.");
+        return;
+    }
+    int64_t interval = args.IsMember("interval") ? args["interval"].AsInt() : PerfStatsPublisher::DEFAULT_INTERVAL;
+    SetCommandResult("result", JsonReader::CreateBool(publisher.Subscribe(interval)));
+    ILOG("Set PerfStats subscribed, interval: %lld ms.", static_cast<long long>(interval));
+}
+
+PerfOverlayCommand::PerfOverlayCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool PerfOverlayCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("enable") || !args["enable"].IsBool()) {
+        ELOG("Invalid PerfOverlay of arguments!");
+        return false;
+    }
+    return true;
+}
+
+void PerfOverlayCommand::RunGet()
+{
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("enable", PerfOverlay::IsEnabled());
+    SetCommandResult("result", result);
+    ILOG("Get PerfOverlay run finished.");
+}
+
+void PerfOverlayCommand::RunSet()
+{
+    PerfOverlay::GetInstance().SetEnabled(args["enable"].AsBool());
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set PerfOverlay enable: %d.", PerfOverlay::IsEnabled());
+}
+
+MemoryStatsCommand::MemoryStatsCommand(CommandType commandType, const Json2::Value& arg,
+    const LocalSocket& socket) : CommandLine(commandType, arg, socket)
+{
+}
+
+bool MemoryStatsCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("resetPeak") || !args["resetPeak"].IsBool()) {
+        ELOG("Invalid MemoryStats of arguments!");
+        return false;
+    }
+    return true;
+}
+
+void MemoryStatsCommand::RunGet()
+{
+    Json2::Value result = JsonReader::CreateObject();
+    MemoryStats::GetInstance().ToJson(result);
+    SetCommandResult("result", result);
+    ILOG("Get MemoryStats run finished.");
+}
+
+void MemoryStatsCommand::RunSet()
+{
+    if (args["resetPeak"].AsBool()) {
+        MemoryStats::GetInstance().ResetPeak();
+    }
+    SetCommandResult("result", JsonReader::CreateBool(true));
+    ILOG("Set MemoryStats run finished.");
+}
+
+CancelCommand::CancelCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
+    : CommandLine(commandType, arg, socket)
+{
+}
+
+bool CancelCommand::IsSetArgValid()
+{
+    if (args.IsNull() || !args.IsMember("requestId") || !args["requestId"].IsString()) {
+        ELOG("Invalid Cancel of arguments!");
+        return false;
+    }
+    return true;
+}
+
+void CancelCommand::RunSet()
+{
+    std::string requestId = args["requestId"].AsString();
+    bool isCancelled = CommandLineInterface::GetInstance().CancelRequest(requestId);
+    SetCommandResult("result", JsonReader::CreateBool(isCancelled));
+    ILOG("Cancel %s run finished, cancelled: %d", requestId.c_str(), isCancelled);
+}
+
+BatchCommand::BatchCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
+    : CommandLine(commandType, arg, socket)
+{
+}
+
+std::unique_ptr<CommandLine> BatchCommand::CreateSubCommand(const Json2::Value& item) const
+{
+    if (!item.IsObject() || !item.IsMember("command") || !item["command"].IsString() ||
+        !item.IsMember("args") || !item["args"].IsObject()) {
+        return nullptr;
+    }
+    std::string command = item["command"].AsString();
+    if (std::find(batchCommands.begin(), batchCommands.end(), command) == batchCommands.end() ||
+        !CommandLineFactory::IsCommandSupported(command)) {
+        ELOG("Batch: %s can not be batched", command.c_str());
+        return nullptr;
+    }
+    // The sub command only views its arguments, they live in args as long as the batch runs.
+    std::unique_ptr<CommandLine> subCommand =
+        CommandLineFactory::CreateCommandLine(command, CommandType::SET, item["args"], cliSocket);
+    if (subCommand == nullptr || !subCommand->IsArgValid()) {
+        ELOG("Batch: invalid arguments of %s", command.c_str());
+        return nullptr;
+    }
+    return subCommand;
+}
+
+bool BatchCommand::IsSetArgValid()
+{
+    subCommands.clear();
+    if (args.IsNull() || !args.IsMember("commands") || !args["commands"].IsArray()) {
+        ELOG("Invalid Batch of arguments!");
+        return false;
+    }
+    Json2::Value commands = args["commands"];
+    uint32_t size = commands.GetArraySize();
+    if (size == 0 || size > MAX_BATCH_SIZE) {
+        ELOG("Batch: %u commands, 1 to %u are allowed", size, MAX_BATCH_SIZE);
+        return false;
+    }
+    std::set<std::string> names;
+    subCommands.reserve(size);
+    for (uint32_t i = 0; i < size; i++) {
+        Json2::Value item = commands.GetArrayItem(i);
+        subCommands.push_back(CreateSubCommand(item));
+        if (subCommands.back() == nullptr) {
+            subCommands.clear();
+            return false;
+        }
+        // A setting given twice leaves its final value to the order of the list, refused instead.
+        if (!names.insert(item["command"].AsString()).second) {
+            ELOG("Batch: %s is given twice", item["command"].AsString().c_str());
+            subCommands.clear();
+            return false;
+        }
+    }
+    isSetArgsParsed = true;
+    return true;
+}
+
+void BatchCommand::RunSet()
+{
+    if (!isSetArgsParsed && !IsSetArgValid()) {
+        SetCommandResult("result", JsonReader::CreateBool(false));
+        return;
+    }
+    Json2::Value commands = args["commands"];
+    uint32_t size = commands.GetArraySize();
+    Json2::Value results = JsonReader::CreateObject();
+    JsApp& app = JsAppImpl::GetInstance();
+    app.BeginSettingsBatch();
+    for (uint32_t i = 0; i < size; i++) {
+        subCommands[i]->RunSet();
+        std::string command = commands.GetArrayItem(i)["command"].AsString();
+        const Json2::Value& subResult = subCommands[i]->GetCommandResult();
+        if (!subResult.IsMember("result") || !results.Add(command.c_str(), subResult["result"])) {
+            results.Add(command.c_str(), false);
+        }
+    }
+    app.EndSettingsBatch();
+    // The sub commands view the arguments of this run.
+    subCommands.clear();
+    isSetArgsParsed = false;
+    SetCommandResult("result", results);
+    ILOG("Batch run finished, %u settings applied", size);
+}
@@ -16,8 +16,12 @@
 #ifndef COMMANDLINE_H
 #define COMMANDLINE_H
 
+#include <memory>
 #include <set>
 #include <vector>
+#include "ArgSchema.h"
+#include "AsyncCommandRunner.h"
+#include "InputCoalescer.h"
 #include "JsonReader.h"
 #include "LocalSocket.h"
 
@@ -34,37 +38,53 @@ public:
     void SendResultToManager();
     void SendResult();
     virtual void RunSet() {}
-    bool IsArgValid() const;
+    bool IsArgValid();
     uint8_t ToUint8(std::string str) const;
     void SetCommandName(std::string command);
+    // Binds an instance kept from an earlier run to the next run of the same command.
+    void Reset(CommandType commandType, const Json2::Value& arg);
+    // The "requestId" of the message, echoed in the result. Empty if the client sent none.
+    void SetClientRequestId(const std::string& requestId);
+    // The request id of the frame that carried the command, echoed by the reply frame. 0 in the text protocol.
+    void SetFrameRequestId(uint32_t requestId);
+    // The result of the last run, until it is sent.
+    const Json2::Value& GetCommandResult() const
+    {
+        return commandResult;
+    }
+    // Serializes result, deflating it when threshold is reached, 0 never deflates. Any thread.
+    static void EncodeResult(Json2::Value& result, const std::string& command, bool isFramed, size_t threshold,
+                             CommandReply& reply);
+    static void WriteReply(const LocalSocket& socket, const CommandReply& reply, uint32_t frameRequestId);
 
 protected:
-    const Json2::Value& args;
+    Json2::Value argsView; // does not own the arguments, they outlive the run
+    const Json2::Value& args = argsView;
     const LocalSocket& cliSocket;
     Json2::Value commandResult = JsonReader::CreateObject();
     Json2::Value commandResultToManager = JsonReader::CreateObject();
     CommandType type;
     std::string commandName;
-    const std::vector<std::string> liteSupportedLanguages = {"zh-CN", "en-US"};
-    const std::vector<std::string> richSupportedLanguages = {
-        "zh_CN", "zh_HK", "zh_TW", "en_US", "en_GB", "ar_AE", "bg_BG", "bo_CN", "cs_CZ", "da_DK",
-        "de_DE", "el_GR", "en_PH", "es_ES", "es_LA", "fi_FI", "fr_FR", "he_IL", "hi_IN", "hu_HU",
-        "id_ID", "it_IT", "ja_JP", "kk_KZ", "ms_MY", "nl_NL", "no_NO", "pl_PL", "pt_BR", "pt_PT",
-        "ro_RO", "ru_RU", "sr_RS", "sv_SE", "th_TH", "tr_TR", "ug_CN", "uk_UA", "vi_VN"
-    };
-    const std::vector<std::string> LoadDocDevs = {"phone", "tablet", "wearable", "car", "tv", "2in1", "default"};
-    const int maxWidth = 3000;
-    const int minWidth = 50;
-    const int maxDpi = 640;
-    const int minDpi = 120;
-    const int maxKeyVal = 2119;
-    const int minKeyVal = 2000;
-    const int maxActionVal = 2;
-    const int minActionVal = 0;
-    const int maxLoadDocWidth = 3000;
-    const int minLoadDocWidth = 20;
-
-    virtual bool IsSetArgValid() const
+    bool isResultCompressible = false; // the "result" string may be deflated, see SendResult
+    std::string clientRequestId;
+    uint32_t frameRequestId = 0;
+    bool isResultSubmitted = false; // SendResultAsync took the result
+    bool isSetArgsParsed = false; // IsSetArgValid kept what it parsed from the arguments of this run
+    static const std::vector<std::string> liteSupportedLanguages;
+    static const std::vector<std::string> richSupportedLanguages;
+    static const std::vector<std::string> LoadDocDevs;
+    static constexpr int maxWidth = 3000;
+    static constexpr int minWidth = 50;
+    static constexpr int maxDpi = 640;
+    static constexpr int minDpi = 120;
+    static constexpr int maxKeyVal = 2119;
+    static constexpr int minKeyVal = 2000;
+    static constexpr int maxActionVal = 2;
+    static constexpr int minActionVal = 0;
+    static constexpr int maxLoadDocWidth = 3000;
+    static constexpr int minLoadDocWidth = 20;
+
+    virtual bool IsSetArgValid()
     {
         return true;
     }
@@ -78,25 +98,54 @@ protected:
     }
     virtual void RunGet() {}
     virtual void RunAction() {}
+    // For a long result: when the client gave a request id, the result is encoded and sent from the
+    // async runner while the next command runs. Otherwise SendResult sends it as usual.
+    void SendResultAsync();
 
 private:
     void Run();
+
+    static constexpr size_t MAX_SHARED_REPLY_CAPACITY = 16 * 1024 * 1024; // larger replies do not keep the buffer
+    static CommandReply sharedReply; // reused by SendResult on the command thread, keeps its capacity
+};
+
+// A command whose SET arguments are declared by an ArgSchema. IsSetArgValid parses them into setArgs,
+// which RunSet reads instead of looking the keys up again.
+template <typename Args>
+class SchemaSetCommand : public CommandLine {
+public:
+    SchemaSetCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket)
+        : CommandLine(commandType, arg, socket)
+    {
+    }
+    ~SchemaSetCommand() override {}
+
+protected:
+    using SetArgs = Args;
+
+    bool IsSetArgValid() override
+    {
+        isSetArgsParsed = GetSetSchema().Parse(args, setArgs) && IsSetValueValid();
+        return isSetArgsParsed;
+    }
+    // The checks the schema can not express, on the parsed setArgs.
+    virtual bool IsSetValueValid() const
+    {
+        return true;
+    }
+    // For RunSet: parses the arguments unless IsSetArgValid already did in this run.
+    bool ParseSetArgs()
+    {
+        return isSetArgsParsed || IsSetArgValid();
+    }
+    virtual const ArgSchema<Args>& GetSetSchema() const = 0;
+
+    Args setArgs;
 };
 
 class TouchAndMouseCommand {
 protected:
-    struct EventParams {
-        double x;
-        double y;
-        int type;
-        int button;
-        int action;
-        int sourceType;
-        int sourceTool;
-        std::set<int> pressedBtnsVec;
-        std::vector<double> axisVec; // 13 is array size
-        std::string name;
-    };
+    using EventParams = InputEventParams;
     void SetEventParams(EventParams& params);
 };
 
@@ -158,7 +207,11 @@ protected:
     void RunAction() override;
 };
 
-class PowerCommand : public CommandLine {
+struct PowerSetArgs {
+    double power = 0;
+};
+
+class PowerCommand : public SchemaSetCommand<PowerSetArgs> {
 public:
     PowerCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~PowerCommand() override {}
@@ -166,7 +219,10 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetValueValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
 class VolumeCommand : public CommandLine {
@@ -177,10 +233,14 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetArgValid() override;
+};
+
+struct BarometerSetArgs {
+    uint32_t barometer = 0;
 };
 
-class BarometerCommand : public CommandLine {
+class BarometerCommand : public SchemaSetCommand<BarometerSetArgs> {
 public:
     BarometerCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~BarometerCommand() override {}
@@ -188,38 +248,57 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetValueValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
-class ResolutionSwitchCommand : public CommandLine {
+struct ResolutionSwitchSetArgs {
+    int32_t originWidth = 0;
+    int32_t originHeight = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t screenDensity = 0;
+    std::string reason = "undefined";
+};
+
+class ResolutionSwitchCommand : public SchemaSetCommand<ResolutionSwitchSetArgs> {
 public:
     ResolutionSwitchCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~ResolutionSwitchCommand() override {}
     void RunSet() override;
 
-protected:
-    bool IsSetArgValid() const override;
-    bool IsIntValValid() const;
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
+};
+
+struct OrientationSetArgs {
+    std::string orientation;
 };
 
-class OrientationCommand : public CommandLine {
+class OrientationCommand : public SchemaSetCommand<OrientationSetArgs> {
 public:
     OrientationCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~OrientationCommand() override {}
     void RunSet() override;
 
-protected:
-    bool IsSetArgValid() const override;
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
-class ColorModeCommand : public CommandLine {
+struct ColorModeSetArgs {
+    std::string colorMode;
+};
+
+class ColorModeCommand : public SchemaSetCommand<ColorModeSetArgs> {
 public:
     ColorModeCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~ColorModeCommand() override {}
     void RunSet() override;
 
-protected:
-    bool IsSetArgValid() const override;
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
 class LanguageCommand : public CommandLine {
@@ -230,17 +309,21 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetArgValid() override;
+};
+
+struct FontSelectSetArgs {
+    bool fontSelect = false;
 };
 
-class FontSelectCommand : public CommandLine {
+class FontSelectCommand : public SchemaSetCommand<FontSelectSetArgs> {
 public:
     FontSelectCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~FontSelectCommand() override {}
     void RunSet() override;
 
-protected:
-    bool IsSetArgValid() const override;
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
 class MemoryRefreshCommand : public CommandLine {
@@ -250,7 +333,7 @@ public:
     void RunSet() override;
 
 protected:
-    bool IsSetArgValid() const override;
+    bool IsSetArgValid() override;
 };
 
 class LoadDocumentCommand : public CommandLine {
@@ -260,7 +343,7 @@ public:
     void RunSet() override;
 
 protected:
-    bool IsSetArgValid() const override;
+    bool IsSetArgValid() override;
     bool IsIntValValid(const Json2::Value& previewParam) const;
     bool IsStrValVailid(const Json2::Value& previewParam) const;
 };
@@ -272,7 +355,7 @@ public:
     void RunSet() override;
 
 protected:
-    bool IsSetArgValid() const override;
+    bool IsSetArgValid() override;
 };
 
 class CurrentRouterCommand : public CommandLine {
@@ -310,7 +393,7 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetArgValid() override;
 };
 
 class DistributedCommunicationsCommand : public CommandLine {
@@ -324,7 +407,11 @@ protected:
     std::vector<char> StringToCharVector(std::string str) const;
 };
 
-class KeepScreenOnStateCommand : public CommandLine {
+struct KeepScreenOnStateSetArgs {
+    bool keepScreenOnState = false;
+};
+
+class KeepScreenOnStateCommand : public SchemaSetCommand<KeepScreenOnStateSetArgs> {
 public:
     KeepScreenOnStateCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~KeepScreenOnStateCommand() override {}
@@ -332,10 +419,16 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
-class WearingStateCommand : public CommandLine {
+struct WearingStateSetArgs {
+    bool wearingState = false;
+};
+
+class WearingStateCommand : public SchemaSetCommand<WearingStateSetArgs> {
 public:
     WearingStateCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~WearingStateCommand() override {}
@@ -343,10 +436,16 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
+};
+
+struct BrightnessModeSetArgs {
+    int32_t brightnessMode = 0;
 };
 
-class BrightnessModeCommand : public CommandLine {
+class BrightnessModeCommand : public SchemaSetCommand<BrightnessModeSetArgs> {
 public:
     BrightnessModeCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~BrightnessModeCommand() override {}
@@ -354,10 +453,17 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetValueValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
-class ChargeModeCommand : public CommandLine {
+struct ChargeModeSetArgs {
+    int32_t chargeMode = 0;
+};
+
+class ChargeModeCommand : public SchemaSetCommand<ChargeModeSetArgs> {
 public:
     ChargeModeCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~ChargeModeCommand() override {}
@@ -365,10 +471,17 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetValueValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
+};
+
+struct BrightnessSetArgs {
+    int32_t brightness = 0;
 };
 
-class BrightnessCommand : public CommandLine {
+class BrightnessCommand : public SchemaSetCommand<BrightnessSetArgs> {
 public:
     BrightnessCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~BrightnessCommand() override {}
@@ -376,10 +489,17 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetValueValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
+};
+
+struct HeartRateSetArgs {
+    int32_t heartRate = 0;
 };
 
-class HeartRateCommand : public CommandLine {
+class HeartRateCommand : public SchemaSetCommand<HeartRateSetArgs> {
 public:
     HeartRateCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~HeartRateCommand() override {}
@@ -387,10 +507,17 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetValueValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
-class StepCountCommand : public CommandLine {
+struct StepCountSetArgs {
+    uint32_t stepCount = 0;
+};
+
+class StepCountCommand : public SchemaSetCommand<StepCountSetArgs> {
 public:
     StepCountCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~StepCountCommand() override {}
@@ -398,7 +525,10 @@ public:
 
 protected:
     void RunGet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetValueValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
 class ExitCommand : public CommandLine {
@@ -428,6 +558,29 @@ protected:
     void RunAction() override;
 };
 
+class InspectorIncrementalCommand : public CommandLine {
+public:
+    InspectorIncrementalCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~InspectorIncrementalCommand() override {}
+
+protected:
+    void RunSet() override;
+    void RunAction() override;
+    bool IsSetArgValid() override;
+    bool IsActionArgValid() const override;
+};
+
+class InspectorRefreshCommand : public CommandLine {
+public:
+    InspectorRefreshCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~InspectorRefreshCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
 class DeviceTypeCommand : public CommandLine {
 public:
     DeviceTypeCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
@@ -455,14 +608,18 @@ protected:
     void RunGet() override;
 };
 
-class DropFrameCommand : public CommandLine {
+struct DropFrameSetArgs {
+    int32_t frequency = 0;
+};
+
+class DropFrameCommand : public SchemaSetCommand<DropFrameSetArgs> {
 public:
     DropFrameCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~DropFrameCommand() override {}
     void RunSet() override;
 
-protected:
-    bool IsSetArgValid() const override;
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
 class KeyPressCommand : public CommandLine {
@@ -489,14 +646,22 @@ protected:
     bool IsArgsValid() const;
 };
 
-class FoldStatusCommand : public CommandLine {
+struct FoldStatusSetArgs {
+    std::string foldStatus;
+    int32_t width = 0;
+    int32_t height = 0;
+};
+
+class FoldStatusCommand : public SchemaSetCommand<FoldStatusSetArgs> {
 public:
     FoldStatusCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
     ~FoldStatusCommand() override {}
 
 protected:
     void RunSet() override;
-    bool IsSetArgValid() const override;
+
+private:
+    const ArgSchema<SetArgs>& GetSetSchema() const override;
 };
 
 class AvoidAreaCommand : public CommandLine {
@@ -506,7 +671,7 @@ public:
 
 protected:
     void RunSet() override;
-    bool IsSetArgValid() const override;
+    bool IsSetArgValid() override;
     bool IsObjectValid(const Json2::Value& val) const;
 };
 
@@ -518,4 +683,111 @@ public:
 protected:
     void RunGet() override;
 };
+
+class ProtocolVersionCommand : public CommandLine {
+public:
+    ProtocolVersionCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~ProtocolVersionCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
+class CompressionCommand : public CommandLine {
+public:
+    CompressionCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~CompressionCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
+class LogLevelCommand : public CommandLine {
+public:
+    LogLevelCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~LogLevelCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
+class TraceEventCommand : public CommandLine {
+public:
+    TraceEventCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~TraceEventCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    void RunAction() override;
+    bool IsSetArgValid() override;
+    bool IsActionArgValid() const override;
+};
+
+class PerfStatsCommand : public CommandLine {
+public:
+    PerfStatsCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~PerfStatsCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
+class PerfOverlayCommand : public CommandLine {
+public:
+    PerfOverlayCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~PerfOverlayCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
+class MemoryStatsCommand : public CommandLine {
+public:
+    MemoryStatsCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~MemoryStatsCommand() override {}
+
+protected:
+    void RunGet() override;
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
+class CancelCommand : public CommandLine {
+public:
+    CancelCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~CancelCommand() override {}
+
+protected:
+    void RunSet() override;
+    bool IsSetArgValid() override;
+};
+
+// Sets several settings at once: all of them are checked before any is applied, and the engine
+// relayouts once for the whole batch.
+class BatchCommand : public CommandLine {
+public:
+    BatchCommand(CommandType commandType, const Json2::Value& arg, const LocalSocket& socket);
+    ~BatchCommand() override {}
+    static constexpr uint32_t MAX_BATCH_SIZE = 32;
+
+protected:
+    void RunSet() override;
+    bool IsSetArgValid() override;
+
+private:
+    std::unique_ptr<CommandLine> CreateSubCommand(const Json2::Value& item) const;
+    static const std::vector<std::string> batchCommands; // the settings a batch may hold
+    std::vector<std::unique_ptr<CommandLine>> subCommands; // checked by IsSetArgValid, run by RunSet
+};
 #endif // COMMANDLINE_H
@@ -21,7 +21,7 @@
 #include "PreviewerEngineLog.h"
 #include "TraceTool.h"
 
-CommandLineFactory::CommandTypeMap CommandLineFactory::typeMap = CommandLineFactory::CommandTypeMap();
+CommandLineFactory::CommandEntry CommandLineFactory::commands[CommandTable::COUNT];
 CommandLineFactory::CommandLineFactory() {}
 
 void CommandLineFactory::InitCommandMap()
@@ -30,68 +30,71 @@ void CommandLineFactory::InitCommandMap()
     std::string deviceType = cmdParser.GetDeviceType();
     bool isLiteDevice = JsApp::IsLiteDevice(deviceType);
     if (!isLiteDevice) {
-        typeMap["BackClicked"] = &CommandLineFactory::CreateObject<BackClickedCommand>;
-        typeMap["inspector"] = &CommandLineFactory::CreateObject<InspectorJSONTree>;
-        typeMap["inspectorDefault"] = &CommandLineFactory::CreateObject<InspectorDefault>;
-        typeMap["ColorMode"] = &CommandLineFactory::CreateObject<ColorModeCommand>;
-        typeMap["Orientation"] = &CommandLineFactory::CreateObject<OrientationCommand>;
-        typeMap["ResolutionSwitch"] = &CommandLineFactory::CreateObject<ResolutionSwitchCommand>;
-        typeMap["CurrentRouter"] = &CommandLineFactory::CreateObject<CurrentRouterCommand>;
-        typeMap["ReloadRuntimePage"] = &CommandLineFactory::CreateObject<ReloadRuntimePageCommand>;
-        typeMap["FontSelect"] = &CommandLineFactory::CreateObject<FontSelectCommand>;
-        typeMap["MemoryRefresh"] = &CommandLineFactory::CreateObject<MemoryRefreshCommand>;
-        typeMap["LoadDocument"] = &CommandLineFactory::CreateObject<LoadDocumentCommand>;
-        typeMap["FastPreviewMsg"] = &CommandLineFactory::CreateObject<FastPreviewMsgCommand>;
-        typeMap["DropFrame"] = &CommandLineFactory::CreateObject<DropFrameCommand>;
-        typeMap["KeyPress"] = &CommandLineFactory::CreateObject<KeyPressCommand>;
-        typeMap["LoadContent"] = &CommandLineFactory::CreateObject<LoadContentCommand>;
-        typeMap["FoldStatus"] = &CommandLineFactory::CreateObject<FoldStatusCommand>;
-        typeMap["AvoidArea"] = &CommandLineFactory::CreateObject<AvoidAreaCommand>;
-        typeMap["AvoidAreaChanged"] = &CommandLineFactory::CreateObject<AvoidAreaChangedCommand>;
+        Register<BackClickedCommand, CommandTable::Find("BackClicked")>();
+        Register<InspectorJSONTree, CommandTable::Find("inspector")>();
+        Register<InspectorDefault, CommandTable::Find("inspectorDefault")>();
+        Register<InspectorIncrementalCommand, CommandTable::Find("inspectorIncremental")>();
+        Register<InspectorRefreshCommand, CommandTable::Find("inspectorRefresh")>();
+        Register<ColorModeCommand, CommandTable::Find("ColorMode")>();
+        Register<OrientationCommand, CommandTable::Find("Orientation")>();
+        Register<ResolutionSwitchCommand, CommandTable::Find("ResolutionSwitch")>();
+        Register<CurrentRouterCommand, CommandTable::Find("CurrentRouter")>();
+        Register<ReloadRuntimePageCommand, CommandTable::Find("ReloadRuntimePage")>();
+        Register<FontSelectCommand, CommandTable::Find("FontSelect")>();
+        Register<MemoryRefreshCommand, CommandTable::Find("MemoryRefresh")>();
+        Register<LoadDocumentCommand, CommandTable::Find("LoadDocument")>();
+        Register<FastPreviewMsgCommand, CommandTable::Find("FastPreviewMsg")>();
+        Register<DropFrameCommand, CommandTable::Find("DropFrame")>();
+        Register<KeyPressCommand, CommandTable::Find("KeyPress")>();
+        Register<LoadContentCommand, CommandTable::Find("LoadContent")>();
+        Register<FoldStatusCommand, CommandTable::Find("FoldStatus")>();
+        Register<AvoidAreaCommand, CommandTable::Find("AvoidArea")>();
+        Register<AvoidAreaChangedCommand, CommandTable::Find("AvoidAreaChanged")>();
     } else {
-        typeMap["Power"] = &CommandLineFactory::CreateObject<PowerCommand>;
-        typeMap["Volume"] = &CommandLineFactory::CreateObject<VolumeCommand>;
-        typeMap["Barometer"] = &CommandLineFactory::CreateObject<BarometerCommand>;
-        typeMap["Location"] = &CommandLineFactory::CreateObject<LocationCommand>;
-        typeMap["KeepScreenOnState"] = &CommandLineFactory::CreateObject<KeepScreenOnStateCommand>;
-        typeMap["WearingState"] = &CommandLineFactory::CreateObject<WearingStateCommand>;
-        typeMap["BrightnessMode"] = &CommandLineFactory::CreateObject<BrightnessModeCommand>;
-        typeMap["ChargeMode"] = &CommandLineFactory::CreateObject<ChargeModeCommand>;
-        typeMap["Brightness"] = &CommandLineFactory::CreateObject<BrightnessCommand>;
-        typeMap["HeartRate"] = &CommandLineFactory::CreateObject<HeartRateCommand>;
-        typeMap["StepCount"] = &CommandLineFactory::CreateObject<StepCountCommand>;
-        typeMap["DistributedCommunications"] = &CommandLineFactory::CreateObject<DistributedCommunicationsCommand>;
-        typeMap["CrownRotate"] = &CommandLineFactory::CreateObject<MouseWheelCommand>;
+        Register<PowerCommand, CommandTable::Find("Power")>();
+        Register<VolumeCommand, CommandTable::Find("Volume")>();
+        Register<BarometerCommand, CommandTable::Find("Barometer")>();
+        Register<LocationCommand, CommandTable::Find("Location")>();
+        Register<KeepScreenOnStateCommand, CommandTable::Find("KeepScreenOnState")>();
+        Register<WearingStateCommand, CommandTable::Find("WearingState")>();
+        Register<BrightnessModeCommand, CommandTable::Find("BrightnessMode")>();
+        Register<ChargeModeCommand, CommandTable::Find("ChargeMode")>();
+        Register<BrightnessCommand, CommandTable::Find("Brightness")>();
+        Register<HeartRateCommand, CommandTable::Find("HeartRate")>();
+        Register<StepCountCommand, CommandTable::Find("StepCount")>();
+        Register<DistributedCommunicationsCommand, CommandTable::Find("DistributedCommunications")>();
+        Register<MouseWheelCommand, CommandTable::Find("CrownRotate")>();
     }
-    typeMap["MousePress"] = &CommandLineFactory::CreateObject<TouchPressCommand>;
-    typeMap["MouseRelease"] = &CommandLineFactory::CreateObject<TouchReleaseCommand>;
-    typeMap["MouseMove"] = &CommandLineFactory::CreateObject<TouchMoveCommand>;
-    typeMap["Language"] = &CommandLineFactory::CreateObject<LanguageCommand>;
-    typeMap["SupportedLanguages"] = &CommandLineFactory::CreateObject<SupportedLanguagesCommand>;
-    typeMap["exit"] = &CommandLineFactory::CreateObject<ExitCommand>;
-    typeMap["Resolution"] = &CommandLineFactory::CreateObject<ResolutionCommand>;
-    typeMap["DeviceType"] = &CommandLineFactory::CreateObject<DeviceTypeCommand>;
-    typeMap["PointEvent"] = &CommandLineFactory::CreateObject<PointEventCommand>;
+    Register<TouchPressCommand, CommandTable::Find("MousePress")>();
+    Register<TouchReleaseCommand, CommandTable::Find("MouseRelease")>();
+    Register<TouchMoveCommand, CommandTable::Find("MouseMove")>();
+    Register<LanguageCommand, CommandTable::Find("Language")>();
+    Register<SupportedLanguagesCommand, CommandTable::Find("SupportedLanguages")>();
+    Register<ExitCommand, CommandTable::Find("exit")>();
+    Register<ResolutionCommand, CommandTable::Find("Resolution")>();
+    Register<DeviceTypeCommand, CommandTable::Find("DeviceType")>();
+    Register<PointEventCommand, CommandTable::Find("PointEvent")>();
+    Register<ProtocolVersionCommand, CommandTable::Find("ProtocolVersion")>();
+    Register<CompressionCommand, CommandTable::Find("Compression")>();
+    Register<LogLevelCommand, CommandTable::Find("LogLevel")>();
+    Register<TraceEventCommand, CommandTable::Find("TraceEvent")>();
+    Register<PerfStatsCommand, CommandTable::Find("PerfStats")>();
+    Register<PerfOverlayCommand, CommandTable::Find("PerfOverlay")>();
+    Register<MemoryStatsCommand, CommandTable::Find("MemoryStats")>();
+    Register<CancelCommand, CommandTable::Find("Cancel")>();
+    Register<BatchCommand, CommandTable::Find("Batch")>();
 }
 
 std::unique_ptr<CommandLine> CommandLineFactory::CreateCommandLine(std::string command,
     CommandLine::CommandType type, const Json2::Value& val, const LocalSocket& socket)
 {
-    if (typeMap.find(command) == typeMap.end()) {
-        Json2::Value commandResult = JsonReader::CreateObject();
-        commandResult.Add("version", CommandLineInterface::COMMAND_VERSION.c_str());
-        commandResult.Add("command", command.c_str());
-        commandResult.Add("result", "Unsupported command");
-        socket << commandResult.ToStyledString();
-        ELOG("Unsupported command");
-        TraceTool::GetInstance().HandleTrace("Mismatched SDK version");
+    size_t index = CommandTable::Find(command);
+    if (index == CommandTable::NOT_FOUND || commands[index].creator == nullptr) {
+        SendUnsupported(command, socket);
         return nullptr;
     }
-    if (typeMap[command] == nullptr) {
-        ELOG("CommandLineFactory::CreateCommandLine:typeMap is null");
-    }
     ILOG("Create Command: %s", command.c_str());
-    std::unique_ptr<CommandLine> cmdLine = typeMap[command](type, val, socket);
+    std::unique_ptr<CommandLine> cmdLine = commands[index].creator(type, val, socket);
     if (cmdLine == nullptr) {
         ELOG("CommandLineFactory::CreateCommandLine:cmdLine is null");
         return nullptr;
@@ -100,6 +103,91 @@ std::unique_ptr<CommandLine> CommandLineFactory::CreateCommandLine(std::string c
     return cmdLine;
 }
 
+bool CommandLineFactory::RunCommandLine(const std::string& command, CommandLine::CommandType type,
+    const Json2::Value& args, const LocalSocket& socket, const std::string& clientRequestId, uint32_t frameRequestId)
+{
+    size_t index = CommandTable::Find(command);
+    if (index == CommandTable::NOT_FOUND || commands[index].creator == nullptr) {
+        SendUnsupported(command, socket, clientRequestId, frameRequestId);
+        return false;
+    }
+    CommandEntry& entry = commands[index];
+    if (entry.isRunning) {
+        std::unique_ptr<CommandLine> commandLine = CreateCommandLine(command, type, args, socket);
+        if (commandLine != nullptr) {
+            commandLine->SetClientRequestId(clientRequestId);
+            commandLine->SetFrameRequestId(frameRequestId);
+            commandLine->CheckAndRun();
+        }
+        return commandLine != nullptr;
+    }
+    if (entry.instance == nullptr || entry.instanceSocket != &socket) {
+        entry.instance = CreateCommandLine(command, type, args, socket);
+        entry.instanceSocket = &socket;
+        if (entry.instance == nullptr) {
+            return false;
+        }
+    } else {
+        entry.instance->Reset(type, args);
+    }
+    entry.instance->SetClientRequestId(clientRequestId);
+    entry.instance->SetFrameRequestId(frameRequestId);
+    entry.isRunning = true;
+    entry.instance->CheckAndRun();
+    entry.isRunning = false;
+    return true;
+}
+
+bool CommandLineFactory::IsCommandSupported(const std::string& command)
+{
+    size_t index = CommandTable::Find(command);
+    return index != CommandTable::NOT_FOUND && commands[index].creator != nullptr;
+}
+
+size_t CommandLineFactory::GetCommandCount()
+{
+    size_t count = 0;
+    for (const CommandEntry& entry : commands) {
+        count += entry.creator != nullptr ? 1 : 0;
+    }
+    return count;
+}
+
+PerfHistogram& CommandLineFactory::GetCommandLatency(const std::string& command)
+{
+    size_t index = CommandTable::Find(command);
+    if (index == CommandTable::NOT_FOUND || commands[index].latency == nullptr) {
+        return PerfStats::GetInstance().GetCommandLatency(command);
+    }
+    return *commands[index].latency;
+}
+
+void CommandLineFactory::SendUnsupported(const std::string& command, const LocalSocket& socket,
+    const std::string& clientRequestId, uint32_t frameRequestId)
+{
+    Json2::Value commandResult = JsonReader::CreateObject();
+    commandResult.Add("version", CommandLineInterface::COMMAND_VERSION.c_str());
+    commandResult.Add("command", command.c_str());
+    if (!clientRequestId.empty()) {
+        commandResult.Add("requestId", clientRequestId.c_str());
+    }
+    commandResult.Add("result", "Unsupported command");
+    socket.WriteMessage(commandResult.ToString(), frameRequestId);
+    ELOG("Unsupported command");
+    TraceTool::GetInstance().HandleTrace("Mismatched SDK version");
+}
+
+template <typename T, size_t index>
+void CommandLineFactory::Register()
+{
+    static_assert(index < CommandTable::COUNT, "the command is missing from CommandTable::NAMES");
+    CommandEntry& entry = commands[index];
+    entry.creator = &CommandLineFactory::CreateObject<T>;
+    entry.instance.reset();
+    entry.instanceSocket = nullptr;
+    entry.latency = &PerfStats::GetInstance().GetCommandLatency(std::string(CommandTable::NAMES[index]));
+}
+
 template <typename T>
 std::unique_ptr<CommandLine> CommandLineFactory::CreateObject(CommandLine::CommandType type,
     const Json2::Value& args, const LocalSocket& socket)
@@ -17,8 +17,9 @@
 #define COMMANDLINEFACTORY_H
 
 #include <memory>
-#include <map>
 #include "CommandLine.h"
+#include "CommandTable.h"
+#include "PerfStats.h"
 
 class CommandLineFactory {
 public:
@@ -29,15 +30,37 @@ public:
                                                           CommandLine::CommandType type,
                                                           const Json2::Value& args,
                                                           const LocalSocket& socket);
+    // Runs the command on an instance kept from its last run, so that a command costs no allocation
+    // of its own. Returns false, after answering "Unsupported command", for an unknown command.
+    static bool RunCommandLine(const std::string& command, CommandLine::CommandType type,
+                               const Json2::Value& args, const LocalSocket& socket,
+                               const std::string& clientRequestId = "", uint32_t frameRequestId = 0);
+    // Whether the command is available on this device. Unlike CreateCommandLine, answers nothing.
+    static bool IsCommandSupported(const std::string& command);
+    // Number of commands available on this device.
+    static size_t GetCommandCount();
+    // Latency histogram of a command RunCommandLine accepted, without building its metric name.
+    static PerfHistogram& GetCommandLatency(const std::string& command);
 
 private:
+    using CommandCreator =
+        std::unique_ptr<CommandLine> (*)(CommandLine::CommandType, const Json2::Value&, const LocalSocket& socket);
+    struct CommandEntry {
+        CommandCreator creator = nullptr;
+        std::unique_ptr<CommandLine> instance;
+        const LocalSocket* instanceSocket = nullptr;
+        bool isRunning = false; // a command run from within its own run gets an instance of its own
+        PerfHistogram* latency = nullptr;
+    };
+
     template <typename T>
     static std::unique_ptr<CommandLine>
         CreateObject(CommandLine::CommandType, const Json2::Value&, const LocalSocket& socket);
-    using CommandTypeMap = std::map<
-        std::string,
-        std::unique_ptr<CommandLine> (*)(CommandLine::CommandType, const Json2::Value&, const LocalSocket& socket)>;
-    static CommandTypeMap typeMap;
+    template <typename T, size_t index>
+    static void Register();
+    static void SendUnsupported(const std::string& command, const LocalSocket& socket,
+                                const std::string& clientRequestId = "", uint32_t frameRequestId = 0);
+    static CommandEntry commands[CommandTable::COUNT];
 };
 
 #endif // COMMANDLINEFACTORY_H
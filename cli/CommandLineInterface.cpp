@@ -16,20 +16,35 @@
 
 #include "CommandLineInterface.h"
 
+#include <algorithm>
 #include <chrono>
-#include <regex>
 
+#include "AsyncCommandRunner.h"
 #include "CommandLine.h"
 #include "CommandLineFactory.h"
+#include "CommandRecorder.h"
+#include "CommandReplayer.h"
+#include "CommandScheduler.h"
+#include "InputEventFrame.h"
+#include "Interrupter.h"
+#include "JsonArena.h"
 #include "ModelManager.h"
+#include "PerfStats.h"
 #include "PreviewerEngineLog.h"
+#include "TraceEvent.h"
 #include "VirtualScreen.h"
 #include "CommandParser.h"
 
 const std::string CommandLineInterface::COMMAND_VERSION = "1.0.1";
 bool CommandLineInterface::isFirstWsSend = true;
 bool CommandLineInterface::isPipeConnected = false;
-CommandLineInterface::CommandLineInterface() : socket(nullptr) {}
+uint32_t CommandLineInterface::pendingProtocolVersion = 0;
+size_t CommandLineInterface::compressionThreshold = 0;
+bool CommandLineInterface::isReadPaused = false;
+CommandLineInterface::CommandLineInterface()
+    : socket(nullptr), reactor(std::make_unique<Reactor>()), frameReader(std::make_unique<MessageFrameReader>())
+{
+}
 
 CommandLineInterface::~CommandLineInterface() {}
 
@@ -50,6 +65,9 @@ void CommandLineInterface::InitPipe(const std::string name)
         FLOG("CommandLineInterface command pipe connect failed");
     }
     isPipeConnected  = true;
+    if (!reactor->WatchReadable(*socket)) {
+        ELOG("CommandLineInterface::InitPipe watch command pipe failed");
+    }
 }
 
 CommandLineInterface& CommandLineInterface::GetInstance()
@@ -60,7 +78,11 @@ CommandLineInterface& CommandLineInterface::GetInstance()
 
 void CommandLineInterface::SendJsonData(const Json2::Value& value)
 {
-    *(GetInstance().socket) << value.ToStyledString();
+    if (GetInstance().socket == nullptr) {
+        ELOG("CommandLineInterface::SendJsonData socket is null");
+        return;
+    }
+    GetInstance().socket->WriteMessage(value.ToString());
 }
 
 void CommandLineInterface::SendJSHeapMemory(size_t total, size_t alloc, size_t peak) const
@@ -77,7 +99,7 @@ void CommandLineInterface::SendJSHeapMemory(size_t total, size_t alloc, size_t p
         ELOG("CommandLineInterface::SendJSHeapMemory socket is null");
         return;
     }
-    *socket << result.ToStyledString();
+    socket->WriteMessage(result.ToString());
 }
 
 void CommandLineInterface::SendWebsocketStartupSignal() const
@@ -87,12 +109,11 @@ void CommandLineInterface::SendWebsocketStartupSignal() const
     result.Add("MessageType", "imageWebsocket");
     args.Add("port", VirtualScreen::webSocketPort.c_str());
     result.Add("args", args);
-    *socket << result.ToStyledString();
+    socket->WriteMessage(result.ToString());
 }
 
 void CommandLineInterface::ProcessCommand() const
 {
-    std::string message; /* NOLINT */
     if (socket == nullptr) {
         ELOG("CommandLineInterface::ProcessCommand socket is null");
         return;
@@ -101,18 +122,251 @@ void CommandLineInterface::ProcessCommand() const
         isFirstWsSend = false;
         SendWebsocketStartupSignal();
     }
-    *socket >> message;
-    if (message.empty()) {
+    SendAsyncReplies();
+    // Everything that arrived is queued before the next command runs, so input read now goes ahead
+    // of bulk work queued earlier. One command runs per call, timers get their turn in between.
+    if (CommandReplayer::GetInstance().IsReplaying()) {
+        ReplayCommands();
+    } else {
+        ReadCommands();
+    }
+    ScheduledCommand command;
+    if (!CommandScheduler::GetInstance().Pop(command)) {
+        return;
+    }
+    RunCommand(command);
+    ApplyProtocolVersion();
+    if (command.name == PROTOCOL_VERSION_COMMAND) {
+        isReadPaused = false;
+    }
+}
+
+void CommandLineInterface::ReadCommands() const
+{
+    for (uint32_t count = 0; count < MAX_READ_COMMANDS && !isReadPaused; count++) {
+        if (socket->IsMessageFramed()) {
+            if (!ReadCommandFrame()) {
+                return;
+            }
+            continue;
+        }
+        std::string message; /* NOLINT */
+        *socket >> message;
+        if (message.empty()) {
+            return;
+        }
+        QueueCommandMessage(message, 0);
+    }
+}
+
+bool CommandLineInterface::ReadCommandFrame() const
+{
+    if (frameReader->Read(*socket) != MessageFrameReader::Status::READY) {
+        return false;
+    }
+    const MessageFrameHeader& header = frameReader->GetHeader();
+    if (header.type == MessageFrame::TYPE_JSON) {
+        QueueCommandMessage(frameReader->GetPayload(), header.requestId);
+    } else if (header.type == MessageFrame::TYPE_INPUT_EVENT) {
+        CommandRecorder::GetInstance().RecordInputEvent(header.requestId, frameReader->GetPayload());
+        // Binary input events are never queued behind anything.
+        ProcessInputEventFrame(header.requestId, frameReader->GetPayload());
+    } else {
+        ELOG("CommandLineInterface::ReadCommandFrame unsupported frame type: %u", header.type);
+    }
+    frameReader->Reset();
+    return true;
+}
+
+void CommandLineInterface::ReplayCommands() const
+{
+    CommandReplayer& replayer = CommandReplayer::GetInstance();
+    CommandScheduler& scheduler = CommandScheduler::GetInstance();
+    CommandRecord record;
+    for (uint32_t count = 0; count < MAX_READ_COMMANDS && !isReadPaused; count++) {
+        if (!replayer.Next(record, scheduler.IsEmpty())) {
+            break;
+        }
+        if (record.isInputEvent) {
+            ProcessInputEventFrame(record.requestId, record.data);
+        } else {
+            QueueCommandMessage(record.data, record.requestId);
+        }
+    }
+    if (replayer.IsDrained() && scheduler.IsEmpty() && AsyncCommandRunner::GetInstance().GetPendingCount() == 0) {
+        replayer.Finish(replayReportPath);
+        Interrupter::Interrupt();
+    }
+}
+
+void CommandLineInterface::QueueCommandMessage(const std::string& message, uint32_t requestId) const
+{
+    CommandRecorder::GetInstance().RecordMessage(message, requestId);
+    ScheduledCommand command;
+    if (!ParseCommandMessage(message, command)) {
+        return;
+    }
+    command.requestId = requestId;
+    // The reply to a protocol switch decides how the following messages are read.
+    if (command.name == PROTOCOL_VERSION_COMMAND) {
+        isReadPaused = true;
+    }
+    std::vector<ScheduledCommand> cancelled;
+    CommandScheduler::GetInstance().Push(std::move(command), cancelled);
+    for (const ScheduledCommand& item : cancelled) {
+        SendCancelled(item.name, item.clientRequestId, item.requestId);
+    }
+}
+
+bool CommandLineInterface::CancelRequest(const std::string& clientRequestId) const
+{
+    if (clientRequestId.empty()) {
+        return false;
+    }
+    ScheduledCommand queued;
+    if (CommandScheduler::GetInstance().Cancel(clientRequestId, queued)) {
+        SendCancelled(queued.name, clientRequestId, queued.requestId);
+        return true;
+    }
+    AsyncCommandRunner::Completion unfinished;
+    if (AsyncCommandRunner::GetInstance().Cancel(clientRequestId, unfinished)) {
+        SendCancelled(unfinished.command, clientRequestId, unfinished.frameRequestId);
+        return true;
+    }
+    return false;
+}
+
+void CommandLineInterface::SendCancelled(const std::string& command, const std::string& clientRequestId,
+                                         uint32_t frameRequestId) const
+{
+    if (socket == nullptr) {
+        return;
+    }
+    Json2::Value result = JsonReader::CreateObject();
+    result.Add("version", COMMAND_VERSION.c_str());
+    result.Add("command", command.c_str());
+    if (!clientRequestId.empty()) {
+        result.Add("requestId", clientRequestId.c_str());
+    }
+    result.Add("result", "Cancelled");
+    socket->WriteMessage(result.ToString(), frameRequestId);
+    ILOG("Command %s cancelled", command.c_str());
+}
+
+void CommandLineInterface::SendAsyncReplies() const
+{
+    std::vector<AsyncCommandRunner::Completion> completed;
+    AsyncCommandRunner::GetInstance().TakeCompleted(completed);
+    for (const AsyncCommandRunner::Completion& completion : completed) {
+        CommandLine::WriteReply(*socket, completion.reply, completion.frameRequestId);
+        ILOG("Async reply of %s %s sent", completion.command.c_str(), completion.requestId.c_str());
+    }
+}
+
+void CommandLineInterface::ProcessInputEventFrame(uint32_t requestId, const std::string& payload) const
+{
+    TRACE_EVENT_SCOPE("DispatchInputEvent");
+    InputEventRecord record;
+    if (!InputEventFrame::Decode(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), record)) {
         return;
     }
+    bool dispatched = InputEventFrame::Dispatch(record);
+    if ((record.flags & InputEventFrame::FLAG_REPLY) != 0) {
+        uint8_t result = dispatched ? 1 : 0;
+        socket->WriteFrame(MessageFrame::TYPE_INPUT_EVENT, requestId, &result, sizeof(result));
+    }
+}
 
-    ProcessCommandMessage(message);
+void CommandLineInterface::SetProtocolVersion(uint32_t version) const
+{
+    pendingProtocolVersion = version;
 }
 
-void CommandLineInterface::ProcessCommandMessage(std::string message) const
+uint32_t CommandLineInterface::GetProtocolVersion() const
 {
+    if (socket != nullptr && socket->IsMessageFramed()) {
+        return MessageFrame::FRAMED_PROTOCOL_VERSION;
+    }
+    return MessageFrame::TEXT_PROTOCOL_VERSION;
+}
+
+void CommandLineInterface::SetCompressionThreshold(size_t threshold) const
+{
+    compressionThreshold = threshold;
+}
+
+size_t CommandLineInterface::GetCompressionThreshold() const
+{
+    return compressionThreshold;
+}
+
+int64_t CommandLineInterface::GetPendingWriteBytes() const
+{
+    if (socket == nullptr) {
+        return -1;
+    }
+    return socket->GetPendingWriteBytes();
+}
+
+void CommandLineInterface::ApplyProtocolVersion() const
+{
+    if (pendingProtocolVersion == 0 || socket == nullptr) {
+        return;
+    }
+    bool framed = pendingProtocolVersion == MessageFrame::FRAMED_PROTOCOL_VERSION;
+    pendingProtocolVersion = 0;
+    if (framed != socket->IsMessageFramed()) {
+        frameReader->Reset();
+        socket->SetMessageFramed(framed);
+        ILOG("Command pipe protocol switched to %s", framed ? "framed" : "text");
+    }
+}
+
+void CommandLineInterface::WaitForCommand(int64_t timeout) const
+{
+    // The websocket listening state is set by the app thread and can not wake up this thread.
+    if (isPipeConnected && isFirstWsSend) {
+        timeout = (timeout < 0 || timeout > STARTUP_POLL_TIME) ? STARTUP_POLL_TIME : timeout;
+    }
+    int64_t replayTimeout = CommandReplayer::GetInstance().GetNextTimeout();
+    if (replayTimeout >= 0 && (timeout < 0 || replayTimeout < timeout)) {
+        timeout = replayTimeout;
+    }
+    if (timeout < 0 || timeout > MAX_WAIT_TIME) {
+        timeout = MAX_WAIT_TIME;
+    }
+    // Queued commands run on the next pass, new ones are read then as well.
+    if (!CommandScheduler::GetInstance().IsEmpty()) {
+        timeout = 0;
+    }
+    reactor->Wait(timeout);
+}
+
+void CommandLineInterface::Wakeup() const
+{
+    reactor->Wakeup();
+}
+
+void CommandLineInterface::ProcessCommandMessage(const std::string& message) const
+{
+    CommandRecorder::GetInstance().RecordMessage(message, 0);
+    ScheduledCommand command;
+    if (ParseCommandMessage(message, command)) {
+        RunCommand(command);
+    }
+}
+
+bool CommandLineInterface::ParseCommandMessage(const std::string& message, ScheduledCommand& command) const
+{
+    TRACE_EVENT_SCOPE("ProcessCommand");
+    command.receiveTime = std::chrono::steady_clock::now();
     ILOG("***cmd*** message:%s", message.c_str());
-    Json2::Value jsonData = JsonReader::ParseJsonData2(message);
+    Json2::Value jsonData;
+    {
+        // The message is freed once its command ran, its tree is carved from the json arena.
+        JsonArena::Scope arenaScope;
+        jsonData = JsonReader::ParseJsonData2(message);
+    }
     std::string errors; /* NOLINT */
     bool parsingSuccessful = jsonData.IsNull() ? false : true;
     if (!parsingSuccessful) {
@@ -120,26 +374,39 @@ void CommandLineInterface::ProcessCommandMessage(std::string message) const
     }
 
     if (!ProcessCommandValidate(parsingSuccessful, jsonData, errors)) {
-        return;
+        return false;
     }
 
-    CommandLine::CommandType type = GetCommandType(jsonData["type"].AsString());
-    if (type == CommandLine::CommandType::INVALID) {
-        return;
+    command.type = GetCommandType(jsonData["type"].AsString());
+    if (command.type == CommandLine::CommandType::INVALID) {
+        return false;
     }
 
-    std::string command = jsonData["command"].AsString();
-    if (CommandParser::GetInstance().IsStaticCard() && IsStaticIgnoreCmd(command)) {
-        return;
+    command.name = jsonData["command"].AsString();
+    if (CommandParser::GetInstance().IsStaticCard() && IsStaticIgnoreCmd(command.name)) {
+        return false;
     }
-    Json2::Value val = jsonData["args"];
-    std::unique_ptr<CommandLine> commandLine =
-        CommandLineFactory::CreateCommandLine(command, type, val, *socket);
-    if (commandLine == nullptr) {
-        ELOG("Unsupported command");
+    if (jsonData.IsMember("requestId")) {
+        command.clientRequestId = jsonData["requestId"].AsString();
+    }
+    command.message = std::move(jsonData);
+    return true;
+}
+
+void CommandLineInterface::RunCommand(const ScheduledCommand& command) const
+{
+    // Everything in ProcessCommand before this span is parsing and validation.
+    TRACE_EVENT_SCOPE("DispatchCommand");
+    Json2::Value val = command.message["args"];
+    bool isRun = CommandLineFactory::RunCommandLine(command.name, command.type, val, *socket,
+        command.clientRequestId, command.requestId);
+    if (!isRun) {
         return;
     }
-    commandLine->CheckAndRun();
+    // Includes the time the command waited in its lane.
+    int64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - command.receiveTime).count();
+    CommandLineFactory::GetCommandLatency(command.name).Record(static_cast<uint64_t>(latency));
 }
 
 bool CommandLineInterface::ProcessCommandValidate(bool parsingSuccessful,
@@ -161,15 +428,51 @@ bool CommandLineInterface::ProcessCommandValidate(bool parsingSuccessful,
         return false;
     }
 
-    if (!jsonData["version"].IsString() || !regex_match(jsonData["version"].AsString(),
-        std::regex("(([0-9]|([1-9]([0-9]*))).){2}([0-9]|([1-9]([0-9]*)))"))) {
+    if (!jsonData["version"].IsString() || !IsVersionValid(jsonData["version"].AsString())) {
         ELOG("Invalid command version!");
         return false;
     }
+
+    if (jsonData.IsMember("requestId") && !jsonData["requestId"].IsString()) {
+        ELOG("Invalid command requestId!");
+        return false;
+    }
     return true;
 }
 
-CommandLine::CommandType CommandLineInterface::GetCommandType(std::string name) const
+bool CommandLineInterface::IsVersionValid(const std::string& version)
+{
+    // Clients send the version they were built against, almost always this one.
+    if (version == COMMAND_VERSION) {
+        return true;
+    }
+    const size_t numberCount = 3;
+    return MatchVersion(version, 0, numberCount);
+}
+
+bool CommandLineInterface::MatchVersion(const std::string& version, size_t pos, size_t numberCount)
+{
+    // What (([0-9]|([1-9]([0-9]*))).){2}([0-9]|([1-9]([0-9]*))) accepts: numbers without a leading
+    // zero, each but the last followed by any one character, which may be a digit as well.
+    if (pos >= version.size() || version[pos] < '0' || version[pos] > '9') {
+        return false;
+    }
+    size_t end = pos + 1;
+    if (version[pos] != '0') {
+        while (end < version.size() && version[end] >= '0' && version[end] <= '9') {
+            end++;
+        }
+    }
+    for (; end > pos; end--) {
+        if (numberCount == 1 ? end == version.size() :
+            end < version.size() && MatchVersion(version, end + 1, numberCount - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CommandLine::CommandType CommandLineInterface::GetCommandType(const std::string& name) const
 {
     CommandLine::CommandType type = CommandLine::CommandType::INVALID;
     if (name == "set") {
@@ -241,6 +544,22 @@ void CommandLineInterface::Init(std::string pipeBaseName)
 {
     CommandLineFactory::InitCommandMap();
     InitPipe(pipeBaseName);
+    AsyncCommandRunner::GetInstance().SetNotifier([]() { CommandLineInterface::GetInstance().Wakeup(); });
+}
+
+bool CommandLineInterface::InitReplay(const std::string& path, double speed, const std::string& reportPath)
+{
+    CommandLineFactory::InitCommandMap();
+    if (!CommandReplayer::GetInstance().Load(path)) {
+        return false;
+    }
+    // Never connected, so the replies go nowhere.
+    socket = std::make_unique<LocalSocket>();
+    replayReportPath = reportPath;
+    AsyncCommandRunner::GetInstance().SetNotifier([]() { CommandLineInterface::GetInstance().Wakeup(); });
+    CommandReplayer::GetInstance().Start(speed);
+    ILOG("Replaying %s at speed %.2f", path.c_str(), speed);
+    return true;
 }
 
 void CommandLineInterface::ReadAndApplyConfig(std::string path) const
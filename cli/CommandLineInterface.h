@@ -21,6 +21,10 @@
 
 #include "CommandLine.h"
 #include "LocalSocket.h"
+#include "MessageFrame.h"
+#include "Reactor.h"
+
+struct ScheduledCommand;
 
 class CommandLineInterface {
 public:
@@ -31,26 +35,69 @@ public:
     static void SendJsonData(const Json2::Value&);
     void SendJSHeapMemory(size_t total, size_t alloc, size_t peak) const;
     void SendWebsocketStartupSignal() const;
+    // Queues the commands that arrived and runs the most urgent one.
     void ProcessCommand() const;
-    void ProcessCommandMessage(std::string message) const;
+    // Blocks until a command arrives or timeout milliseconds pass, timeout < 0 means no timer is due.
+    void WaitForCommand(int64_t timeout) const;
+    // Makes WaitForCommand return early, may be called from any thread.
+    void Wakeup() const;
+    // Runs the command right away, bypassing the queue.
+    void ProcessCommandMessage(const std::string& message) const;
     void ApplyConfig(const Json2::Value& val) const;
     void ApplyConfigMembers(const Json2::Value& commands, const Json2::Value::Members& members) const;
     void ApplyConfigCommands(const std::string& key, const std::unique_ptr<CommandLine>& command) const;
     void Init(std::string pipeBaseName);
+    // Reads the commands from a recording instead of the pipe, replies are dropped. The previewer
+    // exits once every command has run, after writing the report to reportPath.
+    bool InitReplay(const std::string& path, double speed, const std::string& reportPath);
     void ReadAndApplyConfig(std::string path) const;
     void CreatCommandToSendData(const std::string, const Json2::Value&, const std::string) const;
+    // Takes effect after the reply of the current command has been sent.
+    void SetProtocolVersion(uint32_t version) const;
+    uint32_t GetProtocolVersion() const;
+    // Replies of compressible commands at least this large are deflated, 0 turns it off.
+    void SetCompressionThreshold(size_t threshold) const;
+    size_t GetCompressionThreshold() const;
+    // Bytes of replies the IDE has not read from the command pipe yet, -1 if unknown.
+    int64_t GetPendingWriteBytes() const;
+    // Drops the queued or unfinished command with the client request id and answers it as cancelled.
+    bool CancelRequest(const std::string& clientRequestId) const;
 
     const static std::string COMMAND_VERSION;
+    static constexpr size_t DEFAULT_COMPRESSION_THRESHOLD = 64 * 1024;
 
 private:
     explicit CommandLineInterface();
     virtual ~CommandLineInterface();
     bool ProcessCommandValidate(bool parsingSuccessful, const Json2::Value& jsonData, const std::string& errors) const;
-    CommandLine::CommandType GetCommandType(std::string name) const;
+    CommandLine::CommandType GetCommandType(const std::string& name) const;
+    static bool IsVersionValid(const std::string& version);
+    static bool MatchVersion(const std::string& version, size_t pos, size_t numberCount);
+    void ReadCommands() const;
+    bool ReadCommandFrame() const;
+    void ReplayCommands() const;
+    void QueueCommandMessage(const std::string& message, uint32_t requestId) const;
+    bool ParseCommandMessage(const std::string& message, ScheduledCommand& command) const;
+    void RunCommand(const ScheduledCommand& command) const;
+    void SendCancelled(const std::string& command, const std::string& clientRequestId,
+                       uint32_t frameRequestId) const;
+    void SendAsyncReplies() const;
+    void ProcessInputEventFrame(uint32_t requestId, const std::string& payload) const;
+    void ApplyProtocolVersion() const;
     std::unique_ptr<LocalSocket> socket;
+    std::unique_ptr<Reactor> reactor;
+    std::unique_ptr<MessageFrameReader> frameReader;
+    std::string replayReportPath;
     const static uint32_t MAX_COMMAND_LENGTH = 128;
+    const static int64_t MAX_WAIT_TIME = 1000; // bounds the latency of Interrupter::Interrupt from other threads
+    const static int64_t STARTUP_POLL_TIME = 1; // until the websocket port is sent
+    const static uint32_t MAX_READ_COMMANDS = 64; // per pass, so a flood can not starve the timers
+    constexpr static const char* PROTOCOL_VERSION_COMMAND = "ProtocolVersion";
     static bool isFirstWsSend;
     static bool isPipeConnected;
+    static uint32_t pendingProtocolVersion; // 0 if no switch is requested
+    static size_t compressionThreshold; // 0 until the IDE enables compression
+    static bool isReadPaused; // a protocol switch is queued, what follows may be framed differently
     std::vector<std::string> staticIgnoreCmd = { "ResolutionSwitch", "exit", "Language", "SupportedLanguages" };
     bool IsStaticIgnoreCmd(const std::string cmd) const;
 };
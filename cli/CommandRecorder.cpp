@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "CommandRecorder.h"
+
+#include "Compression.h"
+#include "JsonReader.h"
+#include "PreviewerEngineLog.h"
+
+CommandRecorder::CommandRecorder() : isRecording(false) {}
+
+CommandRecorder::~CommandRecorder()
+{
+    Stop();
+}
+
+CommandRecorder& CommandRecorder::GetInstance()
+{
+    static CommandRecorder instance;
+    return instance;
+}
+
+bool CommandRecorder::Start(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (file.is_open()) {
+        file.close();
+    }
+    file.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        ELOG("CommandRecorder::Start open %s failed", path.c_str());
+        isRecording = false;
+        return false;
+    }
+    startTime = std::chrono::steady_clock::now();
+    isRecording = true;
+    ILOG("Recording commands to %s", path.c_str());
+    return true;
+}
+
+void CommandRecorder::Stop()
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    isRecording = false;
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+void CommandRecorder::RecordMessage(const std::string& message, uint32_t requestId)
+{
+    if (!IsRecording()) {
+        return;
+    }
+    CommandRecord record;
+    record.data = message;
+    record.requestId = requestId;
+    Write(record);
+}
+
+void CommandRecorder::RecordInputEvent(uint32_t requestId, const std::string& payload)
+{
+    if (!IsRecording()) {
+        return;
+    }
+    CommandRecord record;
+    record.data = payload;
+    record.isInputEvent = true;
+    record.requestId = requestId;
+    Write(record);
+}
+
+void CommandRecorder::Write(CommandRecord& record)
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (!file.is_open()) {
+        return;
+    }
+    record.time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    // Flushed per line, the previewer is usually killed rather than exited.
+    file << Encode(record) << '\n';
+    file.flush();
+}
+
+std::string CommandRecorder::Encode(const CommandRecord& record)
+{
+    Json2::Value line = JsonReader::CreateObject();
+    line.Add("time", record.time);
+    if (record.isInputEvent) {
+        line.Add("inputEvent", Compression::EncodeBase64(record.data).c_str());
+    } else {
+        line.Add("message", record.data.c_str());
+    }
+    if (record.requestId != 0) {
+        line.Add("requestId", static_cast<int64_t>(record.requestId));
+    }
+    return line.ToString();
+}
+
+bool CommandRecorder::Decode(const std::string& line, CommandRecord& record)
+{
+    Json2::Value value = JsonReader::ParseJsonData2(line);
+    if (value.IsNull() || !value.IsObject() || !value.IsMember("time") || !value["time"].IsInt64()) {
+        return false;
+    }
+    record.time = value["time"].AsInt64();
+    record.requestId = 0;
+    if (value.IsMember("requestId")) {
+        if (!value["requestId"].IsInt64() || value["requestId"].AsInt64() < 0 ||
+            value["requestId"].AsInt64() > UINT32_MAX) {
+            return false;
+        }
+        record.requestId = static_cast<uint32_t>(value["requestId"].AsInt64());
+    }
+    if (value.IsMember("message") && value["message"].IsString()) {
+        record.data = value["message"].AsString();
+        record.isInputEvent = false;
+        return true;
+    }
+    if (value.IsMember("inputEvent") && value["inputEvent"].IsString()) {
+        record.isInputEvent = true;
+        return Compression::DecodeBase64(value["inputEvent"].AsString(), record.data);
+    }
+    return false;
+}
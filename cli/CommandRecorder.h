@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef COMMANDRECORDER_H
+#define COMMANDRECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+// One message of a recorded session, a line of the recording.
+struct CommandRecord {
+    int64_t time = 0; // us since the recording started
+    std::string data; // the raw JSON message, or the payload of a binary input event frame
+    bool isInputEvent = false;
+    uint32_t requestId = 0; // of the frame that carried it, 0 in the text protocol
+};
+
+// Writes every message read from the command pipe to a file, one JSON object per line, so that
+// the session can be replayed with its original timing by CommandReplayer.
+class CommandRecorder {
+public:
+    CommandRecorder(const CommandRecorder&) = delete;
+    CommandRecorder& operator=(const CommandRecorder&) = delete;
+    static CommandRecorder& GetInstance();
+
+    bool Start(const std::string& path);
+    void Stop();
+    inline bool IsRecording() const
+    {
+        return isRecording.load(std::memory_order_relaxed);
+    }
+    void RecordMessage(const std::string& message, uint32_t requestId);
+    void RecordInputEvent(uint32_t requestId, const std::string& payload);
+
+    static std::string Encode(const CommandRecord& record);
+    static bool Decode(const std::string& line, CommandRecord& record);
+
+private:
+    CommandRecorder();
+    ~CommandRecorder();
+    void Write(CommandRecord& record);
+
+    std::atomic<bool> isRecording;
+    std::mutex fileMutex; // guards the file and the start time
+    std::ofstream file;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+#endif // COMMANDRECORDER_H
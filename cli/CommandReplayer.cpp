@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "CommandReplayer.h"
+
+#include <fstream>
+
+#include "PreviewerEngineLog.h"
+
+CommandReplayer::CommandReplayer() : nextIndex(0), skippedCount(0), speed(1.0), isReplaying(false) {}
+
+CommandReplayer& CommandReplayer::GetInstance()
+{
+    static CommandReplayer instance;
+    return instance;
+}
+
+bool CommandReplayer::Load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        ELOG("CommandReplayer::Load open %s failed", path.c_str());
+        return false;
+    }
+    records.clear();
+    nextIndex = 0;
+    skippedCount = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        CommandRecord record;
+        if (!CommandRecorder::Decode(line, record)) {
+            skippedCount++;
+            continue;
+        }
+        records.push_back(std::move(record));
+    }
+    recordingPath = path;
+    ILOG("Loaded %zu commands to replay from %s, %zu lines skipped", records.size(), path.c_str(), skippedCount);
+    return true;
+}
+
+void CommandReplayer::Start(double replaySpeed)
+{
+    speed = replaySpeed;
+    nextIndex = 0;
+    startTime = std::chrono::steady_clock::now();
+    startSnapshot = PerfStats::GetInstance().TakeSnapshot();
+    isReplaying = true;
+}
+
+bool CommandReplayer::Next(CommandRecord& record, bool isIdle)
+{
+    if (!isReplaying || nextIndex >= records.size()) {
+        return false;
+    }
+    if (speed <= 0) {
+        // One at a time, so nothing is superseded or reordered in the queue.
+        if (!isIdle) {
+            return false;
+        }
+    } else if (GetNextTimeout() > 0) {
+        return false;
+    }
+    record = records[nextIndex++];
+    return true;
+}
+
+bool CommandReplayer::IsDrained() const
+{
+    return nextIndex >= records.size();
+}
+
+int64_t CommandReplayer::GetNextTimeout() const
+{
+    if (!isReplaying || nextIndex >= records.size()) {
+        return -1;
+    }
+    if (speed <= 0) {
+        return 0;
+    }
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    int64_t remain = GetDueTime(records[nextIndex]) - elapsed;
+    if (remain <= 0) {
+        return 0;
+    }
+    const int64_t microsecondsPerMillisecond = 1000;
+    return (remain + microsecondsPerMillisecond - 1) / microsecondsPerMillisecond;
+}
+
+int64_t CommandReplayer::GetDueTime(const CommandRecord& record) const
+{
+    return static_cast<int64_t>(record.time / speed);
+}
+
+void CommandReplayer::GetReport(Json2::Value& report)
+{
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    const int64_t microsecondsPerMillisecond = 1000;
+    int64_t recorded = records.empty() ? 0 : records.back().time / microsecondsPerMillisecond;
+    report.Add("recording", recordingPath.c_str());
+    report.Add("speed", speed);
+    report.Add("replayed", static_cast<int64_t>(nextIndex));
+    report.Add("skipped", static_cast<int64_t>(skippedCount));
+    report.Add("recordedMs", recorded);
+    report.Add("elapsedMs", elapsed);
+    // Command latencies and frame statistics of the replay only.
+    Json2::Value stats = JsonReader::CreateObject();
+    PerfStats::Snapshot snapshot = PerfStats::GetInstance().TakeSnapshot();
+    PerfStats::GetInstance().ToJson(snapshot, &startSnapshot, stats);
+    report.Add("stats", stats);
+}
+
+bool CommandReplayer::Finish(const std::string& reportPath)
+{
+    if (!isReplaying) {
+        return false;
+    }
+    Json2::Value report = JsonReader::CreateObject();
+    GetReport(report);
+    isReplaying = false;
+    std::string content = report.ToStyledString();
+    if (reportPath.empty()) {
+        ILOG("Replay finished: %s", content.c_str());
+        return true;
+    }
+    std::ofstream file(reportPath, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        ELOG("CommandReplayer::Finish open %s failed", reportPath.c_str());
+        return false;
+    }
+    file << content;
+    ILOG("Replay finished, report written to %s", reportPath.c_str());
+    return true;
+}
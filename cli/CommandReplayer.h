@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef COMMANDREPLAYER_H
+#define COMMANDREPLAYER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CommandRecorder.h"
+#include "JsonReader.h"
+#include "PerfStats.h"
+
+// Feeds a session written by CommandRecorder to the command loop in place of the command pipe,
+// then reports the command latency and frame statistics of the run. Command thread only.
+class CommandReplayer {
+public:
+    CommandReplayer(const CommandReplayer&) = delete;
+    CommandReplayer& operator=(const CommandReplayer&) = delete;
+    static CommandReplayer& GetInstance();
+
+    // Lines that can not be decoded are skipped and counted.
+    bool Load(const std::string& path);
+    // speed scales the recorded timing, 0 sends each message once the commands before it have run.
+    void Start(double speed);
+    inline bool IsReplaying() const
+    {
+        return isReplaying;
+    }
+    // Takes the next message that is due. isIdle tells that no command is waiting to run.
+    bool Next(CommandRecord& record, bool isIdle);
+    // All messages have been taken.
+    bool IsDrained() const;
+    // ms until the next message is due, -1 if none is left.
+    int64_t GetNextTimeout() const;
+    // Ends the replay and writes the report to reportPath, or to the log if it is empty.
+    bool Finish(const std::string& reportPath);
+    void GetReport(Json2::Value& report);
+
+    static constexpr double MAX_SPEED = 1000.0;
+
+private:
+    CommandReplayer();
+    ~CommandReplayer() = default;
+    int64_t GetDueTime(const CommandRecord& record) const; // us since the start
+
+    std::string recordingPath;
+    std::vector<CommandRecord> records;
+    size_t nextIndex;
+    size_t skippedCount;
+    double speed;
+    bool isReplaying;
+    std::chrono::steady_clock::time_point startTime;
+    PerfStats::Snapshot startSnapshot;
+};
+
+#endif // COMMANDREPLAYER_H
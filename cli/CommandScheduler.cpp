@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CommandScheduler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
+namespace {
+    constexpr std::string_view INPUT_COMMANDS[] = {
+        "MousePress", "MouseRelease", "MouseMove", "KeyPress", "PointEvent", "CrownRotate",
+    };
+    constexpr std::string_view BULK_COMMANDS[] = {
+        "LoadDocument", "ResolutionSwitch", "ReloadRuntimePage", "LoadContent", "MemoryRefresh",
+        "FastPreviewMsg", "inspector", "inspectorDefault", "inspectorIncremental", "inspectorRefresh",
+    };
+    // Only the newest of these counts: each replaces the whole page or tree the one before produced.
+    constexpr std::string_view SUPERSEDED_COMMANDS[] = {
+        "LoadDocument", "ResolutionSwitch", "inspector", "inspectorDefault",
+    };
+    // Input queued after one of these waits for it.
+    constexpr std::string_view LAYOUT_COMMANDS[] = {
+        "ResolutionSwitch", "Orientation",
+    };
+    const char* const LANE_NAMES[] = { "input", "control", "bulk" };
+    const char* const DEPTH_METRICS[] = {
+        PerfMetric::COMMAND_QUEUE_INPUT, PerfMetric::COMMAND_QUEUE_CONTROL, PerfMetric::COMMAND_QUEUE_BULK
+    };
+    static_assert(sizeof(LANE_NAMES) / sizeof(LANE_NAMES[0]) == CommandScheduler::LANE_COUNT,
+        "every lane needs a name");
+    static_assert(sizeof(DEPTH_METRICS) / sizeof(DEPTH_METRICS[0]) == CommandScheduler::LANE_COUNT,
+        "every lane needs a depth metric");
+
+    template <size_t N>
+    bool Contains(const std::string_view (&names)[N], const std::string& name)
+    {
+        return std::find(std::begin(names), std::end(names), name) != std::end(names);
+    }
+}
+
+CommandScheduler::CommandScheduler()
+    : cancelledCount(PerfStats::GetInstance().GetCounter(PerfMetric::COMMAND_CANCELLED))
+{
+    for (size_t i = 0; i < LANE_COUNT; i++) {
+        depthGauges[i] = &PerfStats::GetInstance().GetGauge(DEPTH_METRICS[i]);
+    }
+}
+
+CommandScheduler& CommandScheduler::GetInstance()
+{
+    static CommandScheduler instance;
+    return instance;
+}
+
+void CommandScheduler::Push(ScheduledCommand&& command, std::vector<ScheduledCommand>& cancelled)
+{
+    Lane lane = GetLane(command.name);
+    std::deque<ScheduledCommand>& queue = (lane == Lane::INPUT) ? inputQueue : commandQueue;
+    for (auto iter = queue.begin(); iter != queue.end();) {
+        if (IsSupersededBy(*iter, command)) {
+            cancelled.emplace_back();
+            iter = Take(queue, iter, cancelled.back());
+            cancelledCount.Add();
+        } else {
+            ++iter;
+        }
+    }
+    command.sequence = nextSequence++;
+    queue.push_back(std::move(command));
+    size_t index = static_cast<size_t>(lane);
+    depths[index]++;
+    depthGauges[index]->Set(static_cast<int64_t>(depths[index]));
+}
+
+bool CommandScheduler::Pop(ScheduledCommand& command)
+{
+    std::deque<ScheduledCommand>* queue = &commandQueue;
+    if (!inputQueue.empty() && !IsBehindLayoutChange(inputQueue.front())) {
+        queue = &inputQueue;
+    }
+    if (queue->empty()) {
+        return false;
+    }
+    Take(*queue, queue->begin(), command);
+    return true;
+}
+
+bool CommandScheduler::Cancel(const std::string& clientRequestId, ScheduledCommand& cancelled)
+{
+    if (clientRequestId.empty()) {
+        return false;
+    }
+    for (std::deque<ScheduledCommand>* queue : { &commandQueue, &inputQueue }) {
+        auto iter = std::find_if(queue->begin(), queue->end(), [&clientRequestId](const ScheduledCommand& item) {
+            return item.clientRequestId == clientRequestId;
+        });
+        if (iter == queue->end()) {
+            continue;
+        }
+        Take(*queue, iter, cancelled);
+        cancelledCount.Add();
+        return true;
+    }
+    return false;
+}
+
+bool CommandScheduler::IsEmpty() const
+{
+    return inputQueue.empty() && commandQueue.empty();
+}
+
+size_t CommandScheduler::GetDepth(Lane lane) const
+{
+    if (lane >= Lane::COUNT) {
+        return 0;
+    }
+    return depths[static_cast<size_t>(lane)];
+}
+
+void CommandScheduler::Clear()
+{
+    inputQueue.clear();
+    commandQueue.clear();
+    for (size_t i = 0; i < LANE_COUNT; i++) {
+        depths[i] = 0;
+        depthGauges[i]->Set(0);
+    }
+}
+
+CommandScheduler::Lane CommandScheduler::GetLane(const std::string& command)
+{
+    if (Contains(INPUT_COMMANDS, command)) {
+        return Lane::INPUT;
+    }
+    if (Contains(BULK_COMMANDS, command)) {
+        return Lane::BULK;
+    }
+    return Lane::CONTROL;
+}
+
+const char* CommandScheduler::GetLaneName(Lane lane)
+{
+    if (lane >= Lane::COUNT) {
+        return "";
+    }
+    return LANE_NAMES[static_cast<size_t>(lane)];
+}
+
+bool CommandScheduler::IsSupersededBy(const ScheduledCommand& queued, const ScheduledCommand& command)
+{
+    return queued.name == command.name && queued.type == command.type &&
+        Contains(SUPERSEDED_COMMANDS, command.name);
+}
+
+bool CommandScheduler::IsBehindLayoutChange(const ScheduledCommand& input) const
+{
+    for (const ScheduledCommand& queued : commandQueue) {
+        if (queued.sequence > input.sequence) {
+            return false;
+        }
+        if (Contains(LAYOUT_COMMANDS, queued.name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::deque<ScheduledCommand>::iterator CommandScheduler::Take(std::deque<ScheduledCommand>& queue,
+    std::deque<ScheduledCommand>::iterator iter, ScheduledCommand& command)
+{
+    size_t index = static_cast<size_t>(GetLane(iter->name));
+    command = std::move(*iter);
+    depths[index]--;
+    depthGauges[index]->Set(static_cast<int64_t>(depths[index]));
+    return queue.erase(iter);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMANDSCHEDULER_H
+#define COMMANDSCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "CommandLine.h"
+#include "JsonReader.h"
+#include "PerfStats.h"
+
+struct ScheduledCommand {
+    std::string name;
+    CommandLine::CommandType type = CommandLine::CommandType::INVALID;
+    Json2::Value message; // the parsed message, owns the args
+    uint32_t requestId = 0; // of the frame that carried the command, 0 in the text protocol
+    std::string clientRequestId; // "requestId" of the message, echoed in the reply
+    std::chrono::steady_clock::time_point receiveTime;
+    uint64_t sequence = 0; // arrival order, set by Push
+};
+
+// Commands read from the pipe wait here until the command thread runs them, in arrival order except
+// that input overtakes the control and bulk commands queued before it. Input never overtakes a
+// command that changes the layout, such as a ResolutionSwitch, so it hits what the user saw. A bulk
+// command cancels the queued ones it makes obsolete, such as an older ResolutionSwitch. Command
+// thread only.
+class CommandScheduler {
+public:
+    enum class Lane {
+        INPUT = 0, // touch, mouse, key and crown events
+        CONTROL,
+        BULK, // reloads the page or serializes the component tree
+        COUNT
+    };
+
+    CommandScheduler(const CommandScheduler&) = delete;
+    CommandScheduler& operator=(const CommandScheduler&) = delete;
+    static CommandScheduler& GetInstance();
+
+    // The queued commands command supersedes are moved to cancelled, for the caller to answer.
+    void Push(ScheduledCommand&& command, std::vector<ScheduledCommand>& cancelled);
+    // Takes the next command to run, false if none is queued.
+    bool Pop(ScheduledCommand& command);
+    // Removes the queued command with the client request id.
+    bool Cancel(const std::string& clientRequestId, ScheduledCommand& cancelled);
+    bool IsEmpty() const;
+    size_t GetDepth(Lane lane) const;
+    void Clear();
+    static Lane GetLane(const std::string& command);
+    static const char* GetLaneName(Lane lane);
+
+    static constexpr size_t LANE_COUNT = static_cast<size_t>(Lane::COUNT);
+
+private:
+    CommandScheduler();
+    ~CommandScheduler() = default;
+    static bool IsSupersededBy(const ScheduledCommand& queued, const ScheduledCommand& command);
+    // Whether a command queued before the input changes the layout the input was aimed at.
+    bool IsBehindLayoutChange(const ScheduledCommand& input) const;
+    // Moves the command out of the queue, returns the iterator past it.
+    std::deque<ScheduledCommand>::iterator Take(std::deque<ScheduledCommand>& queue,
+        std::deque<ScheduledCommand>::iterator iter, ScheduledCommand& command);
+
+    std::deque<ScheduledCommand> inputQueue;
+    std::deque<ScheduledCommand> commandQueue; // control and bulk
+    uint64_t nextSequence = 0;
+    size_t depths[LANE_COUNT] = {};
+    PerfGauge* depthGauges[LANE_COUNT];
+    PerfCounter& cancelledCount;
+};
+
+#endif // COMMANDSCHEDULER_H
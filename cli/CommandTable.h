@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMANDTABLE_H
+#define COMMANDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Every command name the previewer knows, rich and lite. The hash seed is searched by the
+// compiler so that no two names share a slot: a lookup is one hash and one compare.
+namespace CommandTable {
+    constexpr std::string_view NAMES[] = {
+        // rich
+        "BackClicked", "inspector", "inspectorDefault", "inspectorIncremental", "inspectorRefresh",
+        "ColorMode", "Orientation", "ResolutionSwitch", "CurrentRouter", "ReloadRuntimePage", "FontSelect",
+        "MemoryRefresh", "LoadDocument", "FastPreviewMsg", "DropFrame", "KeyPress", "LoadContent", "FoldStatus",
+        "AvoidArea", "AvoidAreaChanged",
+        // lite
+        "Power", "Volume", "Barometer", "Location", "KeepScreenOnState", "WearingState", "BrightnessMode",
+        "ChargeMode", "Brightness", "HeartRate", "StepCount", "DistributedCommunications", "CrownRotate",
+        // both
+        "MousePress", "MouseRelease", "MouseMove", "Language", "SupportedLanguages", "exit", "Resolution",
+        "DeviceType", "PointEvent", "ProtocolVersion", "Compression", "LogLevel", "TraceEvent", "PerfStats",
+        "PerfOverlay", "MemoryStats", "Cancel", "Batch",
+    };
+    constexpr size_t COUNT = sizeof(NAMES) / sizeof(NAMES[0]);
+    constexpr size_t NOT_FOUND = COUNT;
+    constexpr size_t SLOT_COUNT = 256; // sparse enough for a seed to turn up within a few hundred tries
+    static_assert(SLOT_COUNT >= COUNT * 4, "SLOT_COUNT is too small");
+    static_assert(COUNT < UINT8_MAX, "slots hold the index in a byte");
+    constexpr uint32_t SLOT_SHIFT = 24; // 32 bits of hash down to the 256 slots
+    constexpr uint32_t FNV_OFFSET_BASIS = 2166136261u;
+    constexpr uint32_t FNV_PRIME = 16777619u;
+    constexpr uint32_t MAX_SEED_TRIES = 10000;
+
+    struct Slots {
+        uint8_t index[SLOT_COUNT];
+    };
+
+    // FNV-1a with the seed as offset basis. The low bits of a product only depend on the low bits
+    // of its factors, so the high bits, which every bit of the seed reaches, pick the slot.
+    constexpr uint32_t Hash(std::string_view name, uint32_t seed)
+    {
+        uint32_t hash = seed;
+        for (char c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+        }
+        return hash >> SLOT_SHIFT;
+    }
+
+    constexpr bool IsPerfect(uint32_t seed)
+    {
+        bool isUsed[SLOT_COUNT] = {};
+        for (size_t i = 0; i < COUNT; i++) {
+            size_t slot = Hash(NAMES[i], seed);
+            if (isUsed[slot]) {
+                return false;
+            }
+            isUsed[slot] = true;
+        }
+        return true;
+    }
+
+    constexpr uint32_t FindSeed()
+    {
+        for (uint32_t seed = FNV_OFFSET_BASIS; seed < FNV_OFFSET_BASIS + MAX_SEED_TRIES; seed++) {
+            if (IsPerfect(seed)) {
+                return seed;
+            }
+        }
+        return 0;
+    }
+
+    constexpr uint32_t SEED = FindSeed();
+    static_assert(SEED != 0, "no perfect hash seed for the command names, raise SLOT_COUNT");
+
+    constexpr Slots BuildSlots()
+    {
+        Slots slots = {};
+        for (size_t i = 0; i < SLOT_COUNT; i++) {
+            slots.index[i] = static_cast<uint8_t>(COUNT);
+        }
+        for (size_t i = 0; i < COUNT; i++) {
+            slots.index[Hash(NAMES[i], SEED)] = static_cast<uint8_t>(i);
+        }
+        return slots;
+    }
+
+    constexpr Slots SLOTS = BuildSlots();
+
+    // Index of name in NAMES, or NOT_FOUND.
+    constexpr size_t Find(std::string_view name)
+    {
+        size_t index = SLOTS.index[Hash(name, SEED)];
+        return index < COUNT && NAMES[index] == name ? index : NOT_FOUND;
+    }
+}; // namespace CommandTable
+
+#endif // COMMANDTABLE_H
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InputCoalescer.h"
+
+#include "CppTimerManager.h"
+#include "MouseInputImpl.h"
+#include "PreviewerEngineLog.h"
+
+InputCoalescer::InputCoalescer()
+    : pendingEvent {},
+      hasPendingEvent(false),
+      mergedCount(0),
+      flushInterval(DEFAULT_FLUSH_INTERVAL),
+      flushTimer(InputCoalescer::OnFlushTimer)
+{
+    CppTimerManager::GetTimerManager().AddCppTimer(flushTimer);
+}
+
+InputCoalescer::~InputCoalescer() {}
+
+InputCoalescer& InputCoalescer::GetInstance()
+{
+    static InputCoalescer instance;
+    return instance;
+}
+
+void InputCoalescer::Push(InputEventParams& params)
+{
+    if (flushInterval <= 0 || !IsMoveEvent(params)) {
+        Flush();
+        Dispatch(params);
+        return;
+    }
+    if (hasPendingEvent) {
+        if (CanMerge(params)) {
+            pendingEvent = params;
+            mergedCount++;
+            return;
+        }
+        Flush();
+    }
+    auto now = std::chrono::steady_clock::now();
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastDispatchTime).count();
+    if (elapsed >= flushInterval) {
+        Dispatch(params);
+        return;
+    }
+    // Too close to the previous dispatch, hold it until the engine has had a frame to catch up.
+    pendingEvent = params;
+    hasPendingEvent = true;
+    if (!flushTimer.IsRunning()) {
+        flushTimer.Start(flushInterval - elapsed);
+    }
+}
+
+void InputCoalescer::Flush()
+{
+    if (flushTimer.IsRunning()) {
+        flushTimer.Stop();
+    }
+    if (!hasPendingEvent) {
+        return;
+    }
+    hasPendingEvent = false;
+    if (mergedCount > 0) {
+        ILOG("InputCoalescer merged %u %s events", mergedCount, pendingEvent.name.c_str());
+        mergedCount = 0;
+    }
+    Dispatch(pendingEvent);
+}
+
+void InputCoalescer::SetFlushInterval(int64_t interval)
+{
+    Flush();
+    flushInterval = interval;
+}
+
+bool InputCoalescer::IsMoveEvent(const InputEventParams& params) const
+{
+    return params.type == TOUCH_TYPE_MOVE || params.type == TOUCH_TYPE_POINT_EVENT;
+}
+
+bool InputCoalescer::CanMerge(const InputEventParams& params) const
+{
+    // Only the position and the axis values may change, anything else is a state change.
+    return pendingEvent.type == params.type && pendingEvent.button == params.button &&
+        pendingEvent.action == params.action && pendingEvent.sourceType == params.sourceType &&
+        pendingEvent.sourceTool == params.sourceTool && pendingEvent.pressedBtnsVec == params.pressedBtnsVec;
+}
+
+void InputCoalescer::Dispatch(InputEventParams& params)
+{
+    lastDispatchTime = std::chrono::steady_clock::now();
+    MouseInputImpl& input = MouseInputImpl::GetInstance();
+    input.SetMousePosition(params.x, params.y);
+    input.SetMouseStatus(params.type);
+    input.SetMouseButton(params.button);
+    input.SetMouseAction(params.action);
+    input.SetSourceType(params.sourceType);
+    input.SetSourceTool(params.sourceTool);
+    input.SetPressedBtns(params.pressedBtnsVec);
+    input.SetAxisValues(params.axisVec);
+    input.DispatchOsTouchEvent();
+}
+
+void InputCoalescer::OnFlushTimer()
+{
+    GetInstance().Flush();
+}
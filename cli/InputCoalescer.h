@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INPUTCOALESCER_H
+#define INPUTCOALESCER_H
+
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "CppTimer.h"
+
+struct InputEventParams {
+    double x;
+    double y;
+    int type;
+    int button;
+    int action;
+    int sourceType;
+    int sourceTool;
+    std::set<int> pressedBtnsVec;
+    std::vector<double> axisVec; // 13 is array size
+    std::string name;
+};
+
+// Merges consecutive move events of the same pointer so that at most one of them reaches
+// the engine per flush interval. Any other event flushes the pending move first, so press
+// and release keep their order relative to the moves around them. Command thread only.
+class InputCoalescer {
+public:
+    InputCoalescer(const InputCoalescer&) = delete;
+    InputCoalescer& operator=(const InputCoalescer&) = delete;
+    static InputCoalescer& GetInstance();
+
+    void Push(InputEventParams& params);
+    void Flush();
+    // 0 dispatches every event as soon as it arrives.
+    void SetFlushInterval(int64_t interval);
+
+    static constexpr int64_t DEFAULT_FLUSH_INTERVAL = 16; // one frame at 60 fps
+    static constexpr int TOUCH_TYPE_MOVE = 2;
+    static constexpr int TOUCH_TYPE_POINT_EVENT = 9;
+
+private:
+    InputCoalescer();
+    ~InputCoalescer();
+    bool IsMoveEvent(const InputEventParams& params) const;
+    bool CanMerge(const InputEventParams& params) const;
+    void Dispatch(InputEventParams& params);
+    static void OnFlushTimer();
+
+    InputEventParams pendingEvent;
+    bool hasPendingEvent;
+    uint32_t mergedCount;
+    int64_t flushInterval;
+    std::chrono::steady_clock::time_point lastDispatchTime;
+    CppTimer flushTimer;
+};
+
+#endif // INPUTCOALESCER_H
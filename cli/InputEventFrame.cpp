@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InputEventFrame.h"
+
+#include <cstring>
+
+#include "CommandParser.h"
+#include "EndianUtil.h"
+#include "InputCoalescer.h"
+#include "PreviewerEngineLog.h"
+#include "VirtualScreenImpl.h"
+
+namespace {
+    constexpr size_t TYPE_OFFSET = 0;
+    constexpr size_t FLAGS_OFFSET = 2;
+    constexpr size_t BUTTON_OFFSET = 4;
+    constexpr size_t ACTION_OFFSET = 8;
+    constexpr size_t SOURCE_TYPE_OFFSET = 12;
+    constexpr size_t SOURCE_TOOL_OFFSET = 16;
+    constexpr size_t PRESSED_BUTTONS_OFFSET = 20;
+    constexpr size_t X_OFFSET = 24;
+    constexpr size_t Y_OFFSET = 32;
+    constexpr size_t AXIS_COUNT_OFFSET = 40;
+    constexpr size_t AXIS_VALUES_OFFSET = 48;
+    constexpr uint32_t MAX_PRESSED_BUTTON = 31;
+
+    template <class T>
+    void Put(uint8_t* buffer, size_t offset, T value)
+    {
+        T data = EndianUtil::ToNetworkEndian<T>(value);
+        std::memcpy(buffer + offset, &data, sizeof(T));
+    }
+
+    template <class T>
+    T Get(const uint8_t* buffer, size_t offset)
+    {
+        T data;
+        std::memcpy(&data, buffer + offset, sizeof(T));
+        return EndianUtil::ToNetworkEndian<T>(data);
+    }
+
+    void PutDouble(uint8_t* buffer, size_t offset, double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Put<uint64_t>(buffer, offset, bits);
+    }
+
+    double GetDouble(const uint8_t* buffer, size_t offset)
+    {
+        uint64_t bits = Get<uint64_t>(buffer, offset);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+void InputEventFrame::Encode(const InputEventRecord& record, uint8_t (&buffer)[RECORD_SIZE])
+{
+    std::memset(buffer, 0, RECORD_SIZE);
+    Put<uint16_t>(buffer, TYPE_OFFSET, record.type);
+    Put<uint16_t>(buffer, FLAGS_OFFSET, record.flags);
+    Put<int32_t>(buffer, BUTTON_OFFSET, record.button);
+    Put<int32_t>(buffer, ACTION_OFFSET, record.action);
+    Put<int32_t>(buffer, SOURCE_TYPE_OFFSET, record.sourceType);
+    Put<int32_t>(buffer, SOURCE_TOOL_OFFSET, record.sourceTool);
+    Put<uint32_t>(buffer, PRESSED_BUTTONS_OFFSET, record.pressedButtons);
+    PutDouble(buffer, X_OFFSET, record.x);
+    PutDouble(buffer, Y_OFFSET, record.y);
+    Put<uint32_t>(buffer, AXIS_COUNT_OFFSET, record.axisCount);
+    for (size_t i = 0; i < InputEventRecord::MAX_AXIS_COUNT; i++) {
+        PutDouble(buffer, AXIS_VALUES_OFFSET + i * sizeof(double), record.axisValues[i]);
+    }
+}
+
+bool InputEventFrame::Decode(const uint8_t* data, size_t length, InputEventRecord& record)
+{
+    if (data == nullptr || length != RECORD_SIZE) {
+        ELOG("InputEventFrame::Decode invalid record size: %zu", length);
+        return false;
+    }
+    record.type = Get<uint16_t>(data, TYPE_OFFSET);
+    record.flags = Get<uint16_t>(data, FLAGS_OFFSET);
+    record.button = Get<int32_t>(data, BUTTON_OFFSET);
+    record.action = Get<int32_t>(data, ACTION_OFFSET);
+    record.sourceType = Get<int32_t>(data, SOURCE_TYPE_OFFSET);
+    record.sourceTool = Get<int32_t>(data, SOURCE_TOOL_OFFSET);
+    record.pressedButtons = Get<uint32_t>(data, PRESSED_BUTTONS_OFFSET);
+    record.x = GetDouble(data, X_OFFSET);
+    record.y = GetDouble(data, Y_OFFSET);
+    record.axisCount = Get<uint32_t>(data, AXIS_COUNT_OFFSET);
+    for (size_t i = 0; i < InputEventRecord::MAX_AXIS_COUNT; i++) {
+        record.axisValues[i] = GetDouble(data, AXIS_VALUES_OFFSET + i * sizeof(double));
+    }
+    return true;
+}
+
+bool InputEventFrame::IsValid(const InputEventRecord& record)
+{
+    if (record.type != TYPE_PRESS && record.type != TYPE_RELEASE && record.type != TYPE_MOVE &&
+        record.type != TYPE_POINT_EVENT) {
+        ELOG("InputEventFrame::IsValid unknown event type: %u", record.type);
+        return false;
+    }
+    // Same limits as the JSON commands, written so that NaN is rejected too.
+    if (!(record.x >= 0 && record.x <= VirtualScreenImpl::GetInstance().GetCurrentWidth())) {
+        ELOG("X coordinate range %d ~ %d", 0, VirtualScreenImpl::GetInstance().GetCurrentWidth());
+        return false;
+    }
+    if (!(record.y >= 0 && record.y <= VirtualScreenImpl::GetInstance().GetCurrentHeight())) {
+        ELOG("Y coordinate range %d ~ %d", 0, VirtualScreenImpl::GetInstance().GetCurrentHeight());
+        return false;
+    }
+    if (record.button < -1 || record.action < 0 || record.sourceType < 0 || record.sourceTool < 0) {
+        ELOG("action,sourceType,sourceTool must >= 0, button must >= -1");
+        return false;
+    }
+    if (record.axisCount > InputEventRecord::MAX_AXIS_COUNT) {
+        ELOG("axisCount must <= %zu", InputEventRecord::MAX_AXIS_COUNT);
+        return false;
+    }
+    return true;
+}
+
+bool InputEventFrame::Dispatch(const InputEventRecord& record)
+{
+    if (!IsValid(record)) {
+        return false;
+    }
+    if (CommandParser::GetInstance().GetScreenMode() == CommandParser::ScreenMode::STATIC) {
+        return false;
+    }
+    // Reused between events to keep the allocations of the containers.
+    static InputEventParams params;
+    params.pressedBtnsVec.clear();
+    for (uint32_t button = 0; button <= MAX_PRESSED_BUTTON; button++) {
+        if ((record.pressedButtons & (1u << button)) != 0) {
+            params.pressedBtnsVec.insert(static_cast<int>(button));
+        }
+    }
+    params.axisVec.assign(record.axisValues, record.axisValues + record.axisCount);
+    params.x = record.x;
+    params.y = record.y;
+    params.type = record.type;
+    params.button = record.button;
+    params.action = record.action;
+    params.sourceType = record.sourceType;
+    params.sourceTool = record.sourceTool;
+    params.name = "InputEventFrame";
+    InputCoalescer::GetInstance().Push(params);
+    return true;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INPUTEVENTFRAME_H
+#define INPUTEVENTFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Payload of a MessageFrame::TYPE_INPUT_EVENT frame. It carries the same values as the
+// MousePress/MouseRelease/MouseMove/PointEvent commands without any JSON in between.
+struct InputEventRecord {
+    static constexpr size_t MAX_AXIS_COUNT = 13;
+    uint16_t type; // one of InputEventFrame::EventType
+    uint16_t flags;
+    int32_t button;
+    int32_t action;
+    int32_t sourceType;
+    int32_t sourceTool;
+    uint32_t pressedButtons; // bit n is set while button n is pressed
+    double x;
+    double y;
+    uint32_t axisCount;
+    double axisValues[MAX_AXIS_COUNT];
+};
+
+namespace InputEventFrame {
+    // The touch types of the JSON commands, other values are rejected.
+    enum EventType : uint16_t { TYPE_PRESS = 0, TYPE_RELEASE = 1, TYPE_MOVE = 2, TYPE_POINT_EVENT = 9 };
+    constexpr uint16_t FLAG_REPLY = 0x1; // answer with a one byte frame, 1 if the event was dispatched
+    // Wire layout, every field in network byte order:
+    // type(2) flags(2) button(4) action(4) sourceType(4) sourceTool(4) pressedButtons(4)
+    // x(8) y(8) axisCount(4) reserved(4) axisValues(8 * 13)
+    constexpr size_t RECORD_SIZE = 152;
+
+    void Encode(const InputEventRecord& record, uint8_t (&buffer)[RECORD_SIZE]);
+    bool Decode(const uint8_t* data, size_t length, InputEventRecord& record);
+    bool IsValid(const InputEventRecord& record);
+    // Hands the event to the InputCoalescer, returns false if it is rejected.
+    bool Dispatch(const InputEventRecord& record);
+} // namespace InputEventFrame
+
+#endif // INPUTEVENTFRAME_H
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InspectorNotifier.h"
+
+#include <algorithm>
+
+#include "CppTimerManager.h"
+#include "PreviewerEngineLog.h"
+
+namespace {
+    constexpr int64_t MILLISECONDS_PER_SECOND = 1000;
+}
+
+InspectorNotifier::InspectorNotifier()
+    : refreshCallback(nullptr),
+      debounceTime(DEFAULT_DEBOUNCE_TIME),
+      maxRate(DEFAULT_MAX_RATE),
+      isPending(false),
+      refreshTimer(InspectorNotifier::OnRefreshTimer)
+{
+    CppTimerManager::GetTimerManager().AddCppTimer(refreshTimer);
+}
+
+InspectorNotifier::~InspectorNotifier() {}
+
+InspectorNotifier& InspectorNotifier::GetInstance()
+{
+    static InspectorNotifier instance;
+    return instance;
+}
+
+void InspectorNotifier::SetRefreshCallback(RefreshCallback callback)
+{
+    refreshCallback = callback;
+}
+
+void InspectorNotifier::OnFrameUpdated()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (!isPending) {
+        isPending = true;
+        pendingTime = now;
+    }
+    // Every frame pushes the refresh back by the debounce time, but a running animation must
+    // not hold it back for longer than one interval of the max rate.
+    int64_t minInterval = GetMinInterval();
+    auto dueTime = std::min(now + std::chrono::milliseconds(debounceTime),
+        pendingTime + std::chrono::milliseconds(std::max(debounceTime, minInterval)));
+    dueTime = std::max(dueTime, lastRefreshTime + std::chrono::milliseconds(minInterval));
+    int64_t delay = std::chrono::duration_cast<std::chrono::milliseconds>(dueTime - now).count();
+    refreshTimer.Start(std::max<int64_t>(delay, 1)); // a zero interval never fires
+}
+
+bool InspectorNotifier::SetDebounceTime(int64_t time)
+{
+    if (time < 0 || time > MAX_DEBOUNCE_TIME) {
+        ELOG("Invalid inspector debounce time: %lld", static_cast<long long>(time));
+        return false;
+    }
+    debounceTime = time;
+    return true;
+}
+
+bool InspectorNotifier::SetMaxRate(uint32_t rate)
+{
+    if (rate == 0 || rate > MAX_RATE) {
+        ELOG("Invalid inspector max rate: %u", rate);
+        return false;
+    }
+    maxRate = rate;
+    return true;
+}
+
+int64_t InspectorNotifier::GetMinInterval() const
+{
+    return MILLISECONDS_PER_SECOND / maxRate;
+}
+
+void InspectorNotifier::OnRefreshTimer()
+{
+    InspectorNotifier& notifier = InspectorNotifier::GetInstance();
+    notifier.refreshTimer.Stop();
+    notifier.isPending = false;
+    notifier.lastRefreshTime = std::chrono::steady_clock::now();
+    if (notifier.refreshCallback != nullptr) {
+        notifier.refreshCallback();
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INSPECTORNOTIFIER_H
+#define INSPECTORNOTIFIER_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "CppTimer.h"
+
+// Schedules the inspector tree refresh from rendered frames instead of a fixed period. The
+// refresh runs once frames have been quiet for the debounce time; while frames keep coming
+// it still runs, but never more than maxRate times per second. Command thread only.
+class InspectorNotifier {
+public:
+    using RefreshCallback = void (*)();
+
+    InspectorNotifier(const InspectorNotifier&) = delete;
+    InspectorNotifier& operator=(const InspectorNotifier&) = delete;
+    static InspectorNotifier& GetInstance();
+
+    void SetRefreshCallback(RefreshCallback callback);
+    void OnFrameUpdated();
+    bool SetDebounceTime(int64_t time);
+    bool SetMaxRate(uint32_t rate);
+
+    inline int64_t GetDebounceTime() const
+    {
+        return debounceTime;
+    }
+
+    inline uint32_t GetMaxRate() const
+    {
+        return maxRate;
+    }
+
+    static constexpr int64_t DEFAULT_DEBOUNCE_TIME = 100; // Unit millisecond
+    static constexpr int64_t MAX_DEBOUNCE_TIME = 5000; // Unit millisecond
+    static constexpr uint32_t DEFAULT_MAX_RATE = 2;
+    static constexpr uint32_t MAX_RATE = 60;
+
+private:
+    InspectorNotifier();
+    ~InspectorNotifier();
+    int64_t GetMinInterval() const;
+    static void OnRefreshTimer();
+
+    RefreshCallback refreshCallback;
+    int64_t debounceTime;
+    uint32_t maxRate;
+    bool isPending;
+    std::chrono::steady_clock::time_point pendingTime;
+    std::chrono::steady_clock::time_point lastRefreshTime;
+    CppTimer refreshTimer;
+};
+
+#endif // INSPECTORNOTIFIER_H
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InspectorTreeTracker.h"
+
+#include <functional>
+
+#include "CommandLineInterface.h"
+#include "JsonDiff.h"
+#include "PreviewerEngineLog.h"
+
+InspectorTreeTracker::InspectorTreeTracker()
+    : baselineHash(std::hash<std::string>()(std::string())), baselineSize(0), treeVersion(0), incremental(false)
+{
+}
+
+InspectorTreeTracker& InspectorTreeTracker::GetInstance()
+{
+    static InspectorTreeTracker instance;
+    return instance;
+}
+
+void InspectorTreeTracker::SetIncremental(bool enable)
+{
+    incremental = enable;
+    if (!enable) {
+        baseline.clear();
+    }
+}
+
+bool InspectorTreeTracker::IsIncremental() const
+{
+    return incremental;
+}
+
+uint32_t InspectorTreeTracker::GetTreeVersion() const
+{
+    return treeVersion;
+}
+
+bool InspectorTreeTracker::Update(const std::string& jsonTree, Json2::Value& notification)
+{
+    size_t hash = std::hash<std::string>()(jsonTree);
+    if (IsBaseline(jsonTree, hash)) {
+        return false;
+    }
+    uint32_t baseVersion = treeVersion;
+    treeVersion++;
+    notification.Add("version", CommandLineInterface::COMMAND_VERSION.c_str());
+    Json2::Value patch = JsonReader::CreateArray();
+    if (incremental && !baseline.empty() && BuildPatch(jsonTree, patch)) {
+        notification.Add("command", "inspectorPatch");
+        notification.Add("baseVersion", baseVersion);
+        notification.Add("treeVersion", treeVersion);
+        notification.Add("result", patch);
+    } else {
+        notification.Add("command", "inspector");
+        if (incremental) {
+            notification.Add("treeVersion", treeVersion);
+        }
+        notification.Add("result", jsonTree.c_str());
+    }
+    SetBaseline(jsonTree, hash);
+    return true;
+}
+
+void InspectorTreeTracker::Resync(const std::string& jsonTree, int64_t clientVersion, Json2::Value& snapshot)
+{
+    size_t hash = std::hash<std::string>()(jsonTree);
+    bool isChanged = !IsBaseline(jsonTree, hash);
+    bool isSynchronized = !isChanged && clientVersion == static_cast<int64_t>(treeVersion);
+    if (isChanged) {
+        treeVersion++;
+    }
+    // Stored even if unchanged, the tree itself is not kept until incremental mode is enabled.
+    SetBaseline(jsonTree, hash);
+    snapshot.Add("treeVersion", treeVersion);
+    if (!isSynchronized) {
+        snapshot.Add("tree", jsonTree.c_str());
+    }
+    ILOG("Inspector tree resync, client version: %lld, tree version: %u.",
+        static_cast<long long>(clientVersion), treeVersion);
+}
+
+bool InspectorTreeTracker::IsBaseline(const std::string& jsonTree, size_t hash) const
+{
+    return jsonTree.size() == baselineSize && hash == baselineHash;
+}
+
+void InspectorTreeTracker::SetBaseline(const std::string& jsonTree, size_t hash)
+{
+    baselineHash = hash;
+    baselineSize = jsonTree.size();
+    if (incremental) {
+        baseline = jsonTree;
+    }
+}
+
+bool InspectorTreeTracker::BuildPatch(const std::string& jsonTree, Json2::Value& patch) const
+{
+    Json2::Value from = JsonReader::ParseJsonData2(baseline);
+    Json2::Value to = JsonReader::ParseJsonData2(jsonTree);
+    if (!from.IsValid() || !to.IsValid() || !JsonDiff::Diff(from, to, patch)) {
+        return false;
+    }
+    // A patch that is not smaller than the tree itself is not worth the work on the IDE side.
+    return patch.ToString().size() < jsonTree.size();
+}
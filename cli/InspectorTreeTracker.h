@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INSPECTORTREETRACKER_H
+#define INSPECTORTREETRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "JsonReader.h"
+
+// Keeps track of the inspector tree last sent to the IDE and numbers every change of it. Changes
+// are detected by hash, the tree itself is only kept in incremental mode where a change is sent
+// as a JSON patch against the previous version. The IDE asks for a full snapshot when it has no
+// baseline or its version does not match. Command thread only.
+class InspectorTreeTracker {
+public:
+    InspectorTreeTracker(const InspectorTreeTracker&) = delete;
+    InspectorTreeTracker& operator=(const InspectorTreeTracker&) = delete;
+    static InspectorTreeTracker& GetInstance();
+
+    void SetIncremental(bool enable);
+    bool IsIncremental() const;
+    uint32_t GetTreeVersion() const;
+    // Fills the notification for a new tree, returns false if the tree did not change.
+    bool Update(const std::string& jsonTree, Json2::Value& notification);
+    // Makes jsonTree the baseline and fills the snapshot. The tree is left out if the
+    // client is already at the current version, clientVersion < 0 forces it.
+    void Resync(const std::string& jsonTree, int64_t clientVersion, Json2::Value& snapshot);
+
+private:
+    InspectorTreeTracker();
+    ~InspectorTreeTracker() {}
+    bool IsBaseline(const std::string& jsonTree, size_t hash) const;
+    void SetBaseline(const std::string& jsonTree, size_t hash);
+    bool BuildPatch(const std::string& jsonTree, Json2::Value& patch) const;
+
+    std::string baseline; // empty unless incremental
+    size_t baselineHash;
+    size_t baselineSize;
+    uint32_t treeVersion;
+    bool incremental;
+};
+
+#endif // INSPECTORTREETRACKER_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerfStatsPublisher.h"
+
+#include "CommandLineInterface.h"
+#include "CppTimerManager.h"
+#include "PreviewerEngineLog.h"
+
+PerfStatsPublisher::PerfStatsPublisher()
+    : isSubscribed(false),
+      interval(DEFAULT_INTERVAL),
+      publishTimer(PerfStatsPublisher::OnPublishTimer)
+{
+    CppTimerManager::GetTimerManager().AddCppTimer(publishTimer);
+}
+
+PerfStatsPublisher::~PerfStatsPublisher() {}
+
+PerfStatsPublisher& PerfStatsPublisher::GetInstance()
+{
+    static PerfStatsPublisher instance;
+    return instance;
+}
+
+bool PerfStatsPublisher::Subscribe(int64_t time)
+{
+    if (time < MIN_INTERVAL || time > MAX_INTERVAL) {
+        ELOG("Invalid perf stats interval: %lld", static_cast<long long>(time));
+        return false;
+    }
+    interval = time;
+    if (!isSubscribed) {
+        SampleGauges();
+        lastSnapshot = PerfStats::GetInstance().TakeSnapshot();
+        isSubscribed = true;
+    }
+    publishTimer.Start(interval);
+    return true;
+}
+
+void PerfStatsPublisher::Unsubscribe()
+{
+    publishTimer.Stop();
+    isSubscribed = false;
+    lastSnapshot = PerfStats::Snapshot();
+}
+
+void PerfStatsPublisher::SampleGauges()
+{
+    int64_t pendingBytes = CommandLineInterface::GetInstance().GetPendingWriteBytes();
+    if (pendingBytes >= 0) {
+        PerfStats::GetInstance().GetGauge(PerfMetric::SOCKET_QUEUE_BYTES).Set(pendingBytes);
+    }
+}
+
+void PerfStatsPublisher::OnPublishTimer()
+{
+    PerfStatsPublisher& publisher = PerfStatsPublisher::GetInstance();
+    if (!publisher.isSubscribed) {
+        return;
+    }
+    SampleGauges();
+    PerfStats::Snapshot snapshot = PerfStats::GetInstance().TakeSnapshot();
+    Json2::Value delta = JsonReader::CreateObject();
+    PerfStats::GetInstance().ToJson(snapshot, &publisher.lastSnapshot, delta);
+    publisher.lastSnapshot = std::move(snapshot);
+    Json2::Value message = JsonReader::CreateObject();
+    message.Add("version", CommandLineInterface::COMMAND_VERSION.c_str());
+    message.Add("property", "perfStats");
+    message.Add("result", delta);
+    CommandLineInterface::SendJsonData(message);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PERFSTATSPUBLISHER_H
+#define PERFSTATSPUBLISHER_H
+
+#include <cstdint>
+
+#include "CppTimer.h"
+#include "PerfStats.h"
+
+// Pushes what the PerfStats metrics changed by to the IDE once per interval while
+// subscribed. Command thread only.
+class PerfStatsPublisher {
+public:
+    PerfStatsPublisher(const PerfStatsPublisher&) = delete;
+    PerfStatsPublisher& operator=(const PerfStatsPublisher&) = delete;
+    static PerfStatsPublisher& GetInstance();
+
+    bool Subscribe(int64_t interval);
+    void Unsubscribe();
+    // Refreshes the gauges that are read on demand rather than recorded.
+    static void SampleGauges();
+
+    inline bool IsSubscribed() const
+    {
+        return isSubscribed;
+    }
+
+    inline int64_t GetInterval() const
+    {
+        return interval;
+    }
+
+    static constexpr int64_t DEFAULT_INTERVAL = 1000; // Unit millisecond
+    static constexpr int64_t MIN_INTERVAL = 100; // Unit millisecond
+    static constexpr int64_t MAX_INTERVAL = 60000; // Unit millisecond
+
+private:
+    PerfStatsPublisher();
+    ~PerfStatsPublisher();
+    static void OnPublishTimer();
+
+    bool isSubscribed;
+    int64_t interval;
+    PerfStats::Snapshot lastSnapshot;
+    CppTimer publishTimer;
+};
+
+#endif // PERFSTATSPUBLISHER_H
@@ -193,4 +193,8 @@ const AvoidAreas JsApp::GetCurrentAvoidArea() const
     return areas;
 }
 
+void JsApp::BeginSettingsBatch() {}
+
+void JsApp::EndSettingsBatch() {}
+
 void JsApp::InitJsApp() {}
\ No newline at end of file
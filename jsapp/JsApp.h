@@ -136,6 +136,9 @@ public:
         int32_t currentWidth, int32_t currentHeight);
     virtual void SetAvoidArea(const AvoidAreas& areas);
     virtual const AvoidAreas GetCurrentAvoidArea() const;
+    // Settings changed in between reach the engine together at the end, as one relayout.
+    virtual void BeginSettingsBatch();
+    virtual void EndSettingsBatch();
     virtual void InitJsApp();
 protected:
     JsApp();
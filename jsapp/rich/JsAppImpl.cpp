@@ -20,6 +20,7 @@
 #include "JsonReader.h"
 #include "PreviewerEngineLog.h"
 #include "SharedData.h"
+#include "TraceEvent.h"
 #include "TraceTool.h"
 #include "VirtualScreenImpl.h"
 #include "external/EventHandler.h"
@@ -140,6 +141,15 @@ void JsAppImpl::OrientationChanged(std::string commandOrientation)
     orientation = commandOrientation;
     ILOG("OrientationChanged: %s %d %d %f", orientation.c_str(), aceRunArgs.deviceWidth,
          aceRunArgs.deviceHeight, aceRunArgs.deviceConfig.density);
+    if (isSettingsBatch) {
+        isOrientationPending = true;
+        return;
+    }
+    ApplyOrientation();
+}
+
+void JsAppImpl::ApplyOrientation()
+{
     if (ability != nullptr) {
         OHOS::AppExecFwk::EventHandler::PostTask([this]() {
             glfwRenderContext->SetWindowSize(width, height);
@@ -157,11 +167,39 @@ void JsAppImpl::ColorModeChanged(const std::string commandColorMode)
         aceRunArgs.deviceConfig.colorMode = ColorMode::DARK;
     }
 
+    if (isSettingsBatch) {
+        isConfigurationPending = true;
+        return;
+    }
     if (ability != nullptr) {
         ability->OnConfigurationChanged(aceRunArgs.deviceConfig);
     }
 }
 
+void JsAppImpl::BeginSettingsBatch()
+{
+    isSettingsBatch = true;
+}
+
+void JsAppImpl::EndSettingsBatch()
+{
+    isSettingsBatch = false;
+    // The configuration goes first, so that the one relayout below already uses it.
+    if (isConfigurationPending && ability != nullptr) {
+        ability->OnConfigurationChanged(aceRunArgs.deviceConfig);
+    }
+    // The resolution carries the orientation as well.
+    if (isResolutionPending) {
+        ApplyResolution(pendingResizeReason);
+    } else if (isOrientationPending) {
+        ApplyOrientation();
+    }
+    isConfigurationPending = false;
+    isResolutionPending = false;
+    isOrientationPending = false;
+    pendingResizeReason.clear();
+}
+
 void JsAppImpl::Interrupt()
 {
     isStop = true;
@@ -645,6 +683,16 @@ void JsAppImpl::ResolutionChanged(ResolutionParam& param, int32_t screenDensity,
 {
     SetResolutionParams(param.orignalWidth, param.orignalHeight, param.compressionWidth,
         param.compressionHeight, screenDensity);
+    if (isSettingsBatch) {
+        isResolutionPending = true;
+        pendingResizeReason = reason;
+        return;
+    }
+    ApplyResolution(reason);
+}
+
+void JsAppImpl::ApplyResolution(const std::string& reason)
+{
     if (isDebug && debugServerPort >= 0) {
 #if defined(__APPLE__) || defined(_WIN32)
         SetWindowParams();
@@ -858,9 +906,13 @@ void JsAppImpl::LoadDocument(const std::string filePath,
                              const std::string componentName,
                              const Json2::Value& previewContext)
 {
+    TRACE_EVENT_SCOPE("LoadDocument");
     ILOG("LoadDocument.");
     OHOS::Ace::Platform::SystemParams params;
-    SetSystemParams(params, previewContext);
+    {
+        TRACE_EVENT_SCOPE("LoadDocument.SetSystemParams");
+        SetSystemParams(params, previewContext);
+    }
     ILOG("LoadDocument params is density: %f region: %s language: %s deviceWidth: %d\
          deviceHeight: %d isRound:%d colorMode:%s orientation: %s deviceType: %s",
          params.density,
@@ -876,6 +928,7 @@ void JsAppImpl::LoadDocument(const std::string filePath,
         glfwRenderContext->SetWindowSize(aceRunArgs.deviceWidth, aceRunArgs.deviceHeight);
     });
 
+    TRACE_EVENT_SCOPE("LoadDocument.UIContent");
     if (ability != nullptr) {
         ability->LoadDocument(filePath, componentName, params);
     } else {
@@ -905,6 +958,7 @@ void JsAppImpl::DispatchKeyEvent(const std::shared_ptr<OHOS::MMI::KeyEvent>& key
 }
 void JsAppImpl::DispatchPointerEvent(const std::shared_ptr<OHOS::MMI::PointerEvent>& pointerEvent) const
 {
+    TRACE_EVENT_SCOPE("DispatchPointerEvent");
     if (isDebug && debugServerPort >= 0) {
 #if defined(__APPLE__) || defined(_WIN32)
         OHOS::Rosen::Window* window = OHOS::Previewer::PreviewerWindow::GetInstance().GetWindowObject();
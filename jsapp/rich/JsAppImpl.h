@@ -84,6 +84,8 @@ public:
     void FoldStatusChanged(const std::string commandFoldStatus,
         int32_t currentWidth, int32_t currentHeight) override;
     void SetAvoidArea(const AvoidAreas& areas) override;
+    void BeginSettingsBatch() override;
+    void EndSettingsBatch() override;
     void UpdateAvoidArea2Ide(const std::string& key, const OHOS::Rosen::Rect& value);
     OHOS::Rosen::Window* GetWindow() const;
 
@@ -152,6 +154,8 @@ private:
     void SetDeviceScreenDensity(const int32_t screenDensity, const std::string type);
     std::string GetDeviceTypeName(const OHOS::Ace::DeviceType) const;
     OHOS::Rosen::FoldStatus ConvertFoldStatus(std::string value) const;
+    void ApplyOrientation();
+    void ApplyResolution(const std::string& reason);
     const double BASE_SCREEN_DENSITY = 160; // Device Baseline Screen Density
     std::unique_ptr<OHOS::Ace::Platform::AceAbility> ability;
     std::atomic<bool> isStop;
@@ -160,6 +164,11 @@ private:
     int32_t orignalWidth = 0;
     int32_t orignalHeight = 0;
     AvoidAreas avoidInitialAreas;
+    bool isSettingsBatch = false;
+    bool isOrientationPending = false; // changed in the batch, not handed to the engine yet
+    bool isResolutionPending = false;
+    bool isConfigurationPending = false;
+    std::string pendingResizeReason;
     OHOS::Ace::Platform::AceRunArgs aceRunArgs;
     std::shared_ptr<OHOS::Rosen::GlfwRenderContext> glfwRenderContext;
 #ifdef COMPONENT_TEST_ENABLED
@@ -17,14 +17,231 @@
 #include <fstream>
 #include <cctype>
 #include <algorithm>
+#include <set>
 #include "JsonReader.h"
+#include "JsonStreamReader.h"
 #include "FileSystem.h"
+#include "MemoryStats.h"
 #include "TraceTool.h"
 #include "PreviewerEngineLog.h"
 #include "CommandParser.h"
 #include "zlib.h"
 #include "contrib/minizip/unzip.h"
 
+namespace {
+using StringMap = std::map<std::string, std::string>;
+
+bool IsString(const JsonStreamValue& value)
+{
+    return value.type == JsonStreamValue::Type::STRING;
+}
+
+// Collects the members of loader.json the previewer needs. A repeated key counts once, as in a cJSON lookup.
+class LoaderJsonHandler : public JsonStreamHandler {
+public:
+    JsonStreamAction OnContainerStart(const JsonStreamPath& path, bool isArray) override
+    {
+        if (path.empty()) {
+            return isArray ? JsonStreamAction::SKIP : JsonStreamAction::CONTINUE;
+        }
+        if (path.size() == 1 && AddMember(path[0].key, false) && !isArray && GetMap(path[0].key) != nullptr) {
+            return JsonStreamAction::CONTINUE;
+        }
+        return JsonStreamAction::SKIP;
+    }
+
+    JsonStreamAction OnContainerEnd(const JsonStreamPath&, bool) override
+    {
+        return JsonStreamAction::CONTINUE;
+    }
+
+    JsonStreamAction OnValue(const JsonStreamPath& path, const JsonStreamValue& value) override
+    {
+        if (path.size() == 1 && AddMember(path[0].key, value.type == JsonStreamValue::Type::NULL_VALUE) &&
+            IsString(value)) {
+            if (path[0].key == "projectRootPath") {
+                projectRootPath = value.string;
+            } else if (path[0].key == "buildConfigPath") {
+                buildConfigPath = value.string;
+            }
+        } else if (path.size() == 2 && IsString(value)) { // 2: a member of a map
+            GetMap(path[0].key)->emplace(path[1].key, value.string);
+        }
+        return JsonStreamAction::CONTINUE;
+    }
+
+    bool HasMember(const std::string& key) const
+    {
+        return members.count(key) > 0;
+    }
+
+    StringMap modulePathMap;
+    StringMap harNameOhmMap;
+    StringMap hspNameOhmMap;
+    StringMap hspResourcesMap;
+    std::optional<std::string> projectRootPath;
+    std::optional<std::string> buildConfigPath;
+    bool isHspNameOhmMapValid = false; // present and not null
+
+private:
+    bool AddMember(const std::string& key, bool isNull)
+    {
+        if (!members.insert(key).second) {
+            return false;
+        }
+        if (key == "hspNameOhmMap") {
+            isHspNameOhmMapValid = !isNull;
+        }
+        return true;
+    }
+
+    StringMap* GetMap(const std::string& key)
+    {
+        if (key == "modulePathMap") {
+            return &modulePathMap;
+        }
+        if (key == "harNameOhmMap") {
+            return &harNameOhmMap;
+        }
+        if (key == "hspNameOhmMap") {
+            return &hspNameOhmMap;
+        }
+        if (key == "hspResourcesMap") {
+            return &hspResourcesMap;
+        }
+        return nullptr;
+    }
+
+    std::set<std::string> members; // the keys at the root
+};
+
+// Collects the "source" of each module in mock-config.json.
+class MockJsonHandler : public JsonStreamHandler {
+public:
+    JsonStreamAction OnContainerStart(const JsonStreamPath& path, bool isArray) override
+    {
+        if (path.empty()) {
+            return isArray ? JsonStreamAction::SKIP : JsonStreamAction::CONTINUE;
+        }
+        if (path.size() == 1 && modules.insert(path[0].key).second && !isArray) {
+            hasSource = false;
+            return JsonStreamAction::CONTINUE;
+        }
+        return JsonStreamAction::SKIP;
+    }
+
+    JsonStreamAction OnContainerEnd(const JsonStreamPath&, bool) override
+    {
+        return JsonStreamAction::CONTINUE;
+    }
+
+    JsonStreamAction OnValue(const JsonStreamPath& path, const JsonStreamValue& value) override
+    {
+        if (path.size() == 1) {
+            modules.insert(path[0].key);
+        } else if (path.size() == 2 && path[1].key == "source" && !hasSource) { // 2: a member of a module
+            hasSource = true;
+            if (IsString(value)) {
+                mapInfo[path[0].key] = value.string;
+            }
+        }
+        return JsonStreamAction::CONTINUE;
+    }
+
+    StringMap mapInfo;
+
+private:
+    std::set<std::string> modules;
+    bool hasSource = false;
+};
+
+// Collects the items of the routerMap array.
+class RouterMapHandler : public JsonStreamHandler {
+public:
+    JsonStreamAction OnContainerStart(const JsonStreamPath& path, bool isArray) override
+    {
+        switch (path.size()) {
+            case 0: // the root
+                return isArray ? JsonStreamAction::SKIP : JsonStreamAction::CONTINUE;
+            case 1: // a member of the root
+                if (path[0].key == "routerMap" && !isFound) {
+                    isFound = true;
+                    isArrayFound = isArray;
+                    return isArray ? JsonStreamAction::CONTINUE : JsonStreamAction::SKIP;
+                }
+                return JsonStreamAction::SKIP;
+            case 2: // an item
+                if (isArray) {
+                    ELOG("Invalid router map item type");
+                    return JsonStreamAction::SKIP;
+                }
+                item = OHOS::Ide::RouterItem();
+                fields.clear();
+                return JsonStreamAction::CONTINUE;
+            case 3: // a field of an item
+                if (fields.insert(path[2].key).second && path[2].key == "data" && !isArray) {
+                    return JsonStreamAction::CONTINUE;
+                }
+                return JsonStreamAction::SKIP;
+            default:
+                return JsonStreamAction::SKIP;
+        }
+    }
+
+    JsonStreamAction OnContainerEnd(const JsonStreamPath& path, bool) override
+    {
+        if (path.size() == 2) { // 2: an item
+            items.push_back(std::move(item));
+        }
+        return JsonStreamAction::CONTINUE;
+    }
+
+    JsonStreamAction OnValue(const JsonStreamPath& path, const JsonStreamValue& value) override
+    {
+        if (path.size() == 1 && path[0].key == "routerMap") {
+            isFound = true;
+        } else if (path.size() == 2) { // 2: an item
+            ELOG("Invalid router map item type");
+        } else if (path.size() == 3 && fields.insert(path[2].key).second && IsString(value)) { // 3: a field
+            SetField(path[2].key, value.string);
+        } else if (path.size() == 4 && IsString(value)) { // 4: a member of the data of an item
+            item.data.emplace(path[3].key, value.string);
+        }
+        return JsonStreamAction::CONTINUE;
+    }
+
+    bool IsArrayFound() const
+    {
+        return isArrayFound;
+    }
+
+    std::vector<OHOS::Ide::RouterItem> items;
+
+private:
+    void SetField(const std::string& key, const std::string& text)
+    {
+        if (key == "name") {
+            item.name = text;
+        } else if (key == "pageSourceFile") {
+            item.pageSourceFile = text;
+        } else if (key == "buildFunction") {
+            item.buildFunction = text;
+        } else if (key == "ohmurl") {
+            item.ohmurl = text;
+        } else if (key == "bundleName") {
+            item.bundleName = text;
+        } else if (key == "moduleName") {
+            item.moduleName = text;
+        }
+    }
+
+    OHOS::Ide::RouterItem item;
+    std::set<std::string> fields; // the fields of the item, the first of a repeated one counts
+    bool isFound = false;
+    bool isArrayFound = false;
+};
+}
+
 namespace OHOS::Ide {
 StageContext& StageContext::GetInstance()
 {
@@ -75,46 +292,36 @@ void StageContext::GetModulePathMapFromLoaderJson()
         ELOG("the loaderJsonPath is not exist.");
         return;
     }
-    std::string jsonStr = JsonReader::ReadFile(loaderJsonPath);
-    Json2::Value rootJson = JsonReader::ParseJsonData2(jsonStr);
-    if (rootJson.IsNull() || !rootJson.IsValid()) {
+    // loader.json of a large project lists every module, it is read as a stream instead of a tree.
+    LoaderJsonHandler loader;
+    if (!JsonStreamReader::ParseFile(loaderJsonPath, loader)) {
         ELOG("Get loader.json content failed.");
         return;
     }
-    if (!rootJson.IsMember("modulePathMap") || !rootJson.IsMember("harNameOhmMap") ||
-        !rootJson.IsMember("projectRootPath") || !rootJson.IsMember("hspResourcesMap")) {
+    if (!loader.HasMember("modulePathMap") || !loader.HasMember("harNameOhmMap") ||
+        !loader.HasMember("projectRootPath") || !loader.HasMember("hspResourcesMap")) {
         ELOG("Don't find some necessary node in loader.json.");
         return;
     }
-    Json2::Value jsonObj = rootJson["modulePathMap"];
-    for (const auto& key : jsonObj.GetMemberNames()) {
-        if (jsonObj[key].IsString()) {
-            modulePathMap[key] = jsonObj[key].AsString();
-        }
+    for (const auto& item : loader.modulePathMap) {
+        modulePathMap[item.first] = item.second;
     }
-    Json2::Value jsonObjOhm = rootJson["harNameOhmMap"];
-    if (rootJson.IsMember("hspNameOhmMap")) {
-        if (!rootJson["hspNameOhmMap"].IsNull() && rootJson["hspNameOhmMap"].IsValid()) {
-            ILOG("hspNameOhmMap is valid");
-            jsonObjOhm = rootJson["hspNameOhmMap"];
-        }
+    const StringMap* ohmMap = &loader.harNameOhmMap;
+    if (loader.isHspNameOhmMapValid) {
+        ILOG("hspNameOhmMap is valid");
+        ohmMap = &loader.hspNameOhmMap;
     }
-    for (const auto& key : jsonObjOhm.GetMemberNames()) {
-        if (jsonObjOhm[key].IsString()) {
-            hspNameOhmMap[key] = jsonObjOhm[key].AsString();
-        }
+    for (const auto& item : *ohmMap) {
+        hspNameOhmMap[item.first] = item.second;
     }
-    if (rootJson["projectRootPath"].IsString()) {
-        projectRootPath = rootJson["projectRootPath"].AsString();
+    if (loader.projectRootPath.has_value()) {
+        projectRootPath = loader.projectRootPath.value();
     }
-    if (rootJson.IsMember("buildConfigPath") && rootJson["buildConfigPath"].IsString()) {
-        buildConfigPath = rootJson["buildConfigPath"].AsString();
+    if (loader.buildConfigPath.has_value()) {
+        buildConfigPath = loader.buildConfigPath.value();
     }
-    Json2::Value jsonObjResources = rootJson["hspResourcesMap"];
-    for (const auto& key : jsonObjResources.GetMemberNames()) {
-        if (jsonObjResources[key].IsString()) {
-            hspResourcesMap[key] = jsonObjResources[key].AsString();
-        }
+    for (const auto& item : loader.hspResourcesMap) {
+        hspResourcesMap[item.first] = item.second;
     }
 }
 
@@ -141,6 +348,7 @@ void StageContext::ReleaseHspBuffers()
 {
     for (std::vector<uint8_t>* ptr : hspBufferPtrsVec) {
         if (ptr) {
+            MemoryStats::GetInstance().Release(MemoryTag::HSP_BUFFER, ptr->capacity());
             delete ptr;
         }
     }
@@ -241,6 +449,8 @@ std::vector<uint8_t>* StageContext::GetLocalModuleBuffer(const std::string& modu
     std::vector<uint8_t> *buf = new(std::nothrow) std::vector<uint8_t>(opt.value());
     if (!buf) {
         ELOG("Memory allocation failed: buf.");
+    } else {
+        MemoryStats::GetInstance().Allocate(MemoryTag::HSP_BUFFER, buf->capacity());
     }
     hspBufferPtrsVec.push_back(buf);
     return buf;
@@ -428,6 +638,7 @@ std::vector<uint8_t>* StageContext::GetModuleBufferFromHsp(const std::string& hs
     while ((bytesRead = unzReadCurrentFile(zipfile, buffer, sizeof(buffer))) > 0) {
         fileContent->insert(fileContent->end(), buffer, buffer + bytesRead);
     }
+    MemoryStats::GetInstance().Allocate(MemoryTag::HSP_BUFFER, fileContent->capacity());
     hspBufferPtrsVec.push_back(fileContent);
     unzCloseCurrentFile(zipfile);
     unzClose(zipfile);
@@ -449,18 +660,12 @@ std::map<std::string, std::string> StageContext::ParseMockJsonFile(const std::st
         ELOG("the mockJsonFilePath:%s is not exist.", mockJsonFilePath.c_str());
         return mapInfo;
     }
-    std::string jsonStr = JsonReader::ReadFile(mockJsonFilePath);
-    Json2::Value rootJson = JsonReader::ParseJsonData2(jsonStr);
-    if (rootJson.IsNull() || !rootJson.IsValid()) {
+    MockJsonHandler mock;
+    if (!JsonStreamReader::ParseFile(mockJsonFilePath, mock)) {
         ELOG("get mock-config.json content failed.");
         return mapInfo;
     }
-    for (const auto& key : rootJson.GetMemberNames()) {
-        if (!rootJson[key].IsNull() && rootJson[key].IsMember("source") && rootJson[key]["source"].IsString()) {
-            mapInfo[key] = rootJson[key]["source"].AsString();
-        }
-    }
-    return mapInfo;
+    return mock.mapInfo;
 }
 
 int StageContext::GetUpwardDirIndex(const std::string& path, const int upwardLevel) const
@@ -790,54 +995,15 @@ std::vector<RouterItem> StageContext::GetRouterMap(const std::string& inputPath)
         return routerItems;
     }
 
-    std::string jsonStr = JsonReader::ReadFile(inputPath);
-    Json2::Value rootJson = JsonReader::ParseJsonData2(jsonStr);
-    if (rootJson.IsNull() || !rootJson.IsValid()) {
+    RouterMapHandler routerMap;
+    if (!JsonStreamReader::ParseFile(inputPath, routerMap)) {
         ELOG("Get router map content failed.");
         return routerItems;
     }
-    // 获取routerMap数组
-    if (!rootJson.IsMember("routerMap") || !rootJson["routerMap"].IsArray()) {
+    if (!routerMap.IsArrayFound()) {
         ELOG("Don't find some necessary node in loader.json.");
         return routerItems;
     }
-    Json2::Value jsonObj = rootJson["routerMap"];
-    int arraySize = rootJson["routerMap"].GetArraySize();
-    for (int i = 0; i < arraySize; i++) {
-        Json2::Value item = jsonObj.GetArrayItem(i);
-        if (!item.IsObject()) {
-            ELOG("Invalid router map item type");
-            continue;
-        }
-        RouterItem routerItem;
-        if (item.IsMember("name") && item["name"].IsString()) {
-            routerItem.name = item["name"].AsString();
-        }
-        if (item.IsMember("pageSourceFile") && item["pageSourceFile"].IsString()) {
-            routerItem.pageSourceFile = item["pageSourceFile"].AsString();
-        }
-        if (item.IsMember("buildFunction") && item["buildFunction"].IsString()) {
-            routerItem.buildFunction = item["buildFunction"].AsString();
-        }
-        if (item.IsMember("ohmurl") && item["ohmurl"].IsString()) {
-            routerItem.ohmurl = item["ohmurl"].AsString();
-        }
-        if (item.IsMember("bundleName") && item["bundleName"].IsString()) {
-            routerItem.bundleName = item["bundleName"].AsString();
-        }
-        if (item.IsMember("moduleName") && item["moduleName"].IsString()) {
-            routerItem.moduleName = item["moduleName"].AsString();
-        }
-        if (item.IsMember("data") && item["data"].IsObject()) {
-            Json2::Value dataOjb = item["data"];
-            for (const auto& key : dataOjb.GetMemberNames()) {
-                if (dataOjb[key].IsString()) {
-                    routerItem.data[key] = dataOjb[key].AsString();
-                }
-            }
-        }
-        routerItems.push_back(routerItem);
-    }
-    return routerItems;
+    return std::move(routerMap.items);
+}
 }
-}
\ No newline at end of file
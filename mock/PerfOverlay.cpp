@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerfOverlay.h"
+
+#include <algorithm>
+
+namespace {
+    constexpr int32_t GLYPH_ROWS = 7;
+    constexpr int64_t TENTHS = 10;
+    constexpr int64_t MICROSECONDS_PER_TENTH_MILLISECOND = 100;
+    constexpr int64_t TENTHS_PER_SECOND = 10000; // fps in tenths from frames per ms
+    constexpr uint8_t TEXT_COLOR = 0xFF;
+
+    struct Glyph {
+        char code;
+        uint8_t rows[GLYPH_ROWS]; // bit 4 is the leftmost column
+    };
+
+    // 5x7 glyphs of the characters the overlay prints.
+    const Glyph GLYPHS[] = {
+        { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+        { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+        { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+        { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+        { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+        { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+        { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+        { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+        { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+        { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+        { '.', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } },
+        { 'A', { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+        { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+        { 'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+        { 'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+        { 'F', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+        { 'L', { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F } },
+        { 'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+        { 'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+        { 'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+        { 'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+        { 'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+        { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+        { 'T', { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+    };
+}
+
+std::atomic<bool> PerfOverlay::isEnabled(false);
+
+PerfOverlay::PerfOverlay()
+    : isResetPending(true), fpsTenths(0), encodeTime(0), sendLatency(0), droppedCount(0), windowFrames(0)
+{
+}
+
+PerfOverlay& PerfOverlay::GetInstance()
+{
+    static PerfOverlay instance;
+    return instance;
+}
+
+void PerfOverlay::SetEnabled(bool enabled)
+{
+    if (enabled && !isEnabled.load(std::memory_order_relaxed)) {
+        isResetPending.store(true, std::memory_order_relaxed);
+    }
+    isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void PerfOverlay::OnFrameEncoded(int64_t time)
+{
+    ResetIfPending();
+    encodeTime.store(time, std::memory_order_relaxed);
+}
+
+void PerfOverlay::OnFrameSent(int64_t latency)
+{
+    ResetIfPending();
+    sendLatency.store(latency, std::memory_order_relaxed);
+    auto now = std::chrono::steady_clock::now();
+    windowFrames++;
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - windowStart).count();
+    if (elapsed >= FPS_WINDOW) {
+        fpsTenths.store(windowFrames * TENTHS_PER_SECOND / elapsed, std::memory_order_relaxed);
+        windowStart = now;
+        windowFrames = 0;
+    }
+}
+
+void PerfOverlay::OnFrameDropped()
+{
+    ResetIfPending();
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfOverlay::ResetIfPending()
+{
+    // The counts belong to the frame thread, so a reset asked for by SetEnabled is done here.
+    if (!isResetPending.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
+    fpsTenths.store(0, std::memory_order_relaxed);
+    encodeTime.store(0, std::memory_order_relaxed);
+    sendLatency.store(0, std::memory_order_relaxed);
+    droppedCount.store(0, std::memory_order_relaxed);
+    windowStart = std::chrono::steady_clock::now();
+    windowFrames = 0;
+}
+
+std::vector<std::string> PerfOverlay::GetLines() const
+{
+    return {
+        "FPS  " + FormatTenths(fpsTenths.load(std::memory_order_relaxed)),
+        "ENC  " + FormatTenths(encodeTime.load(std::memory_order_relaxed) / MICROSECONDS_PER_TENTH_MILLISECOND) + "MS",
+        "LAT  " + FormatTenths(sendLatency.load(std::memory_order_relaxed) / MICROSECONDS_PER_TENTH_MILLISECOND) + "MS",
+        "DROP " + std::to_string(droppedCount.load(std::memory_order_relaxed)),
+    };
+}
+
+void PerfOverlay::Draw(uint8_t* pixels, int32_t width, int32_t height, int32_t bytesPerPixel)
+{
+    if (pixels == nullptr || width <= 0 || height <= 0 || bytesPerPixel < 3) { // 3: R, G and B
+        return;
+    }
+    ResetIfPending();
+    std::vector<std::string> lines = GetLines();
+    size_t maxLength = 0;
+    for (const auto& line : lines) {
+        maxLength = std::max(maxLength, line.length());
+    }
+    int32_t scale = width >= LARGE_SCREEN_WIDTH ? 2 : 1; // 2: double size
+    int32_t advance = (GLYPH_WIDTH + GLYPH_SPACING) * scale;
+    int32_t lineHeight = (GLYPH_HEIGHT + LINE_SPACING) * scale;
+    int32_t boxRight = std::min(width, MARGIN + PADDING * 2 + static_cast<int32_t>(maxLength) * advance);
+    int32_t boxBottom = std::min(height, MARGIN + PADDING * 2 + static_cast<int32_t>(lines.size()) * lineHeight);
+    for (int32_t y = MARGIN; y < boxBottom; y++) {
+        uint8_t* pixel = pixels + (static_cast<int64_t>(y) * width + MARGIN) * bytesPerPixel;
+        for (int32_t x = MARGIN; x < boxRight; x++, pixel += bytesPerPixel) {
+            pixel[0] >>= DARKEN_SHIFT;
+            pixel[1] >>= DARKEN_SHIFT;
+            pixel[2] >>= DARKEN_SHIFT; // 2: the third color channel
+        }
+    }
+    for (size_t i = 0; i < lines.size(); i++) {
+        DrawText(pixels, width, height, bytesPerPixel, lines[i], MARGIN + PADDING,
+            MARGIN + PADDING + static_cast<int32_t>(i) * lineHeight, scale);
+    }
+}
+
+void PerfOverlay::DrawText(uint8_t* pixels, int32_t width, int32_t height, int32_t bytesPerPixel,
+    const std::string& text, int32_t x, int32_t y, int32_t scale) const
+{
+    for (char code : text) {
+        const uint8_t* glyph = GetGlyph(code);
+        for (int32_t row = 0; glyph != nullptr && row < GLYPH_HEIGHT * scale; row++) {
+            int32_t pixelY = y + row;
+            if (pixelY >= height) {
+                break;
+            }
+            for (int32_t column = 0; column < GLYPH_WIDTH * scale; column++) {
+                int32_t pixelX = x + column;
+                bool isSet = (glyph[row / scale] >> (GLYPH_WIDTH - 1 - column / scale)) & 1;
+                if (!isSet || pixelX >= width) {
+                    continue;
+                }
+                uint8_t* pixel = pixels + (static_cast<int64_t>(pixelY) * width + pixelX) * bytesPerPixel;
+                pixel[0] = TEXT_COLOR;
+                pixel[1] = TEXT_COLOR;
+                pixel[2] = TEXT_COLOR; // 2: the third color channel
+            }
+        }
+        x += (GLYPH_WIDTH + GLYPH_SPACING) * scale;
+    }
+}
+
+const uint8_t* PerfOverlay::GetGlyph(char code)
+{
+    for (const Glyph& glyph : GLYPHS) {
+        if (glyph.code == code) {
+            return glyph.rows;
+        }
+    }
+    return nullptr; // drawn as a space
+}
+
+std::string PerfOverlay::FormatTenths(int64_t value)
+{
+    value = std::max<int64_t>(value, 0);
+    return std::to_string(value / TENTHS) + "." + std::to_string(value % TENTHS);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame timing drawn into the top left corner of every frame before it is encoded.
+// Off by default; while off the frame path only pays for one relaxed load per check.
+class PerfOverlay {
+public:
+    static PerfOverlay& GetInstance();
+    static bool IsEnabled()
+    {
+        return isEnabled.load(std::memory_order_relaxed);
+    }
+    // Enabling starts the counts over. Any thread.
+    void SetEnabled(bool enabled);
+    // Frame thread only, called while enabled. Times are in us.
+    void OnFrameEncoded(int64_t encodeTime);
+    void OnFrameSent(int64_t sendLatency);
+    void OnFrameDropped();
+    // pixels start with the R, G and B bytes, in any order: the text is white on a darkened box.
+    void Draw(uint8_t* pixels, int32_t width, int32_t height, int32_t bytesPerPixel);
+    std::vector<std::string> GetLines() const;
+
+private:
+    PerfOverlay();
+    ~PerfOverlay() = default;
+    PerfOverlay& operator=(const PerfOverlay&) = delete;
+    PerfOverlay(const PerfOverlay&) = delete;
+
+    static constexpr int64_t FPS_WINDOW = 500; // ms over which the frame rate is averaged
+    static constexpr int32_t GLYPH_WIDTH = 5;
+    static constexpr int32_t GLYPH_HEIGHT = 7;
+    static constexpr int32_t GLYPH_SPACING = 1;
+    static constexpr int32_t LINE_SPACING = 2;
+    static constexpr int32_t PADDING = 3;
+    static constexpr int32_t MARGIN = 4;
+    static constexpr int32_t LARGE_SCREEN_WIDTH = 480; // wider frames draw the text twice as large
+    static constexpr int DARKEN_SHIFT = 2; // the box keeps a quarter of the brightness under it
+    static const uint8_t* GetGlyph(char code);
+    static std::string FormatTenths(int64_t value);
+    void ResetIfPending();
+    void DrawText(uint8_t* pixels, int32_t width, int32_t height, int32_t bytesPerPixel,
+        const std::string& text, int32_t x, int32_t y, int32_t scale) const;
+
+    static std::atomic<bool> isEnabled;
+    std::atomic<bool> isResetPending;
+    std::atomic<int64_t> fpsTenths;
+    std::atomic<int64_t> encodeTime;
+    std::atomic<int64_t> sendLatency;
+    std::atomic<uint64_t> droppedCount;
+    std::chrono::steady_clock::time_point windowStart; // frame thread only
+    uint32_t windowFrames;
+};
+
+#endif // PERFOVERLAY_H
@@ -16,7 +16,10 @@
 #include "VirtualScreen.h"
 #include "CommandParser.h"
 #include "CppTimerManager.h"
+#include "PerfOverlay.h"
+#include "PerfStats.h"
 #include "PreviewerEngineLog.h"
+#include "TraceEvent.h"
 #include "VirtualScreen.h"
 
 #define boolean jpegboolean
@@ -292,6 +295,8 @@ bool VirtualScreen::StopSendStaticCardImage(const int duration)
 
 void VirtualScreen::RgbToJpg(unsigned char* data, const int32_t width, const int32_t height)
 {
+    TRACE_EVENT_SCOPE("EncodeJpeg");
+    auto startTime = std::chrono::steady_clock::now();
     if (width < 1 || height < 1) {
         FLOG("VirtualScreenImpl::RgbToJpg the width or height is invalid value");
     }
@@ -315,6 +320,13 @@ void VirtualScreen::RgbToJpg(unsigned char* data, const int32_t width, const int
     }
     jpeg_finish_compress(&jpeg);
     jpeg_destroy_compress(&jpeg);
+    int64_t time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    static PerfHistogram& encodeTime = PerfStats::GetInstance().GetHistogram(PerfMetric::FRAME_ENCODE_TIME);
+    encodeTime.Record(static_cast<uint64_t>(time));
+    if (PerfOverlay::IsEnabled()) {
+        PerfOverlay::GetInstance().OnFrameEncoded(time);
+    }
 }
 
 void VirtualScreen::SetFoldable(const bool value)
@@ -24,8 +24,12 @@
 #undef boolean
 #include "task_manager.h"
 #include "CommandParser.h"
+#include "MemoryStats.h"
 #include "ModelManager.h"
+#include "PerfOverlay.h"
+#include "PerfStats.h"
 #include "PreviewerEngineLog.h"
+#include "TraceEvent.h"
 #include "TraceTool.h"
 
 void VirtualScreenImpl::InitAll(std::string pipeName, std::string pipePort)
@@ -62,6 +66,8 @@ void VirtualScreenImpl::InitAll(std::string pipeName, std::string pipePort)
         ELOG("Memory allocation failed: osBuffer.");
         return;
     }
+    // wholeBuffer, regionWholeBuffer and osBuffer
+    MemoryStats::GetInstance().SetBuffer(MemoryTag::SCREEN_BUFFER, (LWS_PRE + bufferSize) * 2 + bufferSize);
     if (screenBuffer == nullptr) {
         ELOG("VirtualScreen::InitAll wholeBuffer memory allocation failed");
         return;
@@ -145,6 +151,7 @@ void VirtualScreenImpl::ScheduleBufferSend()
                 ELOG("Memory allocation failed: firstImageBuffer.");
                 return;
             }
+            MemoryStats::GetInstance().SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, LWS_PRE + bufferSize);
             WebSocketServer::GetInstance().firstImagebufferSize = headSize + jpgBufferSize;
         }
         std::copy(regionBuffer,
@@ -153,6 +160,15 @@ void VirtualScreenImpl::ScheduleBufferSend()
     }
 
     sendFrameCountPerMinute++;
+    static PerfCounter& sentFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_SENT);
+    sentFrames.Add();
+    int64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - frameReadyTime).count();
+    static PerfHistogram& frameLatency = PerfStats::GetInstance().GetHistogram(PerfMetric::FRAME_LATENCY);
+    frameLatency.Record(static_cast<uint64_t>(latency));
+    if (PerfOverlay::IsEnabled()) {
+        PerfOverlay::GetInstance().OnFrameSent(latency);
+    }
     isChanged = false;
 }
 
@@ -238,16 +254,19 @@ VirtualScreenImpl::~VirtualScreenImpl()
         delete [] wholeBuffer;
         wholeBuffer = nullptr;
         screenBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::SCREEN_BUFFER, 0);
     }
     FreeJpgMemory();
     if (WebSocketServer::GetInstance().firstImageBuffer) {
         delete [] WebSocketServer::GetInstance().firstImageBuffer;
         WebSocketServer::GetInstance().firstImageBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, 0);
     }
 }
 
 void VirtualScreenImpl::Flush(const OHOS::Rect& flushRect)
 {
+    TRACE_EVENT_SCOPE("RenderCallback");
     if (isFirstRender) {
         ILOG("Get first render buffer");
         TraceTool::GetInstance().HandleTrace("Get first render buffer");
@@ -259,17 +278,35 @@ void VirtualScreenImpl::Flush(const OHOS::Rect& flushRect)
         return;
     }
 
-    for (int i = 0; i <= compressionResolutionHeight - 1; ++i) {
-        for (int j = 0; j <= compressionResolutionWidth - 1; ++j) {
-            uint8_t* curPixel = screenBuffer + (i * compressionResolutionWidth + j) * jpgPix + headSize;
-            uint8_t* osPixel = osBuffer + (i * compressionResolutionWidth + j) * pixelSize + headSize;
-            *(curPixel + redPos) = *(osPixel + bluePos);
-            *(curPixel + greenPos) = *(osPixel + greenPos);
-            *(curPixel + bluePos) = *(osPixel + redPos);
+    {
+        TRACE_EVENT_SCOPE("StripRgba");
+        for (int i = 0; i <= compressionResolutionHeight - 1; ++i) {
+            for (int j = 0; j <= compressionResolutionWidth - 1; ++j) {
+                uint8_t* curPixel = screenBuffer + (i * compressionResolutionWidth + j) * jpgPix + headSize;
+                uint8_t* osPixel = osBuffer + (i * compressionResolutionWidth + j) * pixelSize + headSize;
+                *(curPixel + redPos) = *(osPixel + bluePos);
+                *(curPixel + greenPos) = *(osPixel + greenPos);
+                *(curPixel + bluePos) = *(osPixel + redPos);
+            }
         }
     }
 
+    if (isChanged) {
+        // The previous frame was never sent and is overwritten.
+        static PerfCounter& droppedFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_DROPPED);
+        droppedFrames.Add();
+        if (PerfOverlay::IsEnabled()) {
+            PerfOverlay::GetInstance().OnFrameDropped();
+        }
+    }
+    if (PerfOverlay::IsEnabled()) {
+        PerfOverlay::GetInstance().Draw(screenBuffer + headSize, compressionResolutionWidth,
+            compressionResolutionHeight, jpgPix);
+    }
     validFrameCountPerMinute++;
+    static PerfCounter& validFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_VALID);
+    validFrames.Add();
+    frameReadyTime = std::chrono::steady_clock::now();
     isChanged = true;
     ScheduleBufferSend();
 }
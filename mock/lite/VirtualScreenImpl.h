@@ -16,6 +16,8 @@
 #ifndef VIRTUALSREENIMPL_H
 #define VIRTUALSREENIMPL_H
 
+#include <chrono>
+
 #include "engines/gfx/soft_engine.h"
 #include "gfx_utils/color.h"
 #include "input_device.h"
@@ -49,6 +51,7 @@ private:
     uint8_t* regionBuffer;
     uint8_t* osBuffer;
     bool isChanged;
+    std::chrono::steady_clock::time_point frameReadyTime; // when the unsent frame was flushed
     void ScheduleBufferSend();
     void Send(unsigned char* data, int32_t width, int32_t height);
     void SendFullBuffer();
@@ -22,7 +22,11 @@
 
 #include "CommandLineInterface.h"
 #include "CommandParser.h"
+#include "MemoryStats.h"
+#include "PerfOverlay.h"
+#include "PerfStats.h"
 #include "PreviewerEngineLog.h"
+#include "TraceEvent.h"
 #include "TraceTool.h"
 #include <sstream>
 
@@ -45,12 +49,14 @@ void VirtualScreenImpl::SendBufferOnTimer()
         if (GetInstance().loadDocCopyBuffer != nullptr) {
             delete [] GetInstance().loadDocCopyBuffer;
             GetInstance().loadDocCopyBuffer = nullptr;
+            MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_COPY_BUFFER, 0);
         }
         GetInstance().loadDocCopyBuffer = new(std::nothrow) uint8_t[GetInstance().lengthTemp];
         if (!GetInstance().loadDocCopyBuffer) {
             ELOG("Memory allocation failed : loadDocCopyBuffer.");
             return;
         }
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_COPY_BUFFER, GetInstance().lengthTemp);
         std::copy(GetInstance().loadDocTempBuffer,
             GetInstance().loadDocTempBuffer + GetInstance().lengthTemp,
             GetInstance().loadDocCopyBuffer);
@@ -63,6 +69,7 @@ void VirtualScreenImpl::SendBufferOnTimer()
         ELOG("Memory allocation failed : wholeBuffer.");
         return;
     }
+    MemoryStats::GetInstance().SetBuffer(MemoryTag::SCREEN_BUFFER, LWS_PRE + GetInstance().bufferSize);
     GetInstance().screenBuffer = GetInstance().wholeBuffer + LWS_PRE;
     GetInstance().SendPixmap(GetInstance().loadDocCopyBuffer, GetInstance().lengthTemp,
         GetInstance().widthTemp, GetInstance().heightTemp);
@@ -150,6 +157,7 @@ bool VirtualScreenImpl::LoadDocCallback(const void* data, const size_t length, c
             if (GetInstance().loadDocTempBuffer != nullptr) {
                 delete [] GetInstance().loadDocTempBuffer;
                 GetInstance().loadDocTempBuffer = nullptr;
+                MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_TEMP_BUFFER, 0);
             }
             GetInstance().lengthTemp = length;
             GetInstance().widthTemp = width;
@@ -163,6 +171,7 @@ bool VirtualScreenImpl::LoadDocCallback(const void* data, const size_t length, c
                 ELOG("Memory allocation failed : loadDocTempBuffer.");
                 return false;
             }
+            MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_TEMP_BUFFER, length);
             uint8_t*  dataPtr = reinterpret_cast<uint8_t*>(const_cast<void*>(data));
             std::copy(dataPtr, dataPtr + length, GetInstance().loadDocTempBuffer);
             GetInstance().onRenderTime = std::chrono::system_clock::now();
@@ -181,6 +190,7 @@ bool VirtualScreenImpl::LoadDocCallback(const void* data, const size_t length, c
 bool VirtualScreenImpl::Callback(const void* data, const size_t length,
                                  const int32_t width, const int32_t height, const uint64_t timeStamp)
 {
+    TRACE_EVENT_SCOPE("RenderCallback");
     if (VirtualScreenImpl::GetInstance().StopSendStaticCardImage(STOP_SEND_CARD_DURATION_MS)) {
         return false; // 静态卡片
     }
@@ -188,6 +198,11 @@ bool VirtualScreenImpl::Callback(const void* data, const size_t length,
         return false;
     }
     if (VirtualScreenImpl::GetInstance().JudgeAndDropFrame()) {
+        static PerfCounter& droppedFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_DROPPED);
+        droppedFrames.Add();
+        if (PerfOverlay::IsEnabled()) {
+            PerfOverlay::GetInstance().OnFrameDropped();
+        }
         return false; // 丢帧*
     }
     bool staticRet = VirtualScreen::JudgeStaticImage(SEND_IMG_DURATION_MS);
@@ -204,6 +219,7 @@ bool VirtualScreenImpl::Callback(const void* data, const size_t length,
         ELOG("Memory allocation failed : wholeBuffer.");
         return false;
     }
+    MemoryStats::GetInstance().SetBuffer(MemoryTag::SCREEN_BUFFER, LWS_PRE + GetInstance().bufferSize);
     GetInstance().screenBuffer = GetInstance().wholeBuffer + LWS_PRE;
 
     return GetInstance().SendPixmap(data, length, width, height);
@@ -282,14 +298,17 @@ VirtualScreenImpl::~VirtualScreenImpl()
     if (WebSocketServer::GetInstance().firstImageBuffer) {
         delete [] WebSocketServer::GetInstance().firstImageBuffer;
         WebSocketServer::GetInstance().firstImageBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, 0);
     }
     if (VirtualScreenImpl::GetInstance().loadDocTempBuffer != nullptr) {
         delete [] VirtualScreenImpl::GetInstance().loadDocTempBuffer;
         VirtualScreenImpl::GetInstance().loadDocTempBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_TEMP_BUFFER, 0);
     }
     if (VirtualScreenImpl::GetInstance().loadDocCopyBuffer != nullptr) {
         delete [] VirtualScreenImpl::GetInstance().loadDocCopyBuffer;
         VirtualScreenImpl::GetInstance().loadDocCopyBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_COPY_BUFFER, 0);
     }
 }
 
@@ -309,15 +328,21 @@ void VirtualScreenImpl::Send(const void* data, int32_t retWidth, int32_t retHeig
         ELOG("Memory allocation failed : dataTemp.");
         return;
     }
-    for (int i = 0; i < retHeight; i++) {
-        for (int j = 0; j < retWidth; j++) {
-            int inputBasePos = i * retWidth * pixelSize + j * pixelSize;
-            int nowBasePos = i * retWidth * jpgPix + j * jpgPix;
-            dataTemp[nowBasePos + redPos] = *((char*)data + inputBasePos + redPos);
-            dataTemp[nowBasePos + greenPos] = *((char*)data + inputBasePos + greenPos);
-            dataTemp[nowBasePos + bluePos] = *((char*)data + inputBasePos + bluePos);
+    {
+        TRACE_EVENT_SCOPE("StripRgba");
+        for (int i = 0; i < retHeight; i++) {
+            for (int j = 0; j < retWidth; j++) {
+                int inputBasePos = i * retWidth * pixelSize + j * pixelSize;
+                int nowBasePos = i * retWidth * jpgPix + j * jpgPix;
+                dataTemp[nowBasePos + redPos] = *((char*)data + inputBasePos + redPos);
+                dataTemp[nowBasePos + greenPos] = *((char*)data + inputBasePos + greenPos);
+                dataTemp[nowBasePos + bluePos] = *((char*)data + inputBasePos + bluePos);
+            }
         }
     }
+    if (PerfOverlay::IsEnabled()) {
+        PerfOverlay::GetInstance().Draw(dataTemp, retWidth, retHeight, jpgPix);
+    }
     VirtualScreen::RgbToJpg(dataTemp, retWidth, retHeight);
     delete [] dataTemp;
     if (jpgBufferSize > bufferSize - headSize) {
@@ -330,10 +355,14 @@ void VirtualScreenImpl::Send(const void* data, int32_t retWidth, int32_t retHeig
     BackupAndDeleteBuffer(jpgBufferSize);
 }
 
-void VirtualScreenImpl::SendRgba(const void* data, size_t length)
+void VirtualScreenImpl::SendRgba(const void* data, size_t length, int32_t retWidth, int32_t retHeight)
 {
     const char* charData = reinterpret_cast<const char*>(data);
     std::copy(charData, charData + length, screenBuffer + headSize);
+    if (PerfOverlay::IsEnabled() && retWidth > 0 && retHeight > 0 &&
+        length >= static_cast<size_t>(retWidth) * static_cast<size_t>(retHeight) * pixelSize) {
+        PerfOverlay::GetInstance().Draw(screenBuffer + headSize, retWidth, retHeight, pixelSize);
+    }
     writed = WebSocketServer::GetInstance().WriteData(screenBuffer, headSize + length);
     BackupAndDeleteBuffer(length);
 }
@@ -344,12 +373,14 @@ void VirtualScreenImpl::BackupAndDeleteBuffer(const unsigned long imageBufferSiz
     if (WebSocketServer::GetInstance().firstImageBuffer) {
         delete [] WebSocketServer::GetInstance().firstImageBuffer;
         WebSocketServer::GetInstance().firstImageBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, 0);
     }
     WebSocketServer::GetInstance().firstImageBuffer = new(std::nothrow) uint8_t[LWS_PRE + bufferSize];
     if (!WebSocketServer::GetInstance().firstImageBuffer) {
         ELOG("Memory allocation failed : firstImageBuffer.");
         return;
     }
+    MemoryStats::GetInstance().SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, LWS_PRE + bufferSize);
     WebSocketServer::GetInstance().firstImagebufferSize = headSize + jpgBufferSize;
     std::copy(screenBuffer,
               screenBuffer + headSize + imageBufferSize,
@@ -363,6 +394,8 @@ bool VirtualScreenImpl::JudgeBeforeSend(const void* data)
     if (data == nullptr) {
         ELOG("render callback data is null.");
         invalidFrameCountPerMinute++;
+        static PerfCounter& invalidFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_INVALID);
+        invalidFrames.Add();
         return false;
     }
     if (!isWebSocketConfiged) {
@@ -377,12 +410,16 @@ bool VirtualScreenImpl::SendPixmap(const void* data, size_t length, int32_t retW
     if (!JudgeBeforeSend(data)) {
         return false;
     }
+    auto startTime = std::chrono::steady_clock::now();
     if (isFirstRender) {
         ILOG("Get first render buffer");
         TraceTool::GetInstance().HandleTrace("Get first render buffer");
         isFirstRender = false;
     }
-    isFrameUpdated = true;
+    if (!isFrameUpdated.exchange(true)) {
+        // Lets the command thread schedule the inspector refresh for this frame.
+        CommandLineInterface::GetInstance().Wakeup();
+    }
     currentPos = 0;
     WriteBuffer(headStart);
     WriteBuffer(retWidth);
@@ -408,7 +445,7 @@ bool VirtualScreenImpl::SendPixmap(const void* data, size_t length, int32_t retW
         }
     }
     if (CommandParser::GetInstance().IsComponentMode()) {
-        SendRgba(data, length);
+        SendRgba(data, length, retWidth, retHeight);
     } else {
         Send(data, retWidth, retHeight);
     }
@@ -419,6 +456,17 @@ bool VirtualScreenImpl::SendPixmap(const void* data, size_t length, int32_t retW
     }
     validFrameCountPerMinute++;
     sendFrameCountPerMinute++;
+    static PerfCounter& validFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_VALID);
+    static PerfCounter& sentFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_SENT);
+    validFrames.Add();
+    sentFrames.Add();
+    int64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    static PerfHistogram& frameLatency = PerfStats::GetInstance().GetHistogram(PerfMetric::FRAME_LATENCY);
+    frameLatency.Record(static_cast<uint64_t>(latency));
+    if (PerfOverlay::IsEnabled()) {
+        PerfOverlay::GetInstance().OnFrameSent(latency);
+    }
     return writed == length;
 }
 
@@ -428,6 +476,7 @@ void VirtualScreenImpl::FreeJpgMemory()
         delete [] wholeBuffer;
         wholeBuffer = nullptr;
         screenBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::SCREEN_BUFFER, 0);
     }
     if (jpgScreenBuffer != nullptr) {
         free(jpgScreenBuffer);
@@ -437,10 +486,12 @@ void VirtualScreenImpl::FreeJpgMemory()
     if (loadDocCopyBuffer != nullptr) {
         delete [] loadDocCopyBuffer;
         loadDocCopyBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_COPY_BUFFER, 0);
     }
     if (loadDocTempBuffer != nullptr) {
         delete [] loadDocTempBuffer;
         loadDocTempBuffer = nullptr;
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::LOAD_DOC_TEMP_BUFFER, 0);
     }
 }
 
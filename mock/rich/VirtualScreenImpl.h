@@ -56,7 +56,7 @@ private:
     VirtualScreenImpl();
     ~VirtualScreenImpl();
     void Send(const void* data, int32_t retWidth, int32_t retHeight);
-    void SendRgba(const void* data, size_t length);
+    void SendRgba(const void* data, size_t length, int32_t retWidth, int32_t retHeight);
     void BackupAndDeleteBuffer(const unsigned long imageBufferSize);
     bool JudgeBeforeSend(const void* data);
     bool SendPixmap(const void* data, size_t length, int32_t retWidth, int32_t retHeight);
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "CommandLineFactory.h"
+#include "CommandLineInterface.h"
+#include "MockGlobalResult.h"
+#include "PreviewerEngineLog.h"
+
+namespace {
+    std::atomic<uint64_t> g_allocationCount(0);
+}
+
+// Counts the C++ heap allocations of the whole binary, cJSON allocates with malloc and is not counted.
+void* operator new(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* data = malloc(size == 0 ? 1 : size);
+    if (data == nullptr) {
+        abort(); // built without exceptions
+    }
+    return data;
+}
+
+void operator delete(void* data) noexcept
+{
+    free(data);
+}
+
+void operator delete(void* data, size_t) noexcept
+{
+    free(data);
+}
+
+namespace {
+    // A stretch of a recorded session: a drag on the page, a theme switch and the router query the IDE
+    // sends after it.
+    const std::vector<std::string> RECORDED_MIX = {
+        R"({"type":"action","command":"MousePress","version":"1.0.1","args":{"x":365,"y":1076}})",
+        R"({"type":"action","command":"MouseMove","version":"1.0.1","args":{"x":366,"y":1070}})",
+        R"({"type":"action","command":"MouseMove","version":"1.0.1","args":{"x":368,"y":1061}})",
+        R"({"type":"action","command":"MouseMove","version":"1.0.1","args":{"x":371,"y":1049}})",
+        R"({"type":"action","command":"MouseMove","version":"1.0.1","args":{"x":375,"y":1034}})",
+        R"({"type":"action","command":"MouseRelease","version":"1.0.1","args":{"x":375,"y":1034}})",
+        R"({"type":"set","command":"ColorMode","version":"1.0.1","args":{"ColorMode":"dark"}})",
+        R"({"type":"get","command":"CurrentRouter","version":"1.0.1","args":{}})",
+    };
+    constexpr int ROUNDS = 20000;
+
+    // The whole command path of every message: parsing, version check, lookup, the command instance and
+    // the reply. Logging is off so the numbers do not depend on the log sink.
+    TEST(CommandDispatchBenchmark, RecordedMixTest)
+    {
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_FATAL);
+        CommandLineFactory::InitCommandMap();
+        CommandLineInterface::GetInstance().InitPipe("phone");
+        for (const std::string& message : RECORDED_MIX) { // warms up the reused instances
+            CommandLineInterface::GetInstance().ProcessCommandMessage(message);
+        }
+        g_dispatchOsTouchEvent = false;
+        g_output = false;
+        uint64_t allocations = g_allocationCount.load();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ROUNDS; i++) {
+            for (const std::string& message : RECORDED_MIX) {
+                CommandLineInterface::GetInstance().ProcessCommandMessage(message);
+            }
+        }
+        std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+        allocations = g_allocationCount.load() - allocations;
+        size_t count = ROUNDS * RECORDED_MIX.size();
+        printf("commands: %zu, %.0f ns and %.1f allocations per command\n", count, time.count() / count,
+            static_cast<double>(allocations) / count);
+        EXPECT_TRUE(g_dispatchOsTouchEvent);
+        EXPECT_TRUE(g_output);
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_INFO);
+    }
+}
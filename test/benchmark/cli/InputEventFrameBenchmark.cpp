@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "gtest/gtest.h"
+#define private public
+#include "CommandLineFactory.h"
+#include "CommandLineInterface.h"
+#include "InputCoalescer.h"
+#include "InputEventFrame.h"
+#include "MockGlobalResult.h"
+#include "PreviewerEngineLog.h"
+
+namespace {
+    constexpr int EVENT_COUNT = 200000;
+
+    double EventsPerSecond(std::chrono::steady_clock::time_point start)
+    {
+        std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+        return EVENT_COUNT / time.count();
+    }
+
+    // The command layer cost of a MouseMove sent as a JSON command and as a binary record. Every event
+    // is dispatched as it arrives and logging is off, so only parsing, validation and dispatch count.
+    TEST(InputEventFrameBenchmark, ThroughputTest)
+    {
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_FATAL);
+        CommandLineFactory::InitCommandMap();
+        CommandLineInterface::GetInstance().InitPipe("phone");
+        InputCoalescer::GetInstance().SetFlushInterval(0);
+        std::string json = R"({"type":"action","command":"MouseMove","version":"1.0.1","args":{"x":365,"y":1076}})";
+        g_dispatchOsTouchEvent = false;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < EVENT_COUNT; i++) {
+            CommandLineInterface::GetInstance().ProcessCommandMessage(json);
+        }
+        double jsonRate = EventsPerSecond(start);
+        EXPECT_TRUE(g_dispatchOsTouchEvent);
+
+        InputEventRecord record = {};
+        record.type = InputEventFrame::TYPE_MOVE;
+        record.button = -1;
+        record.sourceType = 2; // 2 is touch
+        record.sourceTool = 1; // 1 is finger
+        record.pressedButtons = (1u << 0) | (1u << 3);
+        record.x = 365; // 365: the x of the JSON command
+        record.y = 1076; // 1076: the y of the JSON command
+        record.axisCount = 2; // 2 axis values
+        record.axisValues[0] = 0.5;
+        record.axisValues[1] = -1.5;
+        uint8_t buffer[InputEventFrame::RECORD_SIZE];
+        InputEventFrame::Encode(record, buffer);
+        std::string payload(reinterpret_cast<const char*>(buffer), sizeof(buffer));
+        g_dispatchOsTouchEvent = false;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < EVENT_COUNT; i++) {
+            CommandLineInterface::GetInstance().ProcessInputEventFrame(0, payload);
+        }
+        double binaryRate = EventsPerSecond(start);
+        EXPECT_TRUE(g_dispatchOsTouchEvent);
+        printf("MouseMove events per second, json: %.0f, binary: %.0f\n", jsonRate, binaryRate);
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_INFO);
+    }
+}
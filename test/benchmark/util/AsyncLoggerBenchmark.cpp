@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "AsyncLogger.h"
+#include "PreviewerEngineLog.h"
+
+namespace {
+    constexpr int LINE_COUNT = 200000;
+    constexpr int THREAD_COUNT = 4;
+
+    double Seconds(std::chrono::steady_clock::time_point start)
+    {
+        std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+        return time.count();
+    }
+
+    // Lines per second into a file, as the callers see them and until every line is written. The
+    // lines look like the input logs of a drag, the most frequent ones in a session.
+    void LogLines(int threadCount)
+    {
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        uint32_t rateLimit = PreviewerLog::GetRateLimit();
+        PreviewerLog::SetRateLimit(0);
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(file);
+        int linesPerThread = LINE_COUNT / threadCount;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++) {
+            threads.emplace_back([linesPerThread]() {
+                for (int j = 0; j < linesPerThread; j++) {
+                    ILOG("MouseMove x:%d y:%d pressedButtons:%d", j % 1080, j % 2340, 1); // 1080 x 2340 screen
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double callerTime = Seconds(start);
+        AsyncLogger::GetInstance().Flush();
+        double writtenTime = Seconds(start);
+        AsyncLogger::GetInstance().SetOutput(stdout);
+        PreviewerLog::SetRateLimit(rateLimit);
+        long size = ftell(file);
+        fclose(file);
+        int lineCount = linesPerThread * threadCount;
+        printf("%d thread(s): %.0f lines/s returned, %.0f lines/s written\n", threadCount,
+            lineCount / callerTime, lineCount / writtenTime);
+        EXPECT_GT(size, 0);
+    }
+
+    TEST(AsyncLoggerBenchmark, OneThreadTest)
+    {
+        LogLines(1);
+    }
+
+    TEST(AsyncLoggerBenchmark, MultiThreadTest)
+    {
+        LogLines(THREAD_COUNT);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string>
+#include <map>
+#include <gtest/gtest.h>
+#include "cJSON.h"
+#include "secodeFuzz.h"
+#include "common.h"
+#include "ArgSchema.h"
+#include "CommandParse.h"
+#include "CommandLineInterface.h"
+#include "ChangeJsonUtil.h"
+#define private public
+#include "CommandParser.h"
+using namespace fuzztest;
+
+namespace {
+// The commands whose set arguments are checked by a schema, at the edges of their ranges.
+std::map<std::string, std::string> schemaDataMap = {
+    {"ColorMode", R"({"ColorMode":"light"})"},
+    {"Orientation", R"({"Orientation":"portrait"})"},
+    {"ResolutionSwitch", R"({"originWidth":50,"originHeight":3000,"width":3000,
+        "height":50,"screenDensity":640,"reason":"rotation"})"},
+    {"FontSelect", R"({"FontSelect":false})"},
+    {"DropFrame", R"({"frequency":0})"},
+    {"FoldStatus", R"({"FoldStatus":"half_fold","width":50,"height":3000})"},
+    {"Batch", R"({"commands":[{"command":"ColorMode","args":{"ColorMode":"dark"}},
+        {"command":"ResolutionSwitch","args":{"originWidth":1080,"originHeight":2340,"width":1080,
+        "height":2340,"screenDensity":120}}]})"}
+};
+
+struct SwitchArgs {
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t screenDensity = 0;
+    std::string reason = "undefined";
+};
+
+const int MIN_WIDTH = 50;
+const int MAX_WIDTH = 3000;
+const int MIN_DPI = 120;
+const int MAX_DPI = 640;
+
+// Sets every number of object to a fuzzed one, where ModifyObject only changes the int copy of it.
+void ModifyNumbers(cJSON* object, uint64_t& index)
+{
+    cJSON* item = nullptr;
+    cJSON_ArrayForEach(item, object) {
+        if (cJSON_IsNumber(item)) {
+            int value = *(s32 *)DT_SetGetS32(&g_Element[index], item->valueint);
+            index++;
+            cJSON_SetNumberValue(item, value);
+        }
+    }
+}
+
+TEST(ArgSchemaParseFuzzTest, test_schema)
+{
+    std::cout << "--> ArgSchemaParseFuzzTest for schema start <--" << std::endl;
+    ArgSchema<SwitchArgs> schema = ArgSchema<SwitchArgs>()
+        .Int("width", &SwitchArgs::width, MIN_WIDTH, MAX_WIDTH)
+        .Int("height", &SwitchArgs::height, MIN_WIDTH, MAX_WIDTH)
+        .Int("screenDensity", &SwitchArgs::screenDensity, MIN_DPI, MAX_DPI)
+        .String("reason", &SwitchArgs::reason, { "rotation", "resize", "undefined" }).Optional();
+    DT_FUZZ_START(0, TEST_TIMES, (char*)"ArgSchemaParseFuzzTest", 0)
+    {
+        uint64_t index = 0;
+        cJSON* jsonArgs = cJSON_Parse(R"({"width":1080,"height":2340,"screenDensity":480,"reason":"resize"})");
+        ModifyNumbers(jsonArgs, index);
+        ChangeJsonUtil::ModifyObject(jsonArgs, index);
+        ChangeJsonUtil::ModifyObject4ChangeType(jsonArgs, index);
+        Json2::Value args(jsonArgs);
+        SwitchArgs parsed;
+        // Whatever the arguments turned into, what the schema accepts is in range.
+        if (schema.Parse(args, parsed)) {
+            EXPECT_GE(parsed.width, MIN_WIDTH);
+            EXPECT_LE(parsed.width, MAX_WIDTH);
+            EXPECT_GE(parsed.height, MIN_WIDTH);
+            EXPECT_LE(parsed.height, MAX_WIDTH);
+            EXPECT_GE(parsed.screenDensity, MIN_DPI);
+            EXPECT_LE(parsed.screenDensity, MAX_DPI);
+            EXPECT_TRUE(parsed.reason == "rotation" || parsed.reason == "resize" || parsed.reason == "undefined");
+        }
+    }
+    DT_FUZZ_END()
+    printf("end ---- ArgSchemaParseFuzzTest\r\n");
+    if (DT_GetIsPass() == 0) {
+        printf("test ArgSchemaParseFuzzTest is not ok\r\n");
+    } else {
+        printf("test ArgSchemaParseFuzzTest is ok\r\n");
+    }
+    std::cout << "--> ArgSchemaParseFuzzTest for schema end <--" << std::endl;
+}
+
+TEST(ArgSchemaParseFuzzTest, test_command)
+{
+    std::cout << "--> ArgSchemaParseFuzzTest for command start <--" << std::endl;
+    DT_FUZZ_START(0, TEST_TIMES, (char*)"ArgSchemaCommandParseFuzzTest", 0)
+    {
+        CommandParse parse;
+        CommandParser::GetInstance().deviceType = "phone";
+        parse.CreateAndExecuteCommand(schemaDataMap);
+    }
+    DT_FUZZ_END()
+    printf("end ---- ArgSchemaCommandParseFuzzTest\r\n");
+    if (DT_GetIsPass() == 0) {
+        printf("test ArgSchemaCommandParseFuzzTest is not ok\r\n");
+    } else {
+        printf("test ArgSchemaCommandParseFuzzTest is ok\r\n");
+    }
+    std::cout << "--> ArgSchemaParseFuzzTest for command end <--" << std::endl;
+}
+}
@@ -104,4 +104,12 @@ const AvoidAreas JsApp::GetCurrentAvoidArea() const
 {
     AvoidAreas areas;
     return areas;
+}
+void JsApp::BeginSettingsBatch()
+{
+    //Only for mock test, no specific implementation
+}
+void JsApp::EndSettingsBatch()
+{
+    //Only for mock test, no specific implementation
 }
\ No newline at end of file
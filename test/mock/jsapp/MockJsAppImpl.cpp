@@ -153,4 +153,14 @@ void JsAppImpl::SetAvoidArea(const AvoidAreas& areas)
     avoidInitialAreas = areas;
 }
 
+void JsAppImpl::BeginSettingsBatch()
+{
+    isSettingsBatch = true;
+}
+
+void JsAppImpl::EndSettingsBatch()
+{
+    isSettingsBatch = false;
+}
+
 void JsAppImpl::InitJsApp() {}
\ No newline at end of file
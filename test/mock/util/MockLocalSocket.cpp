@@ -16,7 +16,7 @@
 #include "LocalSocket.h"
 #include "MockGlobalResult.h"
 
-LocalSocket::LocalSocket() {}
+LocalSocket::LocalSocket() : isMessageFramed(false), socketHandle(-1) {}
 
 LocalSocket::~LocalSocket() {}
 
@@ -57,7 +57,34 @@ int64_t LocalSocket::ReadData(char* data, size_t length) const
     return length;
 }
 
+int64_t LocalSocket::GetPendingWriteBytes() const
+{
+    return 0;
+}
+
 size_t LocalSocket::WriteData(const void* data, size_t length) const
 {
     return length;
-}
\ No newline at end of file
+}
+
+size_t LocalSocket::WriteSegments(const Segment* segments, size_t count) const
+{
+    g_output = true;
+    size_t totalSize = 0;
+    for (size_t i = 0; i < count; i++) {
+        totalSize += segments[i].length;
+    }
+    return totalSize;
+}
+
+size_t LocalSocket::WriteMessage(const std::string& message, uint32_t requestId) const
+{
+    g_output = true;
+    return message.length() + 1;
+}
+
+size_t LocalSocket::WriteFrame(uint16_t type, uint32_t requestId, const void* payload, size_t length) const
+{
+    g_output = true;
+    return MessageFrame::HEADER_SIZE + length;
+}
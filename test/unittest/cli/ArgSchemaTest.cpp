@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string>
+#include "gtest/gtest.h"
+#define private public
+#define protected public
+#include "ArgSchema.h"
+
+namespace {
+    struct ResolutionArgs {
+        int32_t width = 0;
+        int32_t height = 0;
+        uint32_t density = 0;
+        double scale = 1.0;
+        bool isRound = false;
+        std::string reason = "undefined";
+    };
+
+    const ArgSchema<ResolutionArgs>& GetSchema()
+    {
+        static const ArgSchema<ResolutionArgs> schema = ArgSchema<ResolutionArgs>()
+            .Int("width", &ResolutionArgs::width, 50, 3000) // 50, 3000: the width range
+            .Int("height", &ResolutionArgs::height, 50, 3000) // 50, 3000: the height range
+            .UInt("density", &ResolutionArgs::density, 120, 640) // 120, 640: the dpi range
+            .Double("scale", &ResolutionArgs::scale, 0, 1).Optional()
+            .Bool("isRound", &ResolutionArgs::isRound).Optional()
+            .String("reason", &ResolutionArgs::reason, { "rotation", "resize", "undefined" }).Optional();
+        return schema;
+    }
+
+    bool Parse(const std::string& json, ResolutionArgs& parsed)
+    {
+        Json2::Value args = JsonReader::ParseJsonData2(json);
+        return GetSchema().Parse(args, parsed);
+    }
+
+    TEST(ArgSchemaTest, ParseTest)
+    {
+        ResolutionArgs parsed;
+        ASSERT_TRUE(Parse(R"({"width":1080,"height":2340,"density":480,"scale":0.5,"isRound":true,
+            "reason":"resize","other":[1]})", parsed));
+        EXPECT_EQ(parsed.width, 1080);
+        EXPECT_EQ(parsed.height, 2340);
+        EXPECT_EQ(parsed.density, 480);
+        EXPECT_EQ(parsed.scale, 0.5);
+        EXPECT_TRUE(parsed.isRound);
+        EXPECT_EQ(parsed.reason, "resize");
+        // the optional fields left out are back to their defaults
+        ASSERT_TRUE(Parse(R"({"density":320,"height":100,"width":100})", parsed));
+        EXPECT_EQ(parsed.density, 320);
+        EXPECT_EQ(parsed.scale, 1.0);
+        EXPECT_FALSE(parsed.isRound);
+        EXPECT_EQ(parsed.reason, "undefined");
+        // the first of repeated keys counts
+        ASSERT_TRUE(Parse(R"({"width":100,"width":5000,"height":100,"density":320})", parsed));
+        EXPECT_EQ(parsed.width, 100);
+    }
+
+    TEST(ArgSchemaTest, InvalidTest)
+    {
+        ResolutionArgs parsed;
+        parsed.width = 7; // 7: left untouched by a failed parse
+        EXPECT_FALSE(GetSchema().Parse(JsonReader::CreateNull(), parsed));
+        EXPECT_FALSE(Parse(R"([1080, 2340, 480])", parsed));
+        EXPECT_FALSE(Parse(R"({"height":2340,"density":480})", parsed));
+        EXPECT_FALSE(Parse(R"({"Width":1080,"height":2340,"density":480})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":"1080","height":2340,"density":480})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":null,"height":2340,"density":480})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":1080,"height":2340,"density":-1})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":1080,"height":2340,"density":480,"scale":2})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":1080,"height":2340,"density":480,"isRound":1})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":1080,"height":2340,"density":480,"reason":"aaa"})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":1080,"height":2340,"density":480,"reason":333})", parsed));
+        EXPECT_EQ(parsed.width, 7);
+    }
+
+    TEST(ArgSchemaTest, RangeTest)
+    {
+        ResolutionArgs parsed;
+        EXPECT_TRUE(Parse(R"({"width":50,"height":3000,"density":120})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":49,"height":3000,"density":120})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":50,"height":3001,"density":120})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":50,"height":3000,"density":641})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":50,"height":3000,"density":5000000000})", parsed));
+        EXPECT_FALSE(Parse(R"({"width":-3000000000,"height":3000,"density":120})", parsed));
+    }
+
+    TEST(ArgSchemaTest, MaxFieldsTest)
+    {
+        struct ManyArgs {
+            bool last = false;
+        };
+        ArgSchema<ManyArgs> schema;
+        for (size_t i = 0; i <= ArgSchemaBase::MAX_FIELDS; i++) {
+            schema.Bool(("key" + std::to_string(i)).c_str(), &ManyArgs::last);
+        }
+        EXPECT_EQ(schema.fields.size(), ArgSchemaBase::MAX_FIELDS);
+        EXPECT_EQ(schema.members.size(), ArgSchemaBase::MAX_FIELDS);
+    }
+}
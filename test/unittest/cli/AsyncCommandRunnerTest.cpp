@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "AsyncCommandRunner.h"
+
+namespace {
+    void WaitForCompleted(AsyncCommandRunner& runner, size_t count)
+    {
+        for (int i = 0; i < 500; i++) { // 500: about 5 seconds
+            {
+                std::lock_guard<std::mutex> lock(runner.tasksMutex);
+                if (runner.completed.size() >= count) {
+                    return;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10: poll interval
+        }
+    }
+
+    TEST(AsyncCommandRunnerTest, SubmitTest)
+    {
+        AsyncCommandRunner& runner = AsyncCommandRunner::GetInstance();
+        std::atomic<int> notified(0);
+        runner.SetNotifier([&notified]() { notified++; });
+        runner.Submit("inspector", "tree-1", 3, [](CommandReply& reply) { // 3: frame request id
+            reply.data = "{\"result\":1}";
+        });
+        runner.Submit("inspectorDefault", "tree-2", 0, [](CommandReply& reply) {
+            reply.data = "{\"result\":2}";
+            reply.isDeflated = true;
+        });
+        WaitForCompleted(runner, 2); // 2: both jobs
+        std::vector<AsyncCommandRunner::Completion> completions;
+        runner.TakeCompleted(completions);
+        ASSERT_EQ(completions.size(), 2); // 2: in submit order
+        EXPECT_EQ(completions[0].command, "inspector");
+        EXPECT_EQ(completions[0].requestId, "tree-1");
+        EXPECT_EQ(completions[0].frameRequestId, 3); // 3: frame request id
+        EXPECT_EQ(completions[0].reply.data, "{\"result\":1}");
+        EXPECT_FALSE(completions[0].reply.isDeflated);
+        EXPECT_TRUE(completions[1].reply.isDeflated);
+        EXPECT_EQ(notified.load(), 2); // 2: once per job
+        EXPECT_EQ(runner.GetPendingCount(), 0);
+        runner.SetNotifier(nullptr);
+    }
+
+    TEST(AsyncCommandRunnerTest, CancelTest)
+    {
+        AsyncCommandRunner& runner = AsyncCommandRunner::GetInstance();
+        std::promise<void> started;
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        runner.Submit("inspector", "running", 0, [&started, released](CommandReply& reply) {
+            started.set_value();
+            released.wait();
+            reply.data = "dropped";
+        });
+        runner.Submit("inspector", "pending", 0, [](CommandReply& reply) { reply.data = "dropped"; });
+        started.get_future().wait();
+        AsyncCommandRunner::Completion cancelled;
+        EXPECT_TRUE(runner.Cancel("pending", cancelled));
+        EXPECT_EQ(cancelled.requestId, "pending");
+        EXPECT_TRUE(runner.Cancel("running", cancelled));
+        EXPECT_EQ(cancelled.command, "inspector");
+        EXPECT_FALSE(runner.Cancel("running", cancelled));
+        EXPECT_FALSE(runner.Cancel("unknown", cancelled));
+        runner.Submit("inspector", "done", 0, [](CommandReply& reply) { reply.data = "done"; });
+        release.set_value();
+        WaitForCompleted(runner, 1);
+        // a finished reply not written yet can still be cancelled
+        EXPECT_TRUE(runner.Cancel("done", cancelled));
+        EXPECT_EQ(cancelled.reply.data, "done");
+        std::vector<AsyncCommandRunner::Completion> completions;
+        runner.TakeCompleted(completions);
+        EXPECT_TRUE(completions.empty());
+        EXPECT_EQ(runner.GetPendingCount(), 0);
+    }
+}
@@ -15,6 +15,7 @@
 #include <string>
 #include "gtest/gtest.h"
 #define private public
+#define protected public
 #include "CommandLineFactory.h"
 #include "CommandParser.h"
 
@@ -23,7 +24,7 @@ namespace {
     {
         CommandLineFactory factory;
         factory.InitCommandMap();
-        EXPECT_TRUE(factory.typeMap.size() > 0);
+        EXPECT_TRUE(factory.GetCommandCount() > 0);
     }
 
     TEST(CommandLineFactoryTest, InitCommandMapTest)
@@ -31,7 +32,7 @@ namespace {
         std::string deviceType = "phone";
         CommandParser::GetInstance().deviceType = deviceType;
         CommandLineFactory::InitCommandMap();
-        EXPECT_TRUE(CommandLineFactory::typeMap.size() > 0);
+        EXPECT_TRUE(CommandLineFactory::GetCommandCount() > 0);
     }
 
     TEST(CommandLineFactoryTest, CreateCommandLineTest)
@@ -51,4 +52,58 @@ namespace {
             CommandLineFactory::CreateCommandLine(commandName, commandType, jsonData, *socket);
         EXPECT_FALSE(commandLine == nullptr);
     }
+
+    TEST(CommandLineFactoryTest, CommandTableTest)
+    {
+        for (size_t i = 0; i < CommandTable::COUNT; i++) {
+            EXPECT_EQ(CommandTable::Find(CommandTable::NAMES[i]), i);
+        }
+        EXPECT_EQ(CommandTable::Find(""), CommandTable::NOT_FOUND);
+        EXPECT_EQ(CommandTable::Find("ColorMode1"), CommandTable::NOT_FOUND);
+        EXPECT_EQ(CommandTable::Find("colormode"), CommandTable::NOT_FOUND);
+        static_assert(CommandTable::Find("MousePress") != CommandTable::NOT_FOUND, "looked up at compile time");
+    }
+
+    TEST(CommandLineFactoryTest, RunCommandLineTest)
+    {
+        CommandParser::GetInstance().deviceType = "phone";
+        CommandLineFactory::InitCommandMap();
+        std::unique_ptr<LocalSocket> socket = std::make_unique<LocalSocket>();
+        Json2::Value args = JsonReader::ParseJsonData2(R"({"ColorMode":"dark"})");
+        EXPECT_FALSE(CommandLineFactory::RunCommandLine("ColorMode1", CommandLine::CommandType::SET, args, *socket));
+        EXPECT_TRUE(CommandLineFactory::RunCommandLine("ColorMode", CommandLine::CommandType::SET, args, *socket));
+        CommandLineFactory::CommandEntry& entry = CommandLineFactory::commands[CommandTable::Find("ColorMode")];
+        CommandLine* instance = entry.instance.get();
+        ASSERT_NE(instance, nullptr);
+        Json2::Value nextArgs = JsonReader::ParseJsonData2(R"({"ColorMode":"light"})");
+        EXPECT_TRUE(CommandLineFactory::RunCommandLine("ColorMode", CommandLine::CommandType::SET, nextArgs, *socket));
+        EXPECT_EQ(entry.instance.get(), instance);
+        EXPECT_EQ(instance->args["ColorMode"].AsString(), "light");
+        EXPECT_FALSE(entry.isRunning);
+        // An instance is bound to its socket, another socket gets a new one.
+        std::unique_ptr<LocalSocket> otherSocket = std::make_unique<LocalSocket>();
+        EXPECT_TRUE(CommandLineFactory::RunCommandLine("ColorMode", CommandLine::CommandType::SET, args,
+            *otherSocket));
+        EXPECT_EQ(entry.instanceSocket, otherSocket.get());
+        entry.instance.reset();
+        entry.instanceSocket = nullptr;
+    }
+
+    TEST(CommandLineFactoryTest, IsCommandSupportedTest)
+    {
+        CommandParser::GetInstance().deviceType = "phone";
+        CommandLineFactory::InitCommandMap();
+        EXPECT_TRUE(CommandLineFactory::IsCommandSupported("ColorMode"));
+        EXPECT_TRUE(CommandLineFactory::IsCommandSupported("Batch"));
+        EXPECT_FALSE(CommandLineFactory::IsCommandSupported("ColorMode1"));
+    }
+
+    TEST(CommandLineFactoryTest, GetCommandLatencyTest)
+    {
+        CommandLineFactory::InitCommandMap();
+        EXPECT_EQ(&CommandLineFactory::GetCommandLatency("ColorMode"),
+            &PerfStats::GetInstance().GetCommandLatency("ColorMode"));
+        EXPECT_EQ(&CommandLineFactory::GetCommandLatency("ColorMode1"),
+            &PerfStats::GetInstance().GetCommandLatency("ColorMode1"));
+    }
 }
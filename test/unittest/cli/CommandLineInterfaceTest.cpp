@@ -22,7 +22,11 @@
 #define private public
 #include "CommandLineInterface.h"
 #include "CommandLineFactory.h"
+#include "CommandRecorder.h"
+#include "CommandReplayer.h"
+#include "CommandScheduler.h"
 #include "CommandParser.h"
+#include "Interrupter.h"
 #include "SharedData.h"
 #include "MockGlobalResult.h"
 #include "VirtualScreen.h"
@@ -192,6 +196,101 @@ namespace {
         EXPECT_FALSE(g_output);
     }
 
+    TEST(CommandLineInterfaceTest, QueueCommandMessageTest)
+    {
+        CommandLineInterface& instance = CommandLineInterface::GetInstance();
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        scheduler.Clear();
+        std::string bulk = R"({"type":"get","command":"inspector","version":"1.0.1"})";
+        instance.QueueCommandMessage(bulk, 0);
+        // the older tree request is answered as cancelled
+        g_output = false;
+        instance.QueueCommandMessage(bulk, 0);
+        EXPECT_TRUE(g_output);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 1);
+        // invalid messages are not queued
+        instance.QueueCommandMessage(R"({"type":"get","command":"inspector"})", 0);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 1);
+        std::string input = R"({"type":"action","command":"MousePress","version":"1.0.1",
+            "args":{"x":365,"y":1208}})";
+        instance.QueueCommandMessage(input, 0);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::INPUT), 1);
+        // the input runs first, the tree request waits for the next pass
+        instance.ProcessCommand();
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::INPUT), 0);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 1);
+        instance.ProcessCommand();
+        EXPECT_TRUE(scheduler.IsEmpty());
+    }
+
+    TEST(CommandLineInterfaceTest, CancelRequestTest)
+    {
+        CommandLineInterface& instance = CommandLineInterface::GetInstance();
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        scheduler.Clear();
+        instance.QueueCommandMessage(R"({"type":"get","command":"inspector","version":"1.0.1",
+            "requestId":"tree-1"})", 0);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 1);
+        g_output = false;
+        EXPECT_FALSE(instance.CancelRequest("tree-2"));
+        EXPECT_FALSE(g_output);
+        EXPECT_TRUE(instance.CancelRequest("tree-1"));
+        EXPECT_TRUE(g_output);
+        EXPECT_TRUE(scheduler.IsEmpty());
+        EXPECT_FALSE(instance.CancelRequest("tree-1"));
+        EXPECT_FALSE(instance.CancelRequest(""));
+    }
+
+    TEST(CommandLineInterfaceTest, ProtocolVersionPausesReadTest)
+    {
+        CommandLineInterface& instance = CommandLineInterface::GetInstance();
+        CommandScheduler::GetInstance().Clear();
+        std::string msg = R"({"type":"get","command":"ProtocolVersion","version":"1.0.1"})";
+        instance.QueueCommandMessage(msg, 0);
+        EXPECT_TRUE(CommandLineInterface::isReadPaused);
+        g_input = false;
+        instance.ReadCommands();
+        EXPECT_FALSE(g_input);
+        instance.ProcessCommand();
+        EXPECT_FALSE(CommandLineInterface::isReadPaused);
+        EXPECT_TRUE(CommandScheduler::GetInstance().IsEmpty());
+    }
+
+    TEST(CommandLineInterfaceTest, ReplayCommandsTest)
+    {
+        CommandLineInterface& instance = CommandLineInterface::GetInstance();
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        CommandReplayer& replayer = CommandReplayer::GetInstance();
+        scheduler.Clear();
+        std::string path = "CommandLineInterfaceTest.rec";
+        std::ofstream file(path);
+        CommandRecord record;
+        record.data = R"({"type":"get","command":"inspector","version":"1.0.1"})";
+        file << CommandRecorder::Encode(record) << '\n';
+        record.time = 1000; // 1000: us
+        record.data = R"({"type":"action","command":"MousePress","version":"1.0.1","args":{"x":365,"y":1208}})";
+        file << CommandRecorder::Encode(record) << '\n';
+        file.close();
+        ASSERT_TRUE(replayer.Load(path));
+        replayer.Start(0);
+        // back to back, the second message waits until the first command has run
+        instance.ReplayCommands();
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 1);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::INPUT), 0);
+        instance.ProcessCommand();
+        EXPECT_FALSE(replayer.IsDrained());
+        instance.ProcessCommand();
+        EXPECT_TRUE(replayer.IsDrained());
+        EXPECT_TRUE(scheduler.IsEmpty());
+        EXPECT_FALSE(Interrupter::IsInterrupt());
+        // the previewer exits once everything has run
+        instance.ProcessCommand();
+        EXPECT_FALSE(replayer.IsReplaying());
+        EXPECT_TRUE(Interrupter::IsInterrupt());
+        Interrupter::isInterrupt = false;
+        std::remove(path.c_str());
+    }
+
     TEST(CommandLineInterfaceTest, ProcessCommandValidateTest)
     {
         CommandLineInterface& instance = CommandLineInterface::GetInstance();
@@ -210,6 +309,26 @@ namespace {
         msg = R"({"type" : "action", "command" : "MousePress", "version" : "1.0.1"})";
         Json2::Value jsonData5 = JsonReader::ParseJsonData2(msg);
         EXPECT_TRUE(instance.ProcessCommandValidate(true, jsonData5, ""));
+        msg = R"({"type" : "get", "command" : "inspector", "version" : "1.0.1", "requestId" : 1})";
+        Json2::Value jsonData6 = JsonReader::ParseJsonData2(msg);
+        EXPECT_FALSE(instance.ProcessCommandValidate(true, jsonData6, "Invalid command requestId"));
+        msg = R"({"type" : "get", "command" : "inspector", "version" : "1.0.1", "requestId" : "1"})";
+        Json2::Value jsonData7 = JsonReader::ParseJsonData2(msg);
+        EXPECT_TRUE(instance.ProcessCommandValidate(true, jsonData7, ""));
+    }
+
+    TEST(CommandLineInterfaceTest, IsVersionValidTest)
+    {
+        EXPECT_TRUE(CommandLineInterface::IsVersionValid("1.0.1"));
+        EXPECT_TRUE(CommandLineInterface::IsVersionValid("10.20.300"));
+        EXPECT_TRUE(CommandLineInterface::IsVersionValid("1-0-1"));
+        EXPECT_TRUE(CommandLineInterface::IsVersionValid("10101")); // a digit may stand for the separator
+        EXPECT_FALSE(CommandLineInterface::IsVersionValid(""));
+        EXPECT_FALSE(CommandLineInterface::IsVersionValid("s.0.1"));
+        EXPECT_FALSE(CommandLineInterface::IsVersionValid("1.0"));
+        EXPECT_FALSE(CommandLineInterface::IsVersionValid("01.0.1"));
+        EXPECT_FALSE(CommandLineInterface::IsVersionValid("1.0.1."));
+        EXPECT_FALSE(CommandLineInterface::IsVersionValid("1.0.01"));
     }
 
     TEST(CommandLineInterfaceTest, GetCommandTypeTest)
@@ -225,7 +344,7 @@ namespace {
     {
         CommandLineInterface& instance = CommandLineInterface::GetInstance();
         instance.Init("phone");
-        EXPECT_TRUE(CommandLineFactory::typeMap.size() > 0);
+        EXPECT_TRUE(CommandLineFactory::GetCommandCount() > 0);
         EXPECT_TRUE(CommandLineInterface::isPipeConnected);
     }
 
@@ -395,4 +514,48 @@ namespace {
         EXPECT_FALSE(g_output);
         CommandLineInterface::GetInstance().socket = std::move(temp);
     }
+
+    TEST(CommandLineInterfaceTest, ProtocolVersionTest)
+    {
+        CommandLineInterface& instance = CommandLineInterface::GetInstance();
+        EXPECT_EQ(instance.GetProtocolVersion(), MessageFrame::TEXT_PROTOCOL_VERSION);
+        // unsupported version is rejected
+        std::string msg1 = R"({"type":"set","command":"ProtocolVersion","version":"1.0.1","args":{"version":3}})";
+        instance.ProcessCommandMessage(msg1);
+        instance.ApplyProtocolVersion();
+        EXPECT_EQ(instance.GetProtocolVersion(), MessageFrame::TEXT_PROTOCOL_VERSION);
+        // the reply is sent before the switch
+        g_output = false;
+        std::string msg2 = R"({"type":"set","command":"ProtocolVersion","version":"1.0.1","args":{"version":2}})";
+        instance.ProcessCommandMessage(msg2);
+        EXPECT_TRUE(g_output);
+        EXPECT_FALSE(instance.socket->IsMessageFramed());
+        instance.ApplyProtocolVersion();
+        EXPECT_TRUE(instance.socket->IsMessageFramed());
+        EXPECT_EQ(instance.GetProtocolVersion(), MessageFrame::FRAMED_PROTOCOL_VERSION);
+        // back to the text protocol
+        instance.SetProtocolVersion(MessageFrame::TEXT_PROTOCOL_VERSION);
+        instance.ApplyProtocolVersion();
+        EXPECT_FALSE(instance.socket->IsMessageFramed());
+    }
+
+    TEST(CommandLineInterfaceTest, CompressionTest)
+    {
+        CommandLineInterface& instance = CommandLineInterface::GetInstance();
+        EXPECT_EQ(instance.GetCompressionThreshold(), 0);
+        // unsupported encoding is rejected
+        std::string msg1 = R"({"type":"set","command":"Compression","version":"1.0.1","args":{"encoding":"zstd"}})";
+        instance.ProcessCommandMessage(msg1);
+        EXPECT_EQ(instance.GetCompressionThreshold(), 0);
+        std::string msg2 = R"({"type":"set","command":"Compression","version":"1.0.1","args":{"encoding":"deflate"}})";
+        instance.ProcessCommandMessage(msg2);
+        EXPECT_EQ(instance.GetCompressionThreshold(), CommandLineInterface::DEFAULT_COMPRESSION_THRESHOLD);
+        std::string msg3 = R"({"type":"set","command":"Compression","version":"1.0.1",
+            "args":{"encoding":"deflate","threshold":1024}})";
+        instance.ProcessCommandMessage(msg3);
+        EXPECT_EQ(instance.GetCompressionThreshold(), 1024); // 1024 is test threshold
+        std::string msg4 = R"({"type":"set","command":"Compression","version":"1.0.1","args":{"encoding":"none"}})";
+        instance.ProcessCommandMessage(msg4);
+        EXPECT_EQ(instance.GetCompressionThreshold(), 0);
+    }
 }
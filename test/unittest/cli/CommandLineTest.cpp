@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
 #include <string>
 #include <map>
 #include "gtest/gtest.h"
@@ -19,6 +20,7 @@
 #define protected public
 #include "CommandLineFactory.h"
 #include "CommandParser.h"
+#include "CommandScheduler.h"
 #include "JsAppImpl.h"
 #include "MockGlobalResult.h"
 #include "VirtualScreenImpl.h"
@@ -27,6 +29,11 @@
 #include "SharedData.h"
 #include "MouseWheelImpl.h"
 #include "Interrupter.h"
+#include "MemoryStats.h"
+#include "PerfOverlay.h"
+#include "PerfStatsPublisher.h"
+#include "PreviewerEngineLog.h"
+#include "TraceEvent.h"
 
 namespace {
     class CommandLineTest : public ::testing::Test {
@@ -38,6 +45,8 @@ namespace {
         static void SetUpTestCase()
         {
             socket = std::make_unique<LocalSocket>();
+            // Every input event is expected to be dispatched right after its command.
+            InputCoalescer::GetInstance().SetFlushInterval(0);
             SharedData<bool>(SharedDataType::KEEP_SCREEN_ON, true);
             SharedData<uint8_t>(SharedDataType::BATTERY_STATUS, (uint8_t)ChargeState::NOCHARGE,
                                 (uint8_t)ChargeState::NOCHARGE, (uint8_t)ChargeState::CHARGING);
@@ -240,6 +249,47 @@ namespace {
         EXPECT_EQ(JsAppImpl::GetInstance().height, 2340);
     }
 
+    // The arguments are checked and read in one walk, the run reads what the check filled.
+    TEST_F(CommandLineTest, ResolutionSwitchCommandSchemaTest)
+    {
+        CommandLine::CommandType type = CommandLine::CommandType::SET;
+        std::string jsonStr = R"({"originWidth" : 1080, "originHeight" : 2340, "width" : 720,
+            "height" : 1280, "screenDensity" : 320})";
+        Json2::Value args1 = JsonReader::ParseJsonData2(jsonStr);
+        ResolutionSwitchCommand command(type, args1, *socket);
+        EXPECT_FALSE(command.isSetArgsParsed);
+        ASSERT_TRUE(command.IsSetArgValid());
+        EXPECT_TRUE(command.isSetArgsParsed);
+        EXPECT_EQ(command.setArgs.width, 720);
+        EXPECT_EQ(command.setArgs.screenDensity, 320);
+        EXPECT_EQ(command.setArgs.reason, "undefined");
+        // a reused instance checks its next arguments again
+        Json2::Value args2 = JsonReader::ParseJsonData2(R"({"width" : 720})");
+        command.Reset(type, args2);
+        EXPECT_FALSE(command.isSetArgsParsed);
+        EXPECT_FALSE(command.IsSetArgValid());
+        JsAppImpl::GetInstance().width = 0;
+        command.RunSet();
+        EXPECT_EQ(JsAppImpl::GetInstance().width, 0);
+    }
+
+    // A value the schema accepts but the setting refuses leaves the arguments unparsed.
+    TEST_F(CommandLineTest, PowerCommandSchemaTest)
+    {
+        CommandLine::CommandType type = CommandLine::CommandType::SET;
+        Json2::Value args = JsonReader::ParseJsonData2(R"({"Power":2.0})");
+        PowerCommand command(type, args, *socket);
+        EXPECT_FALSE(command.IsSetArgValid());
+        EXPECT_FALSE(command.isSetArgsParsed);
+        double power = SharedData<double>::GetData(SharedDataType::BATTERY_LEVEL);
+        command.RunSet();
+        EXPECT_EQ(SharedData<double>::GetData(SharedDataType::BATTERY_LEVEL), power);
+        args.Replace("Power", 0.25); // 0.25 is test Power value
+        command.Reset(type, args);
+        EXPECT_TRUE(command.IsSetArgValid());
+        EXPECT_EQ(command.setArgs.power, 0.25); // 0.25 is test Power value
+    }
+
     TEST_F(CommandLineTest, CurrentRouterCommandTest)
     {
         CommandLine::CommandType type = CommandLine::CommandType::GET;
@@ -1770,4 +1820,224 @@ namespace {
         command2.CheckAndRun();
         EXPECT_EQ(JsAppImpl::GetInstance().colorMode, "light");
     }
+
+    TEST_F(CommandLineTest, LogLevelCommandTest)
+    {
+        int32_t level = PreviewerLog::GetLevel();
+        uint32_t rateLimit = PreviewerLog::GetRateLimit();
+        CommandLine::CommandType type = CommandLine::CommandType::SET;
+        std::string msg1 = R"({"level" : "warn", "rateLimit" : 10})";
+        Json2::Value args1 = JsonReader::ParseJsonData2(msg1);
+        LogLevelCommand command1(type, args1, *socket);
+        command1.CheckAndRun();
+        EXPECT_EQ(PreviewerLog::GetLevel(), PreviewerLog::LEVEL_WARN);
+        EXPECT_EQ(PreviewerLog::GetRateLimit(), 10);
+        // invalid arguments leave the settings untouched
+        std::string msg2 = R"({"level" : "verbose", "rateLimit" : 20})";
+        Json2::Value args2 = JsonReader::ParseJsonData2(msg2);
+        LogLevelCommand command2(type, args2, *socket);
+        command2.CheckAndRun();
+        EXPECT_EQ(PreviewerLog::GetLevel(), PreviewerLog::LEVEL_WARN);
+        EXPECT_EQ(PreviewerLog::GetRateLimit(), 10);
+        Json2::Value args3 = JsonReader::CreateObject();
+        LogLevelCommand command3(CommandLine::CommandType::GET, args3, *socket);
+        g_output = false;
+        command3.CheckAndRun();
+        EXPECT_TRUE(g_output);
+        PreviewerLog::SetLevel(level);
+        PreviewerLog::SetRateLimit(rateLimit);
+    }
+
+    TEST_F(CommandLineTest, TraceEventCommandTest)
+    {
+        std::string msg1 = R"({"enable" : true})";
+        Json2::Value args1 = JsonReader::ParseJsonData2(msg1);
+        TraceEventCommand command1(CommandLine::CommandType::SET, args1, *socket);
+        command1.CheckAndRun();
+        EXPECT_TRUE(TraceEvent::IsEnabled());
+        Json2::Value args2 = JsonReader::CreateObject();
+        TraceEventCommand command2(CommandLine::CommandType::GET, args2, *socket);
+        g_output = false;
+        command2.CheckAndRun();
+        EXPECT_TRUE(g_output);
+        std::string msg3 = R"({"path" : "trace_event_command_test.json"})";
+        Json2::Value args3 = JsonReader::ParseJsonData2(msg3);
+        TraceEventCommand command3(CommandLine::CommandType::ACTION, args3, *socket);
+        g_output = false;
+        command3.CheckAndRun();
+        EXPECT_TRUE(g_output);
+        std::remove("trace_event_command_test.json");
+        // invalid arguments leave the recording untouched
+        std::string msg4 = R"({"enable" : "false"})";
+        Json2::Value args4 = JsonReader::ParseJsonData2(msg4);
+        TraceEventCommand command4(CommandLine::CommandType::SET, args4, *socket);
+        command4.CheckAndRun();
+        EXPECT_TRUE(TraceEvent::IsEnabled());
+        TraceEvent::GetInstance().SetEnabled(false);
+    }
+
+    TEST_F(CommandLineTest, PerfStatsCommandTest)
+    {
+        std::string msg1 = R"({"subscribe" : true, "interval" : 500})";
+        Json2::Value args1 = JsonReader::ParseJsonData2(msg1);
+        PerfStatsCommand command1(CommandLine::CommandType::SET, args1, *socket);
+        command1.CheckAndRun();
+        EXPECT_TRUE(PerfStatsPublisher::GetInstance().IsSubscribed());
+        EXPECT_EQ(PerfStatsPublisher::GetInstance().GetInterval(), 500);
+        // an interval out of range leaves the subscription untouched
+        std::string msg2 = R"({"subscribe" : true, "interval" : 10})";
+        Json2::Value args2 = JsonReader::ParseJsonData2(msg2);
+        PerfStatsCommand command2(CommandLine::CommandType::SET, args2, *socket);
+        command2.CheckAndRun();
+        EXPECT_EQ(PerfStatsPublisher::GetInstance().GetInterval(), 500);
+        Json2::Value args3 = JsonReader::CreateObject();
+        PerfStatsCommand command3(CommandLine::CommandType::GET, args3, *socket);
+        g_output = false;
+        command3.CheckAndRun();
+        EXPECT_TRUE(g_output);
+        std::string msg4 = R"({"subscribe" : false})";
+        Json2::Value args4 = JsonReader::ParseJsonData2(msg4);
+        PerfStatsCommand command4(CommandLine::CommandType::SET, args4, *socket);
+        command4.CheckAndRun();
+        EXPECT_FALSE(PerfStatsPublisher::GetInstance().IsSubscribed());
+    }
+
+    TEST_F(CommandLineTest, PerfOverlayCommandTest)
+    {
+        std::string msg1 = R"({"enable" : true})";
+        Json2::Value args1 = JsonReader::ParseJsonData2(msg1);
+        PerfOverlayCommand command1(CommandLine::CommandType::SET, args1, *socket);
+        command1.CheckAndRun();
+        EXPECT_TRUE(PerfOverlay::IsEnabled());
+        Json2::Value args2 = JsonReader::CreateObject();
+        PerfOverlayCommand command2(CommandLine::CommandType::GET, args2, *socket);
+        g_output = false;
+        command2.CheckAndRun();
+        EXPECT_TRUE(g_output);
+        // invalid arguments leave the overlay untouched
+        std::string msg3 = R"({"enable" : 0})";
+        Json2::Value args3 = JsonReader::ParseJsonData2(msg3);
+        PerfOverlayCommand command3(CommandLine::CommandType::SET, args3, *socket);
+        command3.CheckAndRun();
+        EXPECT_TRUE(PerfOverlay::IsEnabled());
+        std::string msg4 = R"({"enable" : false})";
+        Json2::Value args4 = JsonReader::ParseJsonData2(msg4);
+        PerfOverlayCommand command4(CommandLine::CommandType::SET, args4, *socket);
+        command4.CheckAndRun();
+        EXPECT_FALSE(PerfOverlay::IsEnabled());
+    }
+
+    TEST_F(CommandLineTest, MemoryStatsCommandTest)
+    {
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::HSP_BUFFER, 4096); // 4096: bytes
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::HSP_BUFFER, 1024); // 1024: bytes
+        Json2::Value args1 = JsonReader::CreateObject();
+        MemoryStatsCommand command1(CommandLine::CommandType::GET, args1, *socket);
+        g_output = false;
+        command1.CheckAndRun();
+        EXPECT_TRUE(g_output);
+        std::string msg2 = R"({"resetPeak" : true})";
+        Json2::Value args2 = JsonReader::ParseJsonData2(msg2);
+        MemoryStatsCommand command2(CommandLine::CommandType::SET, args2, *socket);
+        command2.CheckAndRun();
+        EXPECT_EQ(MemoryStats::GetInstance().GetPeak(MemoryTag::HSP_BUFFER), 1024); // 1024: what is held now
+        MemoryStats::GetInstance().SetBuffer(MemoryTag::HSP_BUFFER, 0);
+    }
+
+    TEST_F(CommandLineTest, CancelCommandTest)
+    {
+        ScheduledCommand tree;
+        tree.name = "inspector";
+        tree.type = CommandLine::CommandType::GET;
+        tree.clientRequestId = "tree-1";
+        std::vector<ScheduledCommand> superseded;
+        CommandScheduler::GetInstance().Push(std::move(tree), superseded);
+        std::string msg1 = R"({"requestId" : "tree-1"})";
+        Json2::Value args1 = JsonReader::ParseJsonData2(msg1);
+        CancelCommand command1(CommandLine::CommandType::SET, args1, *socket);
+        g_output = false;
+        command1.RunSet();
+        EXPECT_TRUE(g_output); // the cancelled request is answered
+        EXPECT_TRUE(command1.commandResult["result"].AsBool());
+        EXPECT_TRUE(CommandScheduler::GetInstance().IsEmpty());
+        // nothing is left to cancel
+        CancelCommand command2(CommandLine::CommandType::SET, args1, *socket);
+        command2.RunSet();
+        EXPECT_FALSE(command2.commandResult["result"].AsBool());
+        std::string msg3 = R"({"requestId" : 1})";
+        Json2::Value args3 = JsonReader::ParseJsonData2(msg3);
+        CancelCommand command3(CommandLine::CommandType::SET, args3, *socket);
+        EXPECT_FALSE(command3.IsSetArgValid());
+    }
+
+    TEST_F(CommandLineTest, BatchCommandTest)
+    {
+        CommandParser::GetInstance().deviceType = "phone";
+        CommandLineFactory::InitCommandMap();
+        JsAppImpl::GetInstance().orientation = "portrait";
+        JsAppImpl::GetInstance().colorMode = "light";
+        std::string msg1 = R"({"commands" : [{"command" : "ColorMode", "args" : {"ColorMode" : "dark"}},
+            {"command" : "Orientation", "args" : {"Orientation" : "landscape"}},
+            {"command" : "FontSelect", "args" : {"FontSelect" : true}}]})";
+        Json2::Value args1 = JsonReader::ParseJsonData2(msg1);
+        BatchCommand command1(CommandLine::CommandType::SET, args1, *socket);
+        // the sub commands are built once by the validation and run by RunSet
+        EXPECT_TRUE(command1.IsSetArgValid());
+        EXPECT_EQ(command1.subCommands.size(), 3); // 3: the settings of the batch
+        command1.RunSet();
+        EXPECT_TRUE(command1.subCommands.empty());
+        EXPECT_EQ(JsAppImpl::GetInstance().colorMode, "dark");
+        EXPECT_EQ(JsAppImpl::GetInstance().orientation, "landscape");
+        EXPECT_FALSE(JsAppImpl::GetInstance().isSettingsBatch);
+        Json2::Value result = command1.commandResult["result"];
+        EXPECT_TRUE(result["ColorMode"].AsBool());
+        EXPECT_TRUE(result["Orientation"].AsBool());
+        EXPECT_TRUE(result["FontSelect"].AsBool());
+        // one invalid setting and none is applied
+        std::string msg2 = R"({"commands" : [{"command" : "ColorMode", "args" : {"ColorMode" : "light"}},
+            {"command" : "Orientation", "args" : {"Orientation" : "upside"}}]})";
+        Json2::Value args2 = JsonReader::ParseJsonData2(msg2);
+        BatchCommand command2(CommandLine::CommandType::SET, args2, *socket);
+        command2.CheckAndRun();
+        EXPECT_EQ(JsAppImpl::GetInstance().colorMode, "dark");
+        // twice the same, not a setting, not a list, empty
+        std::string msg3 = R"({"commands" : [{"command" : "Language", "args" : {"Language" : "en_US"}},
+            {"command" : "Language", "args" : {"Language" : "zh_CN"}}]})";
+        Json2::Value args3 = JsonReader::ParseJsonData2(msg3);
+        BatchCommand command3(CommandLine::CommandType::SET, args3, *socket);
+        EXPECT_FALSE(command3.IsSetArgValid());
+        std::string msg4 = R"({"commands" : [{"command" : "LoadDocument", "args" : {}}]})";
+        Json2::Value args4 = JsonReader::ParseJsonData2(msg4);
+        BatchCommand command4(CommandLine::CommandType::SET, args4, *socket);
+        EXPECT_FALSE(command4.IsSetArgValid());
+        std::string msg5 = R"({"commands" : {"command" : "ColorMode"}})";
+        Json2::Value args5 = JsonReader::ParseJsonData2(msg5);
+        BatchCommand command5(CommandLine::CommandType::SET, args5, *socket);
+        EXPECT_FALSE(command5.IsSetArgValid());
+        std::string msg6 = R"({"commands" : []})";
+        Json2::Value args6 = JsonReader::ParseJsonData2(msg6);
+        BatchCommand command6(CommandLine::CommandType::SET, args6, *socket);
+        EXPECT_FALSE(command6.IsSetArgValid());
+    }
+
+    TEST_F(CommandLineTest, EncodeResultTest)
+    {
+        Json2::Value result = JsonReader::CreateObject();
+        result.Add("version", "1.0.1");
+        result.Add("command", "ColorMode");
+        result.Add("result", true);
+        CommandReply reply;
+        CommandLine::EncodeResult(result, "ColorMode", false, 0, reply);
+        EXPECT_EQ(reply.data, R"({"version":"1.0.1","command":"ColorMode","result":true})");
+        EXPECT_FALSE(reply.isDeflated);
+        // the shared reply of SendResult keeps its buffer from one command to the next
+        Json2::Value args = JsonReader::ParseJsonData2(R"({"ColorMode" : "dark"})");
+        ColorModeCommand command(CommandLine::CommandType::SET, args, *socket);
+        command.SetCommandName("ColorMode");
+        command.CheckAndRun();
+        const char* data = CommandLine::sharedReply.data.data();
+        EXPECT_EQ(JsonReader::ParseJsonData2(CommandLine::sharedReply.data)["command"].AsString(), "ColorMode");
+        command.CheckAndRun();
+        EXPECT_EQ(CommandLine::sharedReply.data.data(), data);
+    }
 }
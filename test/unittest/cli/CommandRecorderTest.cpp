@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "CommandRecorder.h"
+
+namespace {
+    std::vector<std::string> ReadLines(const std::string& path)
+    {
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    TEST(CommandRecorderTest, EncodeDecodeTest)
+    {
+        CommandRecord message;
+        message.time = 5000000000; // 5000000000: us, beyond int32
+        message.data = "{\"type\":\"action\",\n\"command\":\"MousePress\"}";
+        message.requestId = 4000000000; // 4000000000: frame request id beyond int32
+        CommandRecord decoded;
+        ASSERT_TRUE(CommandRecorder::Decode(CommandRecorder::Encode(message), decoded));
+        EXPECT_EQ(decoded.time, message.time);
+        EXPECT_EQ(decoded.data, message.data);
+        EXPECT_EQ(decoded.requestId, message.requestId);
+        EXPECT_FALSE(decoded.isInputEvent);
+        // one record is one line
+        EXPECT_EQ(CommandRecorder::Encode(message).find('\n'), std::string::npos);
+
+        CommandRecord inputEvent;
+        inputEvent.time = 12; // 12: us
+        inputEvent.data = std::string("\x01\x00\xff\x10", 4); // 4: binary payload
+        inputEvent.isInputEvent = true;
+        ASSERT_TRUE(CommandRecorder::Decode(CommandRecorder::Encode(inputEvent), decoded));
+        EXPECT_TRUE(decoded.isInputEvent);
+        EXPECT_EQ(decoded.data, inputEvent.data);
+        EXPECT_EQ(decoded.requestId, 0);
+
+        EXPECT_FALSE(CommandRecorder::Decode("", decoded));
+        EXPECT_FALSE(CommandRecorder::Decode("[]", decoded));
+        EXPECT_FALSE(CommandRecorder::Decode(R"({"message":"{}"})", decoded));
+        EXPECT_FALSE(CommandRecorder::Decode(R"({"time":1})", decoded));
+        EXPECT_FALSE(CommandRecorder::Decode(R"({"time":1,"message":"{}","requestId":-1})", decoded));
+        EXPECT_FALSE(CommandRecorder::Decode(R"({"time":1,"inputEvent":"!!"})", decoded));
+    }
+
+    TEST(CommandRecorderTest, RecordTest)
+    {
+        CommandRecorder& recorder = CommandRecorder::GetInstance();
+        std::string path = "CommandRecorderTest.rec";
+        recorder.RecordMessage("dropped", 0);
+        ASSERT_TRUE(recorder.Start(path));
+        EXPECT_TRUE(recorder.IsRecording());
+        recorder.RecordMessage(R"({"type":"get","command":"CurrentRouter","version":"1.0.1"})", 0);
+        recorder.RecordInputEvent(7, std::string("\x02\x03", 2)); // 7: frame request id, 2: payload size
+        recorder.Stop();
+        EXPECT_FALSE(recorder.IsRecording());
+        recorder.RecordMessage("dropped", 0);
+        std::vector<std::string> lines = ReadLines(path);
+        ASSERT_EQ(lines.size(), 2); // 2: the records made while recording
+        CommandRecord first;
+        CommandRecord second;
+        ASSERT_TRUE(CommandRecorder::Decode(lines[0], first));
+        ASSERT_TRUE(CommandRecorder::Decode(lines[1], second));
+        EXPECT_EQ(first.data, R"({"type":"get","command":"CurrentRouter","version":"1.0.1"})");
+        EXPECT_TRUE(second.isInputEvent);
+        EXPECT_EQ(second.requestId, 7); // 7: frame request id
+        EXPECT_LE(first.time, second.time);
+        std::remove(path.c_str());
+        EXPECT_FALSE(recorder.Start("/nonexistent/dir/CommandRecorderTest.rec"));
+        EXPECT_FALSE(recorder.IsRecording());
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "CommandReplayer.h"
+
+namespace {
+    const std::string RECORDING_PATH = "CommandReplayerTest.rec";
+
+    void WriteRecording(const std::vector<CommandRecord>& records)
+    {
+        std::ofstream file(RECORDING_PATH);
+        for (const CommandRecord& record : records) {
+            file << CommandRecorder::Encode(record) << '\n';
+        }
+        file << "not a record\n";
+    }
+
+    CommandRecord MakeRecord(int64_t time, const std::string& command)
+    {
+        CommandRecord record;
+        record.time = time;
+        record.data = R"({"type":"get","command":")" + command + R"(","version":"1.0.1"})";
+        return record;
+    }
+
+    TEST(CommandReplayerTest, LoadTest)
+    {
+        CommandReplayer& replayer = CommandReplayer::GetInstance();
+        EXPECT_FALSE(replayer.Load("CommandReplayerTest.missing"));
+        WriteRecording({ MakeRecord(0, "CurrentRouter"), MakeRecord(10, "LoadDocument") });
+        ASSERT_TRUE(replayer.Load(RECORDING_PATH));
+        EXPECT_EQ(replayer.records.size(), 2); // 2: the valid lines
+        EXPECT_EQ(replayer.skippedCount, 1);
+        EXPECT_FALSE(replayer.IsReplaying());
+        EXPECT_EQ(replayer.GetNextTimeout(), -1);
+        std::remove(RECORDING_PATH.c_str());
+    }
+
+    TEST(CommandReplayerTest, BackToBackTest)
+    {
+        CommandReplayer& replayer = CommandReplayer::GetInstance();
+        WriteRecording({ MakeRecord(0, "CurrentRouter"), MakeRecord(60000000, "LoadDocument") }); // 60 s later
+        ASSERT_TRUE(replayer.Load(RECORDING_PATH));
+        replayer.Start(0);
+        EXPECT_EQ(replayer.GetNextTimeout(), 0);
+        CommandRecord record;
+        // only when the command before has run
+        EXPECT_FALSE(replayer.Next(record, false));
+        ASSERT_TRUE(replayer.Next(record, true));
+        EXPECT_EQ(record.time, 0);
+        ASSERT_TRUE(replayer.Next(record, true));
+        EXPECT_EQ(record.time, 60000000); // 60000000: not waited for
+        EXPECT_TRUE(replayer.IsDrained());
+        EXPECT_FALSE(replayer.Next(record, true));
+        EXPECT_EQ(replayer.GetNextTimeout(), -1);
+        Json2::Value report = JsonReader::CreateObject();
+        replayer.GetReport(report);
+        EXPECT_EQ(report["replayed"].AsInt(), 2); // 2: both records
+        EXPECT_EQ(report["skipped"].AsInt(), 1);
+        EXPECT_EQ(report["recordedMs"].AsInt(), 60000); // 60000: ms of the recording
+        EXPECT_TRUE(report["stats"].IsMember("histograms"));
+        std::string reportPath = "CommandReplayerTest.json";
+        EXPECT_TRUE(replayer.Finish(reportPath));
+        EXPECT_FALSE(replayer.IsReplaying());
+        EXPECT_FALSE(replayer.Finish(reportPath));
+        Json2::Value written = JsonReader::ParseJsonData2(JsonReader::ReadFile(reportPath));
+        EXPECT_EQ(written["replayed"].AsInt(), 2); // 2: both records
+        std::remove(reportPath.c_str());
+        std::remove(RECORDING_PATH.c_str());
+    }
+
+    TEST(CommandReplayerTest, TimingTest)
+    {
+        CommandReplayer& replayer = CommandReplayer::GetInstance();
+        // 2 s and 1 h into the recording
+        WriteRecording({ MakeRecord(2000000, "CurrentRouter"), MakeRecord(3600000000, "LoadDocument") });
+        ASSERT_TRUE(replayer.Load(RECORDING_PATH));
+        replayer.Start(100); // 100: times as fast, the first one is due after 20 ms
+        int64_t timeout = replayer.GetNextTimeout();
+        EXPECT_GT(timeout, 0);
+        EXPECT_LE(timeout, 20); // 20: ms
+        CommandRecord record;
+        auto start = std::chrono::steady_clock::now();
+        while (!replayer.Next(record, true)) {
+            ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5)); // 5: s
+        }
+        EXPECT_EQ(record.time, 2000000); // 2000000: the first record
+        EXPECT_GT(replayer.GetNextTimeout(), 30000); // 30000: ms, the second is 36 s away
+        EXPECT_FALSE(replayer.Next(record, true));
+        EXPECT_FALSE(replayer.IsDrained());
+        replayer.isReplaying = false;
+        std::remove(RECORDING_PATH.c_str());
+    }
+}
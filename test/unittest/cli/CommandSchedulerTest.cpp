@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "CommandScheduler.h"
+
+namespace {
+    ScheduledCommand MakeCommand(const std::string& name,
+        CommandLine::CommandType type = CommandLine::CommandType::SET, uint32_t requestId = 0)
+    {
+        ScheduledCommand command;
+        command.name = name;
+        command.type = type;
+        command.message = JsonReader::CreateObject();
+        command.message.Add("command", name.c_str());
+        command.requestId = requestId;
+        return command;
+    }
+
+    void Push(ScheduledCommand&& command)
+    {
+        std::vector<ScheduledCommand> cancelled;
+        CommandScheduler::GetInstance().Push(std::move(command), cancelled);
+        EXPECT_TRUE(cancelled.empty());
+    }
+
+    TEST(CommandSchedulerTest, GetLaneTest)
+    {
+        EXPECT_EQ(CommandScheduler::GetLane("MousePress"), CommandScheduler::Lane::INPUT);
+        EXPECT_EQ(CommandScheduler::GetLane("KeyPress"), CommandScheduler::Lane::INPUT);
+        EXPECT_EQ(CommandScheduler::GetLane("ColorMode"), CommandScheduler::Lane::CONTROL);
+        EXPECT_EQ(CommandScheduler::GetLane("unknown"), CommandScheduler::Lane::CONTROL);
+        EXPECT_EQ(CommandScheduler::GetLane("LoadDocument"), CommandScheduler::Lane::BULK);
+        EXPECT_EQ(CommandScheduler::GetLane("inspector"), CommandScheduler::Lane::BULK);
+        EXPECT_EQ(std::string(CommandScheduler::GetLaneName(CommandScheduler::Lane::INPUT)), "input");
+        EXPECT_EQ(std::string(CommandScheduler::GetLaneName(CommandScheduler::Lane::COUNT)), "");
+    }
+
+    TEST(CommandSchedulerTest, PriorityTest)
+    {
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        scheduler.Clear();
+        Push(MakeCommand("LoadDocument"));
+        Push(MakeCommand("ColorMode"));
+        Push(MakeCommand("MousePress", CommandLine::CommandType::ACTION));
+        Push(MakeCommand("MouseRelease", CommandLine::CommandType::ACTION));
+        std::vector<std::string> order;
+        ScheduledCommand command;
+        while (scheduler.Pop(command)) {
+            order.push_back(command.name);
+            EXPECT_EQ(command.message["command"].AsString(), command.name);
+        }
+        // input overtakes, control and bulk keep their arrival order
+        std::vector<std::string> expected = { "MousePress", "MouseRelease", "LoadDocument", "ColorMode" };
+        EXPECT_EQ(order, expected);
+        EXPECT_TRUE(scheduler.IsEmpty());
+    }
+
+    TEST(CommandSchedulerTest, LayoutChangeTest)
+    {
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        scheduler.Clear();
+        Push(MakeCommand("ColorMode"));
+        Push(MakeCommand("ResolutionSwitch"));
+        Push(MakeCommand("MousePress", CommandLine::CommandType::ACTION));
+        Push(MakeCommand("Orientation"));
+        Push(MakeCommand("LoadDocument"));
+        Push(MakeCommand("MouseRelease", CommandLine::CommandType::ACTION));
+        std::vector<std::string> order;
+        ScheduledCommand command;
+        while (scheduler.Pop(command)) {
+            order.push_back(command.name);
+        }
+        // input waits for the layout changes queued before it, not for the ones after it
+        std::vector<std::string> expected = { "ColorMode", "ResolutionSwitch", "MousePress", "Orientation",
+            "MouseRelease", "LoadDocument" };
+        EXPECT_EQ(order, expected);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::INPUT), 0);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 0);
+    }
+
+    TEST(CommandSchedulerTest, SupersedeTest)
+    {
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        scheduler.Clear();
+        uint64_t cancelledCount = scheduler.cancelledCount.Get();
+        Push(MakeCommand("ResolutionSwitch", CommandLine::CommandType::SET, 1));
+        Push(MakeCommand("ReloadRuntimePage"));
+        std::vector<ScheduledCommand> cancelled;
+        scheduler.Push(MakeCommand("ResolutionSwitch", CommandLine::CommandType::SET, 3), cancelled); // 3: request
+        ASSERT_EQ(cancelled.size(), 1);
+        EXPECT_EQ(cancelled[0].name, "ResolutionSwitch");
+        EXPECT_EQ(cancelled[0].requestId, 1);
+        EXPECT_EQ(scheduler.cancelledCount.Get(), cancelledCount + 1);
+        // only the newest of the same command and type is superseded
+        cancelled.clear();
+        scheduler.Push(MakeCommand("ReloadRuntimePage"), cancelled);
+        scheduler.Push(MakeCommand("ResolutionSwitch", CommandLine::CommandType::GET), cancelled);
+        EXPECT_TRUE(cancelled.empty());
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 4); // 4: the commands left
+        ScheduledCommand command;
+        ASSERT_TRUE(scheduler.Pop(command));
+        EXPECT_EQ(command.name, "ReloadRuntimePage");
+        ASSERT_TRUE(scheduler.Pop(command));
+        EXPECT_EQ(command.requestId, 3); // 3: the newer switch took the place at the end
+        scheduler.Clear();
+    }
+
+    TEST(CommandSchedulerTest, CancelTest)
+    {
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        scheduler.Clear();
+        uint64_t cancelledCount = scheduler.cancelledCount.Get();
+        ScheduledCommand tree = MakeCommand("inspector", CommandLine::CommandType::GET);
+        tree.clientRequestId = "tree-1";
+        Push(std::move(tree));
+        Push(MakeCommand("ColorMode"));
+        ScheduledCommand cancelled;
+        EXPECT_FALSE(scheduler.Cancel("", cancelled));
+        EXPECT_FALSE(scheduler.Cancel("tree-2", cancelled));
+        ASSERT_TRUE(scheduler.Cancel("tree-1", cancelled));
+        EXPECT_EQ(cancelled.name, "inspector");
+        EXPECT_EQ(scheduler.cancelledCount.Get(), cancelledCount + 1);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 0);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::CONTROL), 1);
+        EXPECT_FALSE(scheduler.Cancel("tree-1", cancelled));
+        scheduler.Clear();
+    }
+
+    TEST(CommandSchedulerTest, DepthTest)
+    {
+        CommandScheduler& scheduler = CommandScheduler::GetInstance();
+        scheduler.Clear();
+        Push(MakeCommand("MouseMove", CommandLine::CommandType::ACTION));
+        Push(MakeCommand("MouseMove", CommandLine::CommandType::ACTION));
+        Push(MakeCommand("Language"));
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::INPUT), 2); // 2: both moves are kept
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::CONTROL), 1);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::BULK), 0);
+        EXPECT_EQ(scheduler.GetDepth(CommandScheduler::Lane::COUNT), 0);
+        PerfStats::Snapshot snapshot = PerfStats::GetInstance().TakeSnapshot();
+        EXPECT_EQ(snapshot.gauges[PerfMetric::COMMAND_QUEUE_INPUT], 2); // 2: both moves
+        EXPECT_EQ(snapshot.gauges[PerfMetric::COMMAND_QUEUE_CONTROL], 1);
+        scheduler.Clear();
+        EXPECT_TRUE(scheduler.IsEmpty());
+        EXPECT_EQ(PerfStats::GetInstance().GetGauge(PerfMetric::COMMAND_QUEUE_INPUT).Get(), 0);
+    }
+}
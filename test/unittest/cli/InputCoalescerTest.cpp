@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+#include "gtest/gtest.h"
+#define private public
+#define protected public
+#include "CppTimerManager.h"
+#include "InputCoalescer.h"
+#include "MockGlobalResult.h"
+#include "MouseInputImpl.h"
+
+namespace {
+    InputEventParams CreateEvent(int type, double x)
+    {
+        InputEventParams params;
+        params.x = x;
+        params.y = 100; // 100 is test y
+        params.type = type;
+        params.button = -1;
+        params.action = 0;
+        params.sourceType = 2; // 2 is touch
+        params.sourceTool = 1; // 1 is finger
+        params.name = "InputCoalescerTest";
+        return params;
+    }
+
+    class InputCoalescerTest : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            InputCoalescer::GetInstance().SetFlushInterval(InputCoalescer::DEFAULT_FLUSH_INTERVAL);
+            // make sure the first move is not throttled by an earlier test
+            std::this_thread::sleep_for(std::chrono::milliseconds(InputCoalescer::DEFAULT_FLUSH_INTERVAL));
+        }
+
+        void TearDown() override
+        {
+            InputCoalescer::GetInstance().SetFlushInterval(0);
+        }
+    };
+
+    TEST_F(InputCoalescerTest, MergeMoveTest)
+    {
+        InputCoalescer& coalescer = InputCoalescer::GetInstance();
+        InputEventParams move1 = CreateEvent(InputCoalescer::TOUCH_TYPE_MOVE, 10); // 10 is test x
+        g_dispatchOsTouchEvent = false;
+        coalescer.Push(move1);
+        EXPECT_TRUE(g_dispatchOsTouchEvent); // the first move goes out at once
+        g_dispatchOsTouchEvent = false;
+        InputEventParams move2 = CreateEvent(InputCoalescer::TOUCH_TYPE_MOVE, 20); // 20 is test x
+        InputEventParams move3 = CreateEvent(InputCoalescer::TOUCH_TYPE_MOVE, 30); // 30 is test x
+        coalescer.Push(move2);
+        coalescer.Push(move3);
+        EXPECT_FALSE(g_dispatchOsTouchEvent);
+        EXPECT_TRUE(coalescer.hasPendingEvent);
+        EXPECT_TRUE(coalescer.flushTimer.IsRunning());
+        std::this_thread::sleep_for(std::chrono::milliseconds(InputCoalescer::DEFAULT_FLUSH_INTERVAL * 2));
+        CppTimerManager::GetTimerManager().RunTimerTick();
+        EXPECT_TRUE(g_dispatchOsTouchEvent);
+        EXPECT_EQ(MouseInputImpl::GetInstance().mouseXPosition, 30); // only the latest position is sent
+        EXPECT_FALSE(coalescer.hasPendingEvent);
+        EXPECT_FALSE(coalescer.flushTimer.IsRunning());
+    }
+
+    TEST_F(InputCoalescerTest, KeepOrderTest)
+    {
+        InputCoalescer& coalescer = InputCoalescer::GetInstance();
+        InputEventParams move1 = CreateEvent(InputCoalescer::TOUCH_TYPE_MOVE, 10); // 10 is test x
+        InputEventParams move2 = CreateEvent(InputCoalescer::TOUCH_TYPE_MOVE, 20); // 20 is test x
+        coalescer.Push(move1);
+        coalescer.Push(move2);
+        EXPECT_TRUE(coalescer.hasPendingEvent);
+        // a release flushes the pending move before it is dispatched itself
+        InputEventParams release = CreateEvent(1, 40); // 1 is release, 40 is test x
+        coalescer.Push(release);
+        EXPECT_FALSE(coalescer.hasPendingEvent);
+        EXPECT_EQ(MouseInputImpl::GetInstance().mouseXPosition, 40); // 40 is test x
+        EXPECT_EQ(MouseInputImpl::GetInstance().touchAction, 1);
+    }
+
+    TEST_F(InputCoalescerTest, StateChangeTest)
+    {
+        InputCoalescer& coalescer = InputCoalescer::GetInstance();
+        InputEventParams point1 = CreateEvent(InputCoalescer::TOUCH_TYPE_POINT_EVENT, 10); // 10 is test x
+        InputEventParams point2 = CreateEvent(InputCoalescer::TOUCH_TYPE_POINT_EVENT, 20); // 20 is test x
+        coalescer.Push(point1);
+        coalescer.Push(point2);
+        EXPECT_TRUE(coalescer.hasPendingEvent);
+        // another pressed button is not merged into the pending event
+        InputEventParams point3 = CreateEvent(InputCoalescer::TOUCH_TYPE_POINT_EVENT, 30); // 30 is test x
+        point3.pressedBtnsVec.insert(0);
+        coalescer.Push(point3);
+        EXPECT_EQ(MouseInputImpl::GetInstance().mouseXPosition, 20); // 20 is the flushed x
+        EXPECT_TRUE(coalescer.hasPendingEvent);
+        coalescer.Flush();
+        EXPECT_EQ(MouseInputImpl::GetInstance().mouseXPosition, 30); // 30 is test x
+    }
+}
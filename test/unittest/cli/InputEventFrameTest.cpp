@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <string>
+#include "gtest/gtest.h"
+#define private public
+#define protected public
+#include "CommandLineInterface.h"
+#include "InputCoalescer.h"
+#include "InputEventFrame.h"
+#include "MockGlobalResult.h"
+#include "MouseInputImpl.h"
+
+namespace {
+    InputEventRecord CreateMoveRecord()
+    {
+        InputEventRecord record = {};
+        record.type = InputEventFrame::TYPE_MOVE;
+        record.button = -1;
+        record.sourceType = 2; // 2 is touch
+        record.sourceTool = 1; // 1 is finger
+        record.pressedButtons = (1u << 0) | (1u << 3);
+        record.x = 365.5;
+        record.y = 1076.25;
+        record.axisCount = 2; // 2 axis values
+        record.axisValues[0] = 0.5;
+        record.axisValues[1] = -1.5;
+        return record;
+    }
+
+    TEST(InputEventFrameTest, EncodeDecodeTest)
+    {
+        InputEventRecord record = CreateMoveRecord();
+        uint8_t buffer[InputEventFrame::RECORD_SIZE];
+        InputEventFrame::Encode(record, buffer);
+        InputEventRecord decoded = {};
+        EXPECT_TRUE(InputEventFrame::Decode(buffer, sizeof(buffer), decoded));
+        EXPECT_EQ(decoded.type, record.type);
+        EXPECT_EQ(decoded.button, record.button);
+        EXPECT_EQ(decoded.pressedButtons, record.pressedButtons);
+        EXPECT_EQ(decoded.x, record.x);
+        EXPECT_EQ(decoded.y, record.y);
+        EXPECT_EQ(decoded.axisCount, record.axisCount);
+        EXPECT_EQ(decoded.axisValues[1], record.axisValues[1]);
+        // truncated record
+        EXPECT_FALSE(InputEventFrame::Decode(buffer, sizeof(buffer) - 1, decoded));
+    }
+
+    TEST(InputEventFrameTest, DispatchTest)
+    {
+        InputCoalescer::GetInstance().SetFlushInterval(0);
+        InputEventRecord record = CreateMoveRecord();
+        g_dispatchOsTouchEvent = false;
+        EXPECT_TRUE(InputEventFrame::Dispatch(record));
+        EXPECT_TRUE(g_dispatchOsTouchEvent);
+        MouseInputImpl& input = MouseInputImpl::GetInstance();
+        EXPECT_EQ(input.mouseXPosition, record.x);
+        EXPECT_EQ(input.touchAction, record.type);
+        EXPECT_EQ(input.pressedBtnsVec.size(), 2); // button 0 and 3
+        EXPECT_EQ(input.axisValuesArr.size(), record.axisCount);
+    }
+
+    TEST(InputEventFrameTest, DispatchTest_Err)
+    {
+        InputEventRecord record = CreateMoveRecord();
+        record.x = -1;
+        g_dispatchOsTouchEvent = false;
+        EXPECT_FALSE(InputEventFrame::Dispatch(record));
+        record = CreateMoveRecord();
+        record.y = NAN;
+        EXPECT_FALSE(InputEventFrame::Dispatch(record));
+        record = CreateMoveRecord();
+        record.button = -2; // button must >= -1
+        EXPECT_FALSE(InputEventFrame::Dispatch(record));
+        record = CreateMoveRecord();
+        record.axisCount = InputEventRecord::MAX_AXIS_COUNT + 1;
+        EXPECT_FALSE(InputEventFrame::Dispatch(record));
+        record = CreateMoveRecord();
+        record.type = 3; // 3: no such touch type
+        EXPECT_FALSE(InputEventFrame::Dispatch(record));
+        EXPECT_FALSE(g_dispatchOsTouchEvent);
+    }
+
+    TEST(InputEventFrameTest, ProcessInputEventFrameTest)
+    {
+        CommandLineInterface::GetInstance().InitPipe("phone");
+        InputCoalescer::GetInstance().SetFlushInterval(0);
+        InputEventRecord record = CreateMoveRecord();
+        uint8_t buffer[InputEventFrame::RECORD_SIZE];
+        InputEventFrame::Encode(record, buffer);
+        std::string payload(reinterpret_cast<const char*>(buffer), sizeof(buffer));
+        // no reply unless requested
+        g_output = false;
+        g_dispatchOsTouchEvent = false;
+        CommandLineInterface::GetInstance().ProcessInputEventFrame(1, payload);
+        EXPECT_TRUE(g_dispatchOsTouchEvent);
+        EXPECT_FALSE(g_output);
+        record.flags = InputEventFrame::FLAG_REPLY;
+        InputEventFrame::Encode(record, buffer);
+        payload.assign(reinterpret_cast<const char*>(buffer), sizeof(buffer));
+        CommandLineInterface::GetInstance().ProcessInputEventFrame(1, payload);
+        EXPECT_TRUE(g_output);
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+#include "gtest/gtest.h"
+#define private public
+#include "CppTimerManager.h"
+#include "InspectorNotifier.h"
+
+namespace {
+    int g_refreshCount = 0;
+
+    void OnRefresh()
+    {
+        g_refreshCount++;
+    }
+
+    class InspectorNotifierTest : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            InspectorNotifier& notifier = InspectorNotifier::GetInstance();
+            notifier.SetRefreshCallback(OnRefresh);
+            notifier.SetDebounceTime(debounceTime);
+            notifier.SetMaxRate(maxRate);
+            notifier.refreshTimer.Stop();
+            notifier.isPending = false;
+            notifier.lastRefreshTime = std::chrono::steady_clock::time_point();
+            g_refreshCount = 0;
+        }
+
+        void TearDown() override
+        {
+            InspectorNotifier& notifier = InspectorNotifier::GetInstance();
+            notifier.SetRefreshCallback(nullptr);
+            notifier.SetDebounceTime(InspectorNotifier::DEFAULT_DEBOUNCE_TIME);
+            notifier.SetMaxRate(InspectorNotifier::DEFAULT_MAX_RATE);
+        }
+
+        void WaitAndTick(int64_t time) const
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(time));
+            CppTimerManager::GetTimerManager().RunTimerTick();
+        }
+
+        const int64_t debounceTime = 20; // 20ms debounce
+        const uint32_t maxRate = 10; // refresh at most every 100ms
+    };
+
+    TEST_F(InspectorNotifierTest, DebounceTest)
+    {
+        InspectorNotifier& notifier = InspectorNotifier::GetInstance();
+        notifier.OnFrameUpdated();
+        EXPECT_TRUE(notifier.refreshTimer.IsRunning());
+        EXPECT_EQ(g_refreshCount, 0);
+        WaitAndTick(debounceTime * 2);
+        EXPECT_EQ(g_refreshCount, 1);
+        EXPECT_FALSE(notifier.refreshTimer.IsRunning());
+        // no frame, no refresh
+        WaitAndTick(debounceTime * 2);
+        EXPECT_EQ(g_refreshCount, 1);
+    }
+
+    TEST_F(InspectorNotifierTest, MaxRateTest)
+    {
+        InspectorNotifier& notifier = InspectorNotifier::GetInstance();
+        // frames faster than the debounce time still refresh once per max rate interval
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(350)) { // 350ms animation
+            notifier.OnFrameUpdated();
+            WaitAndTick(debounceTime / 4); // 4 frames per debounce time
+        }
+        EXPECT_GE(g_refreshCount, 2); // 2 refreshes at least in 350ms
+        EXPECT_LE(g_refreshCount, 4); // 4 refreshes at most in 350ms
+    }
+
+    TEST_F(InspectorNotifierTest, ConfigTest_Err)
+    {
+        InspectorNotifier& notifier = InspectorNotifier::GetInstance();
+        EXPECT_FALSE(notifier.SetDebounceTime(-1));
+        EXPECT_FALSE(notifier.SetDebounceTime(InspectorNotifier::MAX_DEBOUNCE_TIME + 1));
+        EXPECT_FALSE(notifier.SetMaxRate(0));
+        EXPECT_FALSE(notifier.SetMaxRate(InspectorNotifier::MAX_RATE + 1));
+        EXPECT_EQ(notifier.GetDebounceTime(), debounceTime);
+        EXPECT_EQ(notifier.GetMaxRate(), maxRate);
+    }
+}
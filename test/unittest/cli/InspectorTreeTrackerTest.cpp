@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+#include <string>
+#include "gtest/gtest.h"
+#define private public
+#include "InspectorTreeTracker.h"
+
+namespace {
+    class InspectorTreeTrackerTest : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            InspectorTreeTracker& tracker = InspectorTreeTracker::GetInstance();
+            tracker.baseline.clear();
+            tracker.baselineHash = std::hash<std::string>()(std::string());
+            tracker.baselineSize = 0;
+            tracker.treeVersion = 0;
+            tracker.incremental = false;
+        }
+    };
+
+    TEST_F(InspectorTreeTrackerTest, FullTreeTest)
+    {
+        InspectorTreeTracker& tracker = InspectorTreeTracker::GetInstance();
+        std::string tree = R"({"type":"root","children":[{"id":1}]})";
+        Json2::Value notification = JsonReader::CreateObject();
+        EXPECT_TRUE(tracker.Update(tree, notification));
+        EXPECT_EQ(notification["command"].AsString(), "inspector");
+        EXPECT_EQ(notification["result"].AsString(), tree);
+        // older IDEs only get the full tree
+        EXPECT_FALSE(notification.IsMember("treeVersion"));
+        Json2::Value unchanged = JsonReader::CreateObject();
+        EXPECT_FALSE(tracker.Update(tree, unchanged));
+        EXPECT_EQ(tracker.GetTreeVersion(), 1);
+        // only the hash of the tree is kept outside incremental mode
+        EXPECT_TRUE(tracker.baseline.empty());
+    }
+
+    TEST_F(InspectorTreeTrackerTest, PatchTest)
+    {
+        InspectorTreeTracker& tracker = InspectorTreeTracker::GetInstance();
+        tracker.SetIncremental(true);
+        std::string tree = R"({"type":"root","children":[{"id":1,"text":"a long enough text"},{"id":2}]})";
+        Json2::Value snapshot = JsonReader::CreateObject();
+        tracker.Resync(tree, -1, snapshot);
+        EXPECT_EQ(snapshot["treeVersion"].AsUInt(), 1);
+        EXPECT_EQ(snapshot["tree"].AsString(), tree);
+
+        std::string newTree = R"({"type":"root","children":[{"id":1,"text":"a long enough text"},{"id":3}]})";
+        Json2::Value notification = JsonReader::CreateObject();
+        EXPECT_TRUE(tracker.Update(newTree, notification));
+        EXPECT_EQ(notification["command"].AsString(), "inspectorPatch");
+        EXPECT_EQ(notification["baseVersion"].AsUInt(), 1);
+        EXPECT_EQ(notification["treeVersion"].AsUInt(), 2);
+        EXPECT_EQ(notification["result"].ToString(),
+            "[{\"op\":\"replace\",\"path\":\"/children/1/id\",\"value\":3}]");
+    }
+
+    TEST_F(InspectorTreeTrackerTest, LargePatchTest)
+    {
+        InspectorTreeTracker& tracker = InspectorTreeTracker::GetInstance();
+        tracker.SetIncremental(true);
+        Json2::Value snapshot = JsonReader::CreateObject();
+        tracker.Resync("[1,2]", -1, snapshot);
+        // the patch would be larger than the new tree
+        Json2::Value notification = JsonReader::CreateObject();
+        EXPECT_TRUE(tracker.Update("[3,4]", notification));
+        EXPECT_EQ(notification["command"].AsString(), "inspector");
+        EXPECT_EQ(notification["treeVersion"].AsUInt(), 2);
+        EXPECT_EQ(notification["result"].AsString(), "[3,4]");
+        // trees that can not be parsed are sent in full as well
+        Json2::Value invalid = JsonReader::CreateObject();
+        EXPECT_TRUE(tracker.Update("null tree", invalid));
+        EXPECT_EQ(invalid["command"].AsString(), "inspector");
+    }
+
+    TEST_F(InspectorTreeTrackerTest, ResyncTest)
+    {
+        InspectorTreeTracker& tracker = InspectorTreeTracker::GetInstance();
+        tracker.SetIncremental(true);
+        std::string tree = R"({"children":[]})";
+        Json2::Value notification = JsonReader::CreateObject();
+        EXPECT_TRUE(tracker.Update(tree, notification));
+        // client at the current version does not get the tree again
+        Json2::Value synchronized = JsonReader::CreateObject();
+        tracker.Resync(tree, 1, synchronized);
+        EXPECT_EQ(synchronized["treeVersion"].AsUInt(), 1);
+        EXPECT_FALSE(synchronized.IsMember("tree"));
+        // version mismatch gets a full snapshot
+        Json2::Value mismatch = JsonReader::CreateObject();
+        tracker.Resync(tree, 0, mismatch);
+        EXPECT_EQ(mismatch["treeVersion"].AsUInt(), 1);
+        EXPECT_EQ(mismatch["tree"].AsString(), tree);
+        // a changed tree moves the baseline so no patch follows for it
+        std::string newTree = R"({"children":[{}]})";
+        Json2::Value changed = JsonReader::CreateObject();
+        tracker.Resync(newTree, 1, changed);
+        EXPECT_EQ(changed["treeVersion"].AsUInt(), 2);
+        EXPECT_EQ(changed["tree"].AsString(), newTree);
+        Json2::Value unchanged = JsonReader::CreateObject();
+        EXPECT_FALSE(tracker.Update(newTree, unchanged));
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+#include "gtest/gtest.h"
+#define private public
+#include "CommandLineInterface.h"
+#include "CppTimerManager.h"
+#include "MockGlobalResult.h"
+#include "PerfStatsPublisher.h"
+
+namespace {
+    class PerfStatsPublisherTest : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            CommandLineInterface::GetInstance().InitPipe("phone");
+            PerfStatsPublisher::GetInstance().Unsubscribe();
+        }
+
+        void TearDown() override
+        {
+            PerfStatsPublisher::GetInstance().Unsubscribe();
+        }
+
+        void WaitAndTick(int64_t time) const
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(time));
+            CppTimerManager::GetTimerManager().RunTimerTick();
+        }
+    };
+
+    TEST_F(PerfStatsPublisherTest, SubscribeTest)
+    {
+        PerfStatsPublisher& publisher = PerfStatsPublisher::GetInstance();
+        EXPECT_FALSE(publisher.Subscribe(PerfStatsPublisher::MIN_INTERVAL - 1));
+        EXPECT_FALSE(publisher.Subscribe(PerfStatsPublisher::MAX_INTERVAL + 1));
+        EXPECT_FALSE(publisher.IsSubscribed());
+        EXPECT_TRUE(publisher.Subscribe(PerfStatsPublisher::MIN_INTERVAL));
+        EXPECT_TRUE(publisher.IsSubscribed());
+        EXPECT_EQ(publisher.GetInterval(), PerfStatsPublisher::MIN_INTERVAL);
+        // the counts of the first push start from the subscription
+        PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_SENT).Add(5);
+        uint64_t sentFrames = PerfStats::GetInstance().GetCounter(PerfMetric::FRAME_SENT).Get();
+        EXPECT_EQ(sentFrames - publisher.lastSnapshot.counters[PerfMetric::FRAME_SENT], 5);
+        g_output = false;
+        WaitAndTick(PerfStatsPublisher::MIN_INTERVAL + 10); // 10: margin over the interval
+        EXPECT_TRUE(g_output);
+        EXPECT_EQ(publisher.lastSnapshot.counters[PerfMetric::FRAME_SENT], sentFrames);
+    }
+
+    TEST_F(PerfStatsPublisherTest, UnsubscribeTest)
+    {
+        PerfStatsPublisher& publisher = PerfStatsPublisher::GetInstance();
+        EXPECT_TRUE(publisher.Subscribe(PerfStatsPublisher::MIN_INTERVAL));
+        publisher.Unsubscribe();
+        EXPECT_FALSE(publisher.IsSubscribed());
+        g_output = false;
+        WaitAndTick(PerfStatsPublisher::MIN_INTERVAL + 10); // 10: margin over the interval
+        EXPECT_FALSE(g_output);
+    }
+}
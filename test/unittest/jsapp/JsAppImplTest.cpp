@@ -148,6 +148,35 @@ namespace {
         EXPECT_EQ(JsAppImpl::GetInstance().aceRunArgs.deviceHeight, 333);
     }
 
+    TEST_F(JsAppImplTest, SettingsBatchTest)
+    {
+        JsAppImpl::GetInstance().ability =
+            OHOS::Ace::Platform::AceAbility::CreateInstance(JsAppImpl::GetInstance().aceRunArgs);
+        g_surfaceChanged = false;
+        g_onConfigurationChanged = false;
+        JsAppImpl::GetInstance().BeginSettingsBatch();
+        JsAppImpl::GetInstance().ColorModeChanged("dark");
+        JsAppImpl::GetInstance().OrientationChanged("landscape");
+        JsAppImpl::GetInstance().OrientationChanged("portrait");
+        EXPECT_FALSE(g_onConfigurationChanged);
+        EXPECT_FALSE(g_surfaceChanged);
+        EXPECT_EQ(JsAppImpl::GetInstance().orientation, "portrait");
+        EXPECT_TRUE(JsAppImpl::GetInstance().isOrientationPending);
+        JsAppImpl::GetInstance().EndSettingsBatch();
+        EXPECT_TRUE(g_onConfigurationChanged);
+        EXPECT_TRUE(g_surfaceChanged);
+        EXPECT_FALSE(JsAppImpl::GetInstance().isSettingsBatch);
+        EXPECT_FALSE(JsAppImpl::GetInstance().isOrientationPending);
+        EXPECT_FALSE(JsAppImpl::GetInstance().isConfigurationPending);
+        // nothing pending, nothing reaches the engine
+        g_surfaceChanged = false;
+        g_onConfigurationChanged = false;
+        JsAppImpl::GetInstance().BeginSettingsBatch();
+        JsAppImpl::GetInstance().EndSettingsBatch();
+        EXPECT_FALSE(g_onConfigurationChanged);
+        EXPECT_FALSE(g_surfaceChanged);
+    }
+
     TEST_F(JsAppImplTest, ConvertResizeReasonTest)
     {
         EXPECT_EQ(JsAppImpl::GetInstance().ConvertResizeReason("undefined"),
@@ -207,6 +207,33 @@ namespace {
         EXPECT_EQ(retMap["libentry.so"], "src/mock/Libentry.mock.ets");
     }
 
+    TEST_F(StageContextTest, GetRouterMapTest)
+    {
+        std::vector<OHOS::Ide::RouterItem> items = OHOS::Ide::StageContext::GetInstance().GetRouterMap("aaa");
+        EXPECT_TRUE(items.empty());
+        WriteFile(testFile, R"({"routerMap":{"name":"page"}})");
+        items = OHOS::Ide::StageContext::GetInstance().GetRouterMap(testFile);
+        EXPECT_TRUE(items.empty());
+        WriteFile(testFile, R"({"routerMap":[{"name":"page"},]})");
+        items = OHOS::Ide::StageContext::GetInstance().GetRouterMap(testFile);
+        EXPECT_TRUE(items.empty());
+        WriteFile(testFile, R"({"module":{"name":"entry"},"routerMap":[{"name":"page1",
+            "pageSourceFile":"src/main/ets/pages/Page1.ets","buildFunction":"Page1Builder","name":"repeated",
+            "data":{"title":"one","count":1}}, "page2", {"name":"page2","ohmurl":"@normalized:N&&&entry/Page2&",
+            "bundleName":"com.example","moduleName":"entry","data":[]}]})");
+        items = OHOS::Ide::StageContext::GetInstance().GetRouterMap(testFile);
+        ASSERT_EQ(items.size(), 2); // 2: the object items
+        EXPECT_EQ(items[0].name, "page1");
+        EXPECT_EQ(items[0].pageSourceFile, "src/main/ets/pages/Page1.ets");
+        EXPECT_EQ(items[0].buildFunction, "Page1Builder");
+        EXPECT_EQ(items[0].data.size(), 1);
+        EXPECT_EQ(items[0].data["title"], "one");
+        EXPECT_EQ(items[1].ohmurl, "@normalized:N&&&entry/Page2&");
+        EXPECT_EQ(items[1].bundleName, "com.example");
+        EXPECT_EQ(items[1].moduleName, "entry");
+        EXPECT_TRUE(items[1].data.empty());
+    }
+
     TEST_F(StageContextTest, GetModuleBufferTest)
     {
         std::vector<uint8_t>* ret =
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "PerfOverlay.h"
+
+namespace {
+    constexpr uint8_t BACKGROUND = 0x80;
+
+    void Restart()
+    {
+        PerfOverlay::GetInstance().SetEnabled(false);
+        PerfOverlay::GetInstance().SetEnabled(true);
+    }
+
+    TEST(PerfOverlayTest, SetEnabledTest)
+    {
+        PerfOverlay::GetInstance().SetEnabled(true);
+        EXPECT_TRUE(PerfOverlay::IsEnabled());
+        PerfOverlay::GetInstance().SetEnabled(false);
+        EXPECT_FALSE(PerfOverlay::IsEnabled());
+    }
+
+    TEST(PerfOverlayTest, GetLinesTest)
+    {
+        PerfOverlay& overlay = PerfOverlay::GetInstance();
+        Restart();
+        overlay.OnFrameEncoded(12345); // 12345: 12.3 ms
+        overlay.OnFrameSent(2500); // 2500: 2.5 ms
+        overlay.OnFrameDropped();
+        overlay.OnFrameDropped();
+        std::vector<std::string> lines = overlay.GetLines();
+        ASSERT_EQ(lines.size(), 4); // 4: fps, encode, latency and dropped
+        EXPECT_EQ(lines[0], "FPS  0.0");
+        EXPECT_EQ(lines[1], "ENC  12.3MS");
+        EXPECT_EQ(lines[2], "LAT  2.5MS");
+        EXPECT_EQ(lines[3], "DROP 2"); // 3: the dropped line
+        overlay.SetEnabled(false);
+    }
+
+    TEST(PerfOverlayTest, FpsTest)
+    {
+        PerfOverlay& overlay = PerfOverlay::GetInstance();
+        Restart();
+        overlay.OnFrameSent(0);
+        overlay.windowStart = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+        overlay.windowFrames = 59; // 59: with the next frame 60 in one second
+        overlay.OnFrameSent(0);
+        EXPECT_GE(overlay.fpsTenths.load(), 590); // 590: 59.0 fps, the window may have run a bit longer
+        EXPECT_LE(overlay.fpsTenths.load(), 600); // 600: 60.0 fps
+        EXPECT_EQ(overlay.windowFrames, 0);
+        overlay.SetEnabled(false);
+    }
+
+    TEST(PerfOverlayTest, ResetOnEnableTest)
+    {
+        PerfOverlay& overlay = PerfOverlay::GetInstance();
+        Restart();
+        overlay.OnFrameEncoded(1000); // 1000: 1 ms
+        overlay.OnFrameDropped();
+        overlay.SetEnabled(true); // already enabled, keeps the counts
+        overlay.OnFrameDropped();
+        EXPECT_EQ(overlay.droppedCount.load(), 2); // 2: both drops
+        Restart();
+        overlay.OnFrameDropped();
+        EXPECT_EQ(overlay.droppedCount.load(), 1);
+        EXPECT_EQ(overlay.encodeTime.load(), 0);
+        overlay.SetEnabled(false);
+    }
+
+    TEST(PerfOverlayTest, DrawTest)
+    {
+        PerfOverlay& overlay = PerfOverlay::GetInstance();
+        Restart();
+        int32_t width = 100;
+        int32_t height = 60;
+        int32_t bytesPerPixel = 3;
+        std::vector<uint8_t> pixels(width * height * bytesPerPixel, BACKGROUND);
+        overlay.Draw(pixels.data(), width, height, bytesPerPixel);
+        auto at = [&](int32_t x, int32_t y) { return pixels[(y * width + x) * bytesPerPixel]; };
+        EXPECT_EQ(at(0, 0), BACKGROUND); // the margin is left alone
+        EXPECT_EQ(at(PerfOverlay::MARGIN, PerfOverlay::MARGIN), BACKGROUND >> PerfOverlay::DARKEN_SHIFT);
+        EXPECT_EQ(at(width - 1, height - 1), BACKGROUND);
+        EXPECT_NE(std::find(pixels.begin(), pixels.end(), 0xFF), pixels.end()); // 0xFF: the text
+        overlay.SetEnabled(false);
+    }
+
+    TEST(PerfOverlayTest, DrawClipTest)
+    {
+        PerfOverlay& overlay = PerfOverlay::GetInstance();
+        Restart();
+        int32_t width = 8;
+        int32_t height = 6;
+        int32_t bytesPerPixel = 4;
+        std::vector<uint8_t> pixels(width * height * bytesPerPixel, BACKGROUND);
+        overlay.Draw(pixels.data(), width, height, bytesPerPixel);
+        for (size_t i = 3; i < pixels.size(); i += bytesPerPixel) { // 3: the alpha byte
+            EXPECT_EQ(pixels[i], BACKGROUND);
+        }
+        EXPECT_NE(pixels[(PerfOverlay::MARGIN * width + PerfOverlay::MARGIN) * bytesPerPixel], BACKGROUND);
+        overlay.SetEnabled(false);
+    }
+
+    TEST(PerfOverlayTest, DrawInvalidTest)
+    {
+        PerfOverlay& overlay = PerfOverlay::GetInstance();
+        std::vector<uint8_t> pixels(16, BACKGROUND); // 16: 4 x 2 pixels of 2 bytes
+        overlay.Draw(pixels.data(), 4, 2, 2); // 4, 2, 2: width, height, bytes per pixel
+        overlay.Draw(nullptr, 4, 2, 3); // 4, 2, 3: width, height, bytes per pixel
+        overlay.Draw(pixels.data(), 0, 2, 3); // 0, 2, 3: width, height, bytes per pixel
+        EXPECT_EQ(std::count(pixels.begin(), pixels.end(), BACKGROUND), pixels.size());
+    }
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "AsyncLogger.h"
+#include "PreviewerEngineLog.h"
+
+namespace {
+    std::string ReadAll(FILE* file)
+    {
+        std::string content;
+        char chunk[4096];
+        rewind(file);
+        size_t length = 0;
+        while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            content.append(chunk, length);
+        }
+        return content;
+    }
+
+    size_t CountLines(const std::string& content, const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = content.find(pattern); pos != std::string::npos; pos = content.find(pattern, pos + 1)) {
+            count++;
+        }
+        return count;
+    }
+
+    // Keeps the per-call-site rate limit out of tests that count lines.
+    class RateLimitOff {
+    public:
+        RateLimitOff() : rateLimit(PreviewerLog::GetRateLimit())
+        {
+            PreviewerLog::SetRateLimit(0);
+        }
+        ~RateLimitOff()
+        {
+            PreviewerLog::SetRateLimit(rateLimit);
+        }
+
+    private:
+        uint32_t rateLimit;
+    };
+
+    TEST(AsyncLoggerTest, LineBufferTest)
+    {
+        auto buffer = std::make_unique<AsyncLogger::LineBuffer>();
+        std::string line(1000, 'a');
+        size_t count = 0;
+        while (buffer->Write(line.c_str(), line.length())) {
+            count++;
+        }
+        // a full ring rejects the line instead of overwriting unread data
+        EXPECT_EQ(count, AsyncLogger::LineBuffer::CAPACITY / line.length());
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        EXPECT_EQ(buffer->Read(file), count * line.length());
+        EXPECT_TRUE(buffer->IsEmpty());
+        // the next line wraps around the end of the ring
+        std::string wrapped = std::string(line.length() - 1, 'b') + "\n";
+        EXPECT_TRUE(buffer->Write(wrapped.c_str(), wrapped.length()));
+        EXPECT_EQ(buffer->Read(file), wrapped.length());
+        std::string content = ReadAll(file);
+        EXPECT_EQ(content.substr(content.length() - wrapped.length()), wrapped);
+        fclose(file);
+    }
+
+    TEST(AsyncLoggerTest, TimeTextTest)
+    {
+        std::string first = AsyncLogger::GetTimeText();
+        // "[yyyy-mm-ddThh:mm:ss.mmm]"
+        ASSERT_EQ(first.length(), 25);
+        EXPECT_EQ(first.front(), '[');
+        EXPECT_EQ(first.back(), ']');
+        EXPECT_EQ(first[20], '.');
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        std::string second = AsyncLogger::GetTimeText();
+        ASSERT_EQ(second.length(), first.length());
+        EXPECT_NE(second, first);
+    }
+
+    TEST(AsyncLoggerTest, MultiThreadTest)
+    {
+        RateLimitOff rateLimitOff;
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(file);
+        const int threadCount = 4;
+        const int lineCount = 200;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++) {
+            threads.emplace_back([i, lineCount]() {
+                for (int j = 0; j < lineCount; j++) {
+                    ILOG("MultiThreadTest %d %d", i, j);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(stdout);
+        std::string content = ReadAll(file);
+        fclose(file);
+        EXPECT_EQ(CountLines(content, "[INFO][AsyncLoggerTest.cpp]"), threadCount * lineCount);
+        EXPECT_NE(content.find("MultiThreadTest 3 199\n"), std::string::npos);
+    }
+
+    TEST(AsyncLoggerTest, ExitedThreadTest)
+    {
+        RateLimitOff rateLimitOff;
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(file);
+        std::thread([]() { ILOG("ExitedThreadTest"); }).join();
+        AsyncLogger::GetInstance().Flush();
+        size_t bufferCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(AsyncLogger::GetInstance().buffersMutex);
+            bufferCount = AsyncLogger::GetInstance().buffers.size();
+        }
+        std::thread([]() { ILOG("ExitedThreadTest"); }).join();
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(stdout);
+        std::string content = ReadAll(file);
+        fclose(file);
+        EXPECT_EQ(CountLines(content, "ExitedThreadTest"), 2); // 2 threads
+        // the drained ring of a finished thread is taken over by the next thread
+        std::lock_guard<std::mutex> lock(AsyncLogger::GetInstance().buffersMutex);
+        EXPECT_EQ(AsyncLogger::GetInstance().buffers.size(), bufferCount);
+    }
+
+    TEST(AsyncLoggerTest, OverflowTest)
+    {
+        RateLimitOff rateLimitOff;
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(file);
+        const int lineCount = 100000;
+        for (int i = 0; i < lineCount; i++) {
+            ILOG("OverflowTest x:%d y:%d", i, lineCount - i);
+        }
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(stdout);
+        // lines overflowing the thread's ring are drained by the caller, never dropped
+        EXPECT_EQ(CountLines(ReadAll(file), "OverflowTest x:"), lineCount);
+        fclose(file);
+    }
+
+    TEST(AsyncLoggerTest, WakeWriterTest)
+    {
+        RateLimitOff rateLimitOff;
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(file);
+        ILOG("WakeWriterTest");
+        // the idle writer is woken up by the line, no Flush
+        bool isWritten = false;
+        for (int i = 0; i < 1000 && !isWritten; i++) { // 1000: waits 1 s at most
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard<std::mutex> lock(AsyncLogger::GetInstance().drainMutex);
+            isWritten = CountLines(ReadAll(file), "WakeWriterTest") == 1;
+        }
+        AsyncLogger::GetInstance().SetOutput(stdout);
+        fclose(file);
+        EXPECT_TRUE(isWritten);
+    }
+
+    TEST(AsyncLoggerTest, FlushOnCrashTest)
+    {
+        RateLimitOff rateLimitOff;
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        AsyncLogger& logger = AsyncLogger::GetInstance();
+        logger.Flush();
+        logger.SetOutput(file);
+        {
+            // the crashed thread may hold any lock, the queued lines are written all the same
+            std::lock_guard<std::mutex> drainLock(logger.drainMutex);
+            std::lock_guard<std::mutex> lock(logger.buffersMutex);
+            ILOG("FlushOnCrashTest");
+            logger.FlushOnCrash();
+            EXPECT_EQ(CountLines(ReadAll(file), "FlushOnCrashTest"), 1);
+        }
+        logger.SetOutput(stdout);
+        fclose(file);
+    }
+}
@@ -21,6 +21,7 @@
 #include "gtest/gtest.h"
 #define private public
 #include "CommandParser.h"
+#include "PreviewerEngineLog.h"
 
 namespace {
     class CommandParserTest : public ::testing::Test {
@@ -1197,4 +1198,71 @@ namespace {
         EXPECT_TRUE(CommandParser::GetInstance().ProcessCommand(validParamVec));
         EXPECT_TRUE(CommandParser::GetInstance().IsCommandValid());
     }
-}
\ No newline at end of file
+
+    TEST_F(CommandParserTest, IsCommandValidTest_LogLevel)
+    {
+        int32_t level = PreviewerLog::GetLevel();
+        uint32_t rateLimit = PreviewerLog::GetRateLimit();
+        std::vector<std::string> params = validParamVec;
+        params.insert(params.end(), { "-logLevel", "error", "-logRate", "0" });
+        CommandParser::GetInstance().argsMap.clear();
+        EXPECT_TRUE(CommandParser::GetInstance().ProcessCommand(params));
+        EXPECT_TRUE(CommandParser::GetInstance().IsCommandValid());
+        EXPECT_EQ(PreviewerLog::GetLevel(), PreviewerLog::LEVEL_ERROR);
+        EXPECT_EQ(PreviewerLog::GetRateLimit(), 0);
+        params[params.size() - 3] = "verbose"; // 3 is the offset of the level value
+        CommandParser::GetInstance().argsMap.clear();
+        EXPECT_TRUE(CommandParser::GetInstance().ProcessCommand(params));
+        EXPECT_FALSE(CommandParser::GetInstance().IsCommandValid());
+        params[params.size() - 3] = "info"; // 3 is the offset of the level value
+        params[params.size() - 1] = "-1";
+        CommandParser::GetInstance().argsMap.clear();
+        EXPECT_TRUE(CommandParser::GetInstance().ProcessCommand(params));
+        EXPECT_FALSE(CommandParser::GetInstance().IsCommandValid());
+        PreviewerLog::SetLevel(level);
+        PreviewerLog::SetRateLimit(rateLimit);
+    }
+
+    TEST_F(CommandParserTest, IsCommandValidTest_Replay)
+    {
+        CommandParser& parser = CommandParser::GetInstance();
+        std::vector<std::string> params = validParamVec;
+        params.insert(params.end(), { "-replay", currFile, "-replaySpeed", "2.5", "-replayReport", "report.json" });
+        parser.argsMap.clear();
+        EXPECT_TRUE(parser.ProcessCommand(params));
+        EXPECT_TRUE(parser.IsCommandValid());
+        EXPECT_EQ(parser.GetReplayPath(), currFile);
+        EXPECT_DOUBLE_EQ(parser.GetReplaySpeed(), 2.5); // 2.5: the speed given
+        EXPECT_EQ(parser.GetReplayReportPath(), "report.json");
+        params[params.size() - 3] = "2000"; // 3 is the offset of the speed, 2000 is out of range
+        parser.argsMap.clear();
+        EXPECT_TRUE(parser.ProcessCommand(params));
+        EXPECT_FALSE(parser.IsCommandValid());
+        params[params.size() - 3] = "-1"; // 3 is the offset of the speed
+        parser.argsMap.clear();
+        EXPECT_TRUE(parser.ProcessCommand(params));
+        EXPECT_FALSE(parser.IsCommandValid());
+        // a recording is needed, and it can not be replayed while recording
+        params = validParamVec;
+        params.insert(params.end(), { "-replay", currFile + ".missing" });
+        parser.argsMap.clear();
+        EXPECT_TRUE(parser.ProcessCommand(params));
+        EXPECT_FALSE(parser.IsCommandValid());
+        params = validParamVec;
+        params.insert(params.end(), { "-replay", currFile, "-record", "session.rec" });
+        parser.argsMap.clear();
+        EXPECT_TRUE(parser.ProcessCommand(params));
+        EXPECT_FALSE(parser.IsCommandValid());
+        params = validParamVec;
+        params.insert(params.end(), { "-replaySpeed", "0" });
+        parser.argsMap.clear();
+        EXPECT_TRUE(parser.ProcessCommand(params));
+        EXPECT_FALSE(parser.IsCommandValid());
+        params = validParamVec;
+        params.insert(params.end(), { "-record", "session.rec" });
+        parser.argsMap.clear();
+        EXPECT_TRUE(parser.ProcessCommand(params));
+        EXPECT_TRUE(parser.IsCommandValid());
+        EXPECT_EQ(parser.GetRecordPath(), "session.rec");
+    }
+}
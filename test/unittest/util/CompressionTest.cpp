@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include "gtest/gtest.h"
+#include "Compression.h"
+
+namespace {
+    // A flat copy of the inspector tree format, the attributes repeat for every node.
+    std::string CreateTree(int nodeCount)
+    {
+        std::string tree = "{\"$type\":\"root\",\"$children\":[";
+        for (int i = 0; i < nodeCount; i++) {
+            if (i > 0) {
+                tree += ",";
+            }
+            tree += "{\"$type\":\"Text\",\"$ID\":" + std::to_string(i) +
+                ",\"$rect\":\"[0.00, " + std::to_string(i * 40) + ".00],[1080.00, " + std::to_string(i * 40 + 40) +
+                ".00]\",\"$attrs\":{\"content\":\"item " + std::to_string(i) +
+                "\",\"fontSize\":\"16.00fp\",\"fontColor\":\"#FF000000\",\"visibility\":\"Visibility.Visible\"}}";
+        }
+        tree += "]}";
+        return tree;
+    }
+
+    TEST(CompressionTest, DeflateInflateTest)
+    {
+        std::string input = CreateTree(100); // 100 nodes
+        std::string compressed;
+        EXPECT_TRUE(Compression::Deflate(input, compressed));
+        EXPECT_LT(compressed.size(), input.size());
+        std::string output;
+        EXPECT_TRUE(Compression::Inflate(compressed, input.size(), output));
+        EXPECT_EQ(output, input);
+        // empty input is valid as well
+        EXPECT_TRUE(Compression::Deflate("", compressed));
+        EXPECT_TRUE(Compression::Inflate(compressed, 0, output));
+        EXPECT_TRUE(output.empty());
+    }
+
+    TEST(CompressionTest, InflateTest_Err)
+    {
+        std::string compressed;
+        EXPECT_TRUE(Compression::Deflate("previewer", compressed));
+        std::string output;
+        // wrong length
+        EXPECT_FALSE(Compression::Inflate(compressed, 3, output)); // 3 is shorter than the input
+        EXPECT_FALSE(Compression::Inflate(compressed, 100, output)); // 100 is longer than the input
+        // corrupted data
+        EXPECT_FALSE(Compression::Inflate("not deflated", 9, output)); // 9 is the input length
+        EXPECT_FALSE(Compression::Inflate(compressed, Compression::MAX_INFLATED_LENGTH + 1, output));
+    }
+
+    TEST(CompressionTest, Base64Test)
+    {
+        // test vectors of RFC 4648
+        EXPECT_EQ(Compression::EncodeBase64(""), "");
+        EXPECT_EQ(Compression::EncodeBase64("f"), "Zg==");
+        EXPECT_EQ(Compression::EncodeBase64("fo"), "Zm8=");
+        EXPECT_EQ(Compression::EncodeBase64("foo"), "Zm9v");
+        EXPECT_EQ(Compression::EncodeBase64("foob"), "Zm9vYg==");
+        EXPECT_EQ(Compression::EncodeBase64("fooba"), "Zm9vYmE=");
+        EXPECT_EQ(Compression::EncodeBase64("foobar"), "Zm9vYmFy");
+        std::string binary("\x00\xff\x10\x80", 4); // 4 bytes
+        std::string output;
+        EXPECT_TRUE(Compression::DecodeBase64(Compression::EncodeBase64(binary), output));
+        EXPECT_EQ(output, binary);
+        EXPECT_TRUE(Compression::DecodeBase64("Zm9vYmE=", output));
+        EXPECT_EQ(output, "fooba");
+    }
+
+    TEST(CompressionTest, Base64Test_Err)
+    {
+        std::string output;
+        EXPECT_FALSE(Compression::DecodeBase64("Zm9", output));
+        EXPECT_FALSE(Compression::DecodeBase64("Zm9*", output));
+        EXPECT_FALSE(Compression::DecodeBase64("Z=9v", output));
+    }
+}
@@ -46,4 +46,28 @@ namespace {
         manager.RemoveCppTimer(timer);
         EXPECT_EQ(manager.runningTimers.size(), value);
     }
+
+    TEST(CppTimerManagerTest, GetNextTimeoutTest)
+    {
+        CppTimerManager& manager = CppTimerManager::GetTimerManager();
+        CppTimer slowTimer([]() {});
+        CppTimer fastTimer([]() {});
+        manager.AddCppTimer(slowTimer);
+        manager.AddCppTimer(fastTimer);
+        EXPECT_EQ(manager.GetNextTimeout(), -1);
+        int64_t slowInterval = 1000;
+        int64_t fastInterval = 100;
+        slowTimer.Start(slowInterval);
+        fastTimer.Start(fastInterval);
+        int64_t timeout = manager.GetNextTimeout();
+        EXPECT_GE(timeout, 0);
+        EXPECT_LE(timeout, fastInterval);
+        fastTimer.Stop();
+        EXPECT_GT(manager.GetNextTimeout(), fastInterval);
+        std::this_thread::sleep_for(std::chrono::milliseconds(slowInterval));
+        EXPECT_EQ(manager.GetNextTimeout(), 0);
+        manager.RemoveCppTimer(slowTimer);
+        manager.RemoveCppTimer(fastTimer);
+        EXPECT_EQ(manager.GetNextTimeout(), -1);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include "gtest/gtest.h"
+#define private public
+#include "JsonArena.h"
+#include "JsonReader.h"
+#include "MemoryStats.h"
+#include "cJSON.h"
+
+namespace {
+    std::atomic<uint64_t> g_heapMallocCount(0);
+
+    void* CountingMalloc(size_t size)
+    {
+        g_heapMallocCount++;
+        return malloc(size);
+    }
+
+    const std::string MESSAGE = R"({"type":"action","command":"MouseMove","version":"1.0.1","requestId":"17",
+        "args":{"x":120,"y":480,"button":0,"action":2,"sourceType":1,"sourceTool":0,"pressedButtons":[0]}})";
+
+    TEST(JsonArenaTest, ScopeTest)
+    {
+        MemoryStats::InstallJsonHooks();
+        JsonArena& arena = JsonArena::GetInstance();
+        ASSERT_TRUE(JsonArena::IsInstalled());
+        {
+            Json2::Value heapJson = JsonReader::ParseJsonData2(MESSAGE);
+            EXPECT_EQ(arena.GetLiveCount(), 0);
+        }
+        const cJSON* first = nullptr;
+        {
+            JsonArena::Scope scope;
+            Json2::Value message = JsonReader::ParseJsonData2(MESSAGE);
+            first = message.GetJsonPtr();
+            EXPECT_GT(arena.GetLiveCount(), 0);
+            {
+                JsonArena::Scope nested;
+            }
+            Json2::Value inner = JsonReader::ParseJsonData2(MESSAGE); // the outer scope is still open
+            EXPECT_NE(inner.GetJsonPtr(), first);
+            EXPECT_EQ(inner["args"]["y"].AsInt(), 480); // 480: the y of the message
+        }
+        EXPECT_EQ(arena.GetLiveCount(), 0);
+        {
+            // nothing alive, the block starts over
+            JsonArena::Scope scope;
+            Json2::Value message = JsonReader::ParseJsonData2(MESSAGE);
+            EXPECT_EQ(message.GetJsonPtr(), first);
+        }
+        EXPECT_EQ(arena.GetLiveCount(), 0);
+        cJSON_InitHooks(nullptr);
+    }
+
+    TEST(JsonArenaTest, FallbackTest)
+    {
+        MemoryStats::InstallJsonHooks();
+        JsonArena& arena = JsonArena::GetInstance();
+        uint64_t heapCount = arena.heapAllocations.Get();
+        std::string large = "[";
+        for (size_t i = 0; i < JsonArena::BLOCK_SIZE / 8; i++) { // 8: items far over the block
+            large += (i == 0 ? "" : ",") + std::to_string(i);
+        }
+        large += "]";
+        Json2::Value kept;
+        {
+            JsonArena::Scope scope;
+            kept = JsonReader::ParseJsonData2(MESSAGE);
+            Json2::Value array = JsonReader::ParseJsonData2(large);
+            ASSERT_EQ(array.GetArraySize(), JsonArena::BLOCK_SIZE / 8); // 8: as generated
+            EXPECT_EQ(array.GetArrayItem(1000).AsInt(), 1000); // 1000: an item from the heap
+        }
+        EXPECT_GT(arena.heapAllocations.Get(), heapCount);
+        // a tree outliving the scope stays valid, also when changed outside of it
+        size_t liveCount = arena.GetLiveCount();
+        EXPECT_GT(liveCount, 0);
+        EXPECT_TRUE(kept["args"].Add("extra", "heap"));
+        {
+            JsonArena::Scope scope;
+            Json2::Value message = JsonReader::ParseJsonData2(MESSAGE);
+            EXPECT_NE(message.GetJsonPtr(), kept.GetJsonPtr());
+        }
+        EXPECT_EQ(arena.GetLiveCount(), liveCount);
+        EXPECT_EQ(kept["command"].AsString(), "MouseMove");
+        EXPECT_EQ(kept["args"]["extra"].AsString(), "heap");
+        kept = Json2::Value();
+        EXPECT_EQ(arena.GetLiveCount(), 0);
+        cJSON_InitHooks(nullptr);
+    }
+
+    TEST(JsonArenaTest, MemoryStatsTest)
+    {
+        MemoryStats::InstallJsonHooks();
+        MemoryStats& stats = MemoryStats::GetInstance();
+        {
+            JsonArena::Scope scope;
+            Json2::Value message = JsonReader::ParseJsonData2(MESSAGE); // the block exists from here on
+        }
+        int64_t before = stats.GetCurrent(MemoryTag::JSON);
+        {
+            JsonArena::Scope scope;
+            Json2::Value message = JsonReader::ParseJsonData2(MESSAGE);
+            EXPECT_EQ(stats.GetCurrent(MemoryTag::JSON), before);
+        }
+        {
+            Json2::Value message = JsonReader::ParseJsonData2(MESSAGE);
+            EXPECT_GT(stats.GetCurrent(MemoryTag::JSON), before);
+        }
+        EXPECT_EQ(stats.GetCurrent(MemoryTag::JSON), before);
+        cJSON_InitHooks(nullptr);
+    }
+
+    TEST(JsonArenaTest, AllocationTest)
+    {
+        JsonArena::InstallHooks(CountingMalloc, free);
+        const int rounds = 100;
+        int64_t sum = 0;
+        uint64_t heapCount = g_heapMallocCount;
+        for (int i = 0; i < rounds; i++) {
+            Json2::Value message = JsonReader::ParseJsonData2(MESSAGE);
+            sum += message["args"]["x"].AsInt();
+        }
+        uint64_t heapAllocations = g_heapMallocCount - heapCount;
+        heapCount = g_heapMallocCount;
+        uint64_t arenaCount = JsonArena::GetInstance().arenaAllocations.Get();
+        for (int i = 0; i < rounds; i++) {
+            Json2::Value message;
+            {
+                JsonArena::Scope scope;
+                message = JsonReader::ParseJsonData2(MESSAGE);
+            }
+            sum += message["args"]["x"].AsInt();
+        }
+        uint64_t arenaHeapAllocations = g_heapMallocCount - heapCount;
+        uint64_t arenaAllocations = JsonArena::GetInstance().arenaAllocations.Get() - arenaCount;
+        EXPECT_EQ(sum, 2 * rounds * 120); // 2: both loops, 120: the x
+        EXPECT_GT(heapAllocations, 0);
+        EXPECT_EQ(arenaAllocations, heapAllocations);
+        EXPECT_LE(arenaHeapAllocations, 1); // 1: the block, unless an earlier test made it
+        EXPECT_EQ(JsonArena::GetInstance().GetLiveCount(), 0);
+        cJSON_InitHooks(nullptr);
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include "gtest/gtest.h"
+#include "JsonDiff.h"
+
+namespace {
+    Json2::Value Diff(const std::string& from, const std::string& to)
+    {
+        Json2::Value patch = JsonReader::CreateArray();
+        Json2::Value fromValue = JsonReader::ParseJsonData2(from);
+        Json2::Value toValue = JsonReader::ParseJsonData2(to);
+        EXPECT_TRUE(JsonDiff::Diff(fromValue, toValue, patch));
+        return JsonReader::DepthCopy(patch);
+    }
+
+    TEST(JsonDiffTest, EqualTest)
+    {
+        Json2::Value patch = Diff(R"({"a":1,"b":[1,2,{"c":"d"}]})", R"({"b":[1,2,{"c":"d"}],"a":1})");
+        EXPECT_EQ(patch.GetArraySize(), 0);
+    }
+
+    TEST(JsonDiffTest, ObjectMemberTest)
+    {
+        Json2::Value patch = Diff(R"({"a":1,"b":{"c":true},"e":"x"})", R"({"a":2,"b":{"c":true,"d":null}})");
+        EXPECT_EQ(patch.ToString(), "[{\"op\":\"replace\",\"path\":\"/a\",\"value\":2},"
+            "{\"op\":\"add\",\"path\":\"/b/d\",\"value\":null},"
+            "{\"op\":\"remove\",\"path\":\"/e\"}]");
+    }
+
+    TEST(JsonDiffTest, MemberCaseTest)
+    {
+        // keys differing only in case are different members
+        Json2::Value patch = Diff(R"({"Width":1})", R"({"width":1})");
+        EXPECT_EQ(patch.ToString(), "[{\"op\":\"remove\",\"path\":\"/Width\"},"
+            "{\"op\":\"add\",\"path\":\"/width\",\"value\":1}]");
+    }
+
+    TEST(JsonDiffTest, ArrayInsertTest)
+    {
+        // an insertion in the middle of a list is a single add, the items after it are not touched
+        Json2::Value patch = Diff(R"({"children":[{"id":1},{"id":2},{"id":3}]})",
+            R"({"children":[{"id":1},{"id":4},{"id":2},{"id":3}]})");
+        EXPECT_EQ(patch.ToString(), "[{\"op\":\"add\",\"path\":\"/children/1\",\"value\":{\"id\":4}}]");
+    }
+
+    TEST(JsonDiffTest, ArrayRemoveTest)
+    {
+        Json2::Value patch = Diff("[1,2,3,4,5]", "[1,5]");
+        EXPECT_EQ(patch.ToString(), "[{\"op\":\"remove\",\"path\":\"/3\"},"
+            "{\"op\":\"remove\",\"path\":\"/2\"},{\"op\":\"remove\",\"path\":\"/1\"}]");
+    }
+
+    TEST(JsonDiffTest, ArrayChangeTest)
+    {
+        Json2::Value patch = Diff(R"([{"w":1,"h":2},7])", R"([{"w":1,"h":3},7,8])");
+        EXPECT_EQ(patch.ToString(), "[{\"op\":\"replace\",\"path\":\"/0/h\",\"value\":3},"
+            "{\"op\":\"add\",\"path\":\"/2\",\"value\":8}]");
+    }
+
+    TEST(JsonDiffTest, TypeChangeTest)
+    {
+        Json2::Value patch = Diff(R"({"a":[1]})", R"({"a":{"0":1}})");
+        EXPECT_EQ(patch.ToString(), "[{\"op\":\"replace\",\"path\":\"/a\",\"value\":{\"0\":1}}]");
+        Json2::Value rootPatch = Diff("[1]", "{}");
+        EXPECT_EQ(rootPatch.ToString(), "[{\"op\":\"replace\",\"path\":\"\",\"value\":{}}]");
+    }
+
+    TEST(JsonDiffTest, EscapePointerTokenTest)
+    {
+        EXPECT_EQ(JsonDiff::EscapePointerToken("a/b~c"), "a~1b~0c");
+        Json2::Value patch = Diff(R"({"a/b":1})", R"({"a/b":2})");
+        EXPECT_EQ(patch.ToString(), "[{\"op\":\"replace\",\"path\":\"/a~1b\",\"value\":2}]");
+    }
+
+    TEST(JsonDiffTest, DiffTest_Err)
+    {
+        Json2::Value patch = JsonReader::CreateArray();
+        Json2::Value invalid = JsonReader::ParseJsonData2("{");
+        Json2::Value valid = JsonReader::ParseJsonData2("{}");
+        EXPECT_FALSE(JsonDiff::Diff(invalid, valid, patch));
+        Json2::Value object = JsonReader::CreateObject();
+        EXPECT_FALSE(JsonDiff::Diff(valid, valid, object));
+    }
+}
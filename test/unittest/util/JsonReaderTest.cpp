@@ -12,10 +12,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <fstream>
+#include <utility>
+#include <vector>
 #include "gtest/gtest.h"
+#define private public
 #include "JsonReader.h"
+#include "cJSON.h"
 
 namespace {
     std::string g_name = "jin";
@@ -499,4 +505,173 @@ namespace {
         ret = jsonData.Replace(invalidIndex, val);
         EXPECT_FALSE(ret);
     }
-}
\ No newline at end of file
+
+    TEST(JsonReaderTest, MoveTest)
+    {
+        Json2::Value first = JsonReader::ParseJsonData2(R"({"name":"jin"})");
+        Json2::Value second(std::move(first));
+        EXPECT_TRUE(first.IsNull());
+        EXPECT_EQ(second["name"].AsString(), "jin");
+        // the json held before is freed with the moved from value
+        Json2::Value third = JsonReader::ParseJsonData2(R"({"age":20})");
+        third = std::move(second);
+        EXPECT_EQ(third["name"].AsString(), "jin");
+        EXPECT_FALSE(third.IsMember("age"));
+        third = JsonReader::ParseJsonData2(R"({"age":20})");
+        EXPECT_EQ(third["age"].AsInt(), 20); // 20: the age
+    }
+
+    // A routerMap sized object, as found in the module.json of a large project.
+    std::string MakeLargeObject(int count)
+    {
+        std::string json = "{";
+        for (int i = 0; i < count; i++) {
+            std::string name = "page" + std::to_string(i);
+            json += (i == 0 ? "\"" : ",\"") + name + "\":{\"pageSourceFile\":\"src/main/ets/pages/" + name +
+                ".ets\",\"buildFunction\":\"" + name + "Builder\",\"index\":" + std::to_string(i) + "}";
+        }
+        return json + "}";
+    }
+
+    TEST(JsonReaderTest, MemberIndexTest)
+    {
+        const int count = 100;
+        Json2::Value routerMap = JsonReader::ParseJsonData2(MakeLargeObject(count));
+        for (int round = 0; round < 3; round++) { // 3: scans, then builds and uses the index
+            for (int i = 0; i < count; i++) {
+                std::string name = "page" + std::to_string(i);
+                EXPECT_EQ(routerMap[name]["index"].AsInt(), i);
+                EXPECT_EQ(routerMap.GetValue(name.c_str()).GetString("buildFunction"), name + "Builder");
+            }
+            EXPECT_TRUE(routerMap["page100"].IsNull());
+            EXPECT_TRUE(routerMap["Page1"].IsNull());
+            EXPECT_TRUE(routerMap.IsMember("Page1"));
+            EXPECT_TRUE(routerMap.IsMember("page1"));
+            EXPECT_FALSE(routerMap.IsMember("page100"));
+        }
+        // a copy shares the index, the moved to value takes it over
+        Json2::Value copied = routerMap["page7"];
+        EXPECT_EQ(copied.GetInt("index"), 7); // 7: the page
+        Json2::Value moved = std::move(routerMap);
+        EXPECT_EQ(moved["page42"].GetInt("index"), 42); // 42: the page
+        EXPECT_TRUE(moved["page42"].GetValue("missing").IsNull());
+    }
+
+    TEST(JsonReaderTest, MemberIndexRepeatedKeyTest)
+    {
+        std::string json = MakeLargeObject(20); // 20: over the members an index needs
+        json.back() = ',';
+        json += R"("page3":{"index":-1}})";
+        Json2::Value routerMap = JsonReader::ParseJsonData2(json);
+        for (int round = 0; round < 3; round++) { // 3: with and without the index
+            EXPECT_EQ(routerMap["page3"]["index"].AsInt(), 3); // 3: the first page3 wins
+        }
+    }
+
+    TEST(JsonReaderTest, MemberIndexChangeTest)
+    {
+        const int count = 50;
+        Json2::Value routerMap = JsonReader::ParseJsonData2(MakeLargeObject(count));
+        EXPECT_FALSE(routerMap.IsMember("extra"));
+        EXPECT_FALSE(routerMap.IsMember("extra"));
+        EXPECT_TRUE(routerMap["extra"].IsNull());
+        EXPECT_TRUE(routerMap.Add("extra", "added"));
+        EXPECT_EQ(routerMap["extra"].AsString(), "added");
+        EXPECT_TRUE(routerMap.Replace("page0", 0));
+        EXPECT_TRUE(routerMap["page0"].IsNumber());
+        EXPECT_EQ(routerMap["page1"]["index"].AsInt(), 1);
+        // a change made through another value is seen as well
+        Json2::Value other = JsonReader::CreateObject();
+        other.Add("name", "other");
+        Json2::Value page = routerMap["page1"];
+        EXPECT_TRUE(page.Replace("index", 100)); // 100: the new index
+        EXPECT_TRUE(routerMap.Replace("page2", other));
+        EXPECT_EQ(routerMap["page2"].GetString("name"), "other");
+        EXPECT_EQ(routerMap["page1"].GetInt("index"), 100); // 100: the new index
+        routerMap.Clear();
+        EXPECT_TRUE(routerMap["page3"].IsNull());
+        EXPECT_FALSE(routerMap.IsMember("page3"));
+    }
+
+    TEST(JsonReaderTest, MemberIndexViewTest)
+    {
+        Json2::Value routerMap = JsonReader::ParseJsonData2(MakeLargeObject(50)); // 50: pages
+        Json2::Value view(const_cast<cJSON*>(routerMap.GetJsonPtr()), false);
+        Json2::Value reply = JsonReader::CreateObject();
+        for (int round = 0; round < 3; round++) { // 3: scans, then builds and uses the index
+            EXPECT_EQ(view["page1"].GetInt("index"), 1);
+            // building another json leaves the index alone
+            EXPECT_TRUE(reply.Add("result", true));
+            reply.Clear();
+        }
+        // a change made through another value of the same object is seen by the index
+        Json2::Value other = JsonReader::CreateObject();
+        other.Add("name", "other");
+        EXPECT_TRUE(routerMap.Replace("page1", other));
+        EXPECT_EQ(view["page1"].GetString("name"), "other");
+        EXPECT_TRUE(routerMap.Add("extra", "added"));
+        EXPECT_EQ(view["extra"].AsString(), "added");
+    }
+
+    TEST(JsonReaderTest, MemberIndexIsMemberTest)
+    {
+        Json2::Value routerMap = JsonReader::ParseJsonData2(MakeLargeObject(50)); // 50: pages
+        for (int round = 0; round < 3; round++) { // 3: scans, then builds and uses the index
+            EXPECT_TRUE(routerMap.IsMember("page1"));
+            EXPECT_TRUE(routerMap.IsMember("PAGE49"));
+            EXPECT_FALSE(routerMap.IsMember("page50"));
+            EXPECT_FALSE(routerMap.IsMember("PAGE"));
+        }
+        ASSERT_NE(routerMap.memberIndex, nullptr);
+        // the json itself is left as parsed, the changes are counted beside it
+        EXPECT_TRUE(routerMap.Add("Debounce", 1));
+        EXPECT_TRUE(routerMap.IsMember("debounce"));
+        EXPECT_EQ(routerMap.GetJsonPtr()->valueint, 0);
+    }
+
+    TEST(JsonReaderTest, PrintToTest)
+    {
+        std::string buffer = "stale";
+        EXPECT_FALSE(Json2::Value().PrintTo(buffer));
+        EXPECT_TRUE(buffer.empty());
+        Json2::Value student = JsonReader::ParseJsonData2(g_obj);
+        ASSERT_TRUE(student.PrintTo(buffer));
+        EXPECT_EQ(buffer, student.ToString());
+        EXPECT_EQ(buffer.find('\n'), std::string::npos);
+        // a smaller json reuses the buffer
+        const char* data = buffer.data();
+        ASSERT_TRUE(student["school"].PrintTo(buffer));
+        EXPECT_EQ(buffer, R"({"schoolName":"abc","schoolAddr":"cba"})");
+        EXPECT_EQ(buffer.data(), data);
+        // a larger one grows it
+        Json2::Value routerMap = JsonReader::ParseJsonData2(MakeLargeObject(100)); // 100: far over the buffer
+        ASSERT_TRUE(routerMap.PrintTo(buffer));
+        EXPECT_EQ(buffer, routerMap.ToString());
+        EXPECT_EQ(JsonReader::ParseJsonData2(buffer)["page99"]["index"].AsInt(), 99); // 99: the last page
+        // and keeps it, printing the large json again does not grow it
+        data = buffer.data();
+        ASSERT_TRUE(student.PrintTo(buffer));
+        ASSERT_TRUE(routerMap.PrintTo(buffer));
+        EXPECT_EQ(buffer, routerMap.ToString());
+        EXPECT_EQ(buffer.data(), data);
+    }
+
+    TEST(JsonReaderTest, PrintToAfterLargeTest)
+    {
+        std::string buffer;
+        Json2::Value routerMap = JsonReader::ParseJsonData2(MakeLargeObject(100)); // 100: far over the buffer
+        ASSERT_TRUE(routerMap.PrintTo(buffer));
+        ASSERT_TRUE(routerMap.PrintTo(buffer)); // now printed in place
+        Json2::Value::PrintBuffer& printBuffer = Json2::Value::GetPrintBuffer();
+        ASSERT_GT(printBuffer.size, buffer.size());
+        // a small reply after it writes only its own bytes, not the whole buffer
+        std::memset(printBuffer.data.get(), 'x', printBuffer.size);
+        Json2::Value reply = JsonReader::ParseJsonData2(R"({"result":true})");
+        ASSERT_TRUE(reply.PrintTo(buffer));
+        EXPECT_EQ(buffer, R"({"result":true})");
+        size_t written = buffer.size() + 1; // 1: the terminating zero
+        const char* begin = printBuffer.data.get();
+        size_t untouched = static_cast<size_t>(std::count(begin + written, begin + printBuffer.size, 'x'));
+        EXPECT_EQ(untouched, printBuffer.size - written);
+    }
+}
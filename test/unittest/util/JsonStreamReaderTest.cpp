@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "JsonStreamReader.h"
+#include "JsonReader.h"
+#include "MemoryStats.h"
+
+namespace {
+    // Records every event as a line of text.
+    class RecordHandler : public JsonStreamHandler {
+    public:
+        JsonStreamAction OnContainerStart(const JsonStreamPath& path, bool isArray) override
+        {
+            events.push_back(ToString(path) + (isArray ? "[" : "{"));
+            return ToString(path) == skipPath ? JsonStreamAction::SKIP : JsonStreamAction::CONTINUE;
+        }
+
+        JsonStreamAction OnContainerEnd(const JsonStreamPath& path, bool isArray) override
+        {
+            events.push_back(ToString(path) + (isArray ? "]" : "}"));
+            return JsonStreamAction::CONTINUE;
+        }
+
+        JsonStreamAction OnValue(const JsonStreamPath& path, const JsonStreamValue& value) override
+        {
+            std::string text;
+            switch (value.type) {
+                case JsonStreamValue::Type::STRING:
+                    text = "\"" + value.string + "\"";
+                    break;
+                case JsonStreamValue::Type::NUMBER:
+                    text = std::to_string(value.number);
+                    break;
+                case JsonStreamValue::Type::BOOL:
+                    text = value.boolean ? "true" : "false";
+                    break;
+                default:
+                    text = "null";
+                    break;
+            }
+            events.push_back(ToString(path) + "=" + text);
+            return ToString(path) == stopPath ? JsonStreamAction::STOP : JsonStreamAction::CONTINUE;
+        }
+
+        static std::string ToString(const JsonStreamPath& path)
+        {
+            std::string text;
+            for (const JsonStreamPathItem& item : path) {
+                text += item.index >= 0 ? "/" + std::to_string(item.index) : "/" + item.key;
+            }
+            return text;
+        }
+
+        std::vector<std::string> events;
+        std::string skipPath = "-";
+        std::string stopPath = "-";
+    };
+
+    // Takes the members of modulePathMap, as StageContext does from loader.json.
+    class ModulePathHandler : public JsonStreamHandler {
+    public:
+        JsonStreamAction OnContainerStart(const JsonStreamPath& path, bool isArray) override
+        {
+            bool isMap = path.size() == 1 && path[0].key == "modulePathMap" && !isArray;
+            return path.empty() || isMap ? JsonStreamAction::CONTINUE : JsonStreamAction::SKIP;
+        }
+
+        JsonStreamAction OnContainerEnd(const JsonStreamPath&, bool) override
+        {
+            return JsonStreamAction::CONTINUE;
+        }
+
+        JsonStreamAction OnValue(const JsonStreamPath& path, const JsonStreamValue& value) override
+        {
+            if (path.size() == 2 && value.type == JsonStreamValue::Type::STRING) { // 2: a member of the map
+                modulePathMap.emplace(path[1].key, value.string);
+            }
+            return JsonStreamAction::CONTINUE;
+        }
+
+        std::map<std::string, std::string> modulePathMap;
+    };
+
+    TEST(JsonStreamReaderTest, ParseTest)
+    {
+        RecordHandler handler;
+        EXPECT_TRUE(JsonStreamReader::ParseString(
+            R"( {"a":1.5,"b":[true,false,null,"s"],"c":{"d":-2e2,"e":{}},"f":[]} )", handler));
+        std::vector<std::string> expected = { "{", "/a=1.500000", "/b[", "/b/0=true", "/b/1=false", "/b/2=null",
+            "/b/3=\"s\"", "/b]", "/c{", "/c/d=-200.000000", "/c/e{", "/c/e}", "/c}", "/f[", "/f]", "}" };
+        EXPECT_EQ(handler.events, expected);
+        RecordHandler scalar;
+        EXPECT_TRUE(JsonStreamReader::ParseString("\"only\"", scalar));
+        EXPECT_EQ(scalar.events, std::vector<std::string>({ "=\"only\"" }));
+    }
+
+    TEST(JsonStreamReaderTest, SkipAndStopTest)
+    {
+        std::string json = R"({"skipped":{"x":[1,{"y":"z"}]},"kept":[1,2],"last":3})";
+        RecordHandler skip;
+        skip.skipPath = "/skipped";
+        EXPECT_TRUE(JsonStreamReader::ParseString(json, skip));
+        std::vector<std::string> expected = { "{", "/skipped{", "/kept[", "/kept/0=1.000000", "/kept/1=2.000000",
+            "/kept]", "/last=3.000000", "}" };
+        EXPECT_EQ(skip.events, expected);
+        RecordHandler stop;
+        stop.stopPath = "/kept/0";
+        EXPECT_TRUE(JsonStreamReader::ParseString(json + "not read", stop));
+        EXPECT_EQ(stop.events.back(), "/kept/0=1.000000");
+        // a skipped container is still checked
+        skip.events.clear();
+        EXPECT_FALSE(JsonStreamReader::ParseString(R"({"skipped":{"x":[1,}},"last":3})", skip));
+    }
+
+    TEST(JsonStreamReaderTest, StringTest)
+    {
+        RecordHandler handler;
+        EXPECT_TRUE(JsonStreamReader::ParseString(R"(["\"\\\/\b\f\n\r\t","A\u00e9\u4E2D\ud83d\ude00"])", handler));
+        ASSERT_EQ(handler.events.size(), 4); // 4: the array and its two strings
+        EXPECT_EQ(handler.events[1], "/0=\"\"\\/\b\f\n\r\t\"");
+        EXPECT_EQ(handler.events[2], "/1=\"A\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80\"");
+        // a string spanning several chunks
+        std::string longText(JsonStreamReader::CHUNK_SIZE * 3 + 7, 'a'); // 3, 7: not a multiple of the chunk
+        RecordHandler chunks;
+        EXPECT_TRUE(JsonStreamReader::ParseString("{\"" + longText + "\":\"" + longText + "\"}", chunks));
+        ASSERT_EQ(chunks.events.size(), 3); // 3: the object and its member
+        EXPECT_EQ(chunks.events[1], "/" + longText + "=\"" + longText + "\"");
+    }
+
+    TEST(JsonStreamReaderTest, InvalidTest)
+    {
+        const char* const invalidJsons[] = {
+            "", "{", "[1,]", R"({"a":1,})", R"({"a" 1})", "{1:2}", "[01]", "[1.]", "[-]", "[1e]", "tru",
+            "nul", R"(["\x"])", R"(["\u12"])", R"(["\ud83d"])", R"(["\ude00"])", "[\"a\nb\"]", "[1] [2]",
+            R"({"a":1}})", "\"open",
+        };
+        for (const char* json : invalidJsons) {
+            RecordHandler handler;
+            EXPECT_FALSE(JsonStreamReader::ParseString(json, handler)) << json;
+        }
+        std::string deep(JsonStreamReader::MAX_DEPTH + 1, '[');
+        deep += std::string(JsonStreamReader::MAX_DEPTH + 1, ']');
+        RecordHandler handler;
+        EXPECT_FALSE(JsonStreamReader::ParseString(deep, handler));
+        std::string tooLong = "[\"" + std::string(JsonStreamReader::MAX_STRING_LENGTH + 1, 'a') + "\"]";
+        EXPECT_FALSE(JsonStreamReader::ParseString(tooLong, handler));
+        EXPECT_FALSE(JsonStreamReader::ParseFile("not_exist.json", handler));
+    }
+
+    TEST(JsonStreamReaderTest, OffsetTest)
+    {
+        std::istringstream stream(std::string(JsonStreamReader::CHUNK_SIZE, ' ') + "[1, x]");
+        JsonStreamReader reader(stream);
+        RecordHandler handler;
+        EXPECT_FALSE(reader.Parse(handler));
+        EXPECT_EQ(reader.GetOffset(), JsonStreamReader::CHUNK_SIZE + 4); // 4: the x
+    }
+
+    TEST(JsonStreamReaderTest, Utf8BomTest)
+    {
+        // skipped at the start only, as cJSON_Parse does
+        RecordHandler handler;
+        EXPECT_TRUE(JsonStreamReader::ParseString("\xEF\xBB\xBF{\"a\":1}", handler));
+        EXPECT_EQ(handler.events, std::vector<std::string>({ "{", "/a=1.000000", "}" }));
+        RecordHandler twice;
+        EXPECT_FALSE(JsonStreamReader::ParseString("\xEF\xBB\xBF\xEF\xBB\xBF{}", twice));
+        RecordHandler inside;
+        EXPECT_FALSE(JsonStreamReader::ParseString("[\xEF\xBB\xBF1]", inside));
+        RecordHandler only;
+        EXPECT_FALSE(JsonStreamReader::ParseString("\xEF\xBB\xBF", only));
+    }
+
+    // loader.json of a project with many modules: the maps the previewer reads, and large lists it does not.
+    std::string MakeLoaderJson(int moduleCount)
+    {
+        std::string json = "{\"modulePathMap\":{";
+        for (int i = 0; i < moduleCount; i++) {
+            json += (i == 0 ? "\"" : ",\"") + std::string("module") + std::to_string(i) +
+                "\":\"/home/user/project/features/module" + std::to_string(i) + "\"";
+        }
+        json += "},\"compileEntry\":[";
+        for (int i = 0; i < moduleCount * 20; i++) { // 20: source files per module
+            json += (i == 0 ? "\"" : ",\"") + std::string("/home/user/project/features/module") +
+                std::to_string(i % moduleCount) + "/src/main/ets/pages/Page" + std::to_string(i) + ".ets\"";
+        }
+        json += "],\"dynamicImportLibInfo\":{";
+        for (int i = 0; i < moduleCount; i++) {
+            json += (i == 0 ? "\"" : ",\"") + std::string("lib") + std::to_string(i) +
+                "\":{\"type\":\"har\",\"version\":\"1.0." + std::to_string(i) + "\",\"deps\":[1,2,3]}";
+        }
+        return json + "},\"projectRootPath\":\"/home/user/project\"}";
+    }
+
+    // The maps are read without building a json tree, and match what the tree gives.
+    TEST(JsonStreamReaderTest, LoaderJsonTest)
+    {
+        const int moduleCount = 200;
+        std::string path = "JsonStreamReaderTest_loader.json";
+        {
+            std::ofstream file(path, std::ios::trunc);
+            file << MakeLoaderJson(moduleCount);
+        }
+        MemoryStats::InstallJsonHooks();
+        MemoryStats& stats = MemoryStats::GetInstance();
+        stats.ResetPeak();
+        int64_t jsonBefore = stats.GetCurrent(MemoryTag::JSON);
+        ModulePathHandler handler;
+        EXPECT_TRUE(JsonStreamReader::ParseFile(path, handler));
+        EXPECT_EQ(stats.GetPeak(MemoryTag::JSON), jsonBefore); // no json tree at all
+        Json2::Value root = JsonReader::ParseJsonData2(JsonReader::ReadFile(path));
+        std::map<std::string, std::string> modulePathMap;
+        Json2::Value jsonObj = root["modulePathMap"];
+        for (const auto& key : jsonObj.GetMemberNames()) {
+            modulePathMap[key] = jsonObj[key].AsString();
+        }
+        EXPECT_EQ(handler.modulePathMap, modulePathMap);
+        EXPECT_EQ(modulePathMap.size(), moduleCount);
+        std::remove(path.c_str());
+    }
+}
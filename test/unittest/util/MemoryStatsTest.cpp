@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include "gtest/gtest.h"
+#define private public
+#include "MemoryStats.h"
+#include "cJSON.h"
+
+namespace {
+    TEST(MemoryStatsTest, AllocateTest)
+    {
+        MemoryStats& stats = MemoryStats::GetInstance();
+        int64_t total = stats.GetTotalCurrent();
+        int64_t before = stats.GetCurrent(MemoryTag::HSP_BUFFER);
+        stats.Allocate(MemoryTag::HSP_BUFFER, 1000); // 1000: bytes
+        stats.Allocate(MemoryTag::HSP_BUFFER, 500); // 500: bytes
+        EXPECT_EQ(stats.GetCurrent(MemoryTag::HSP_BUFFER), before + 1500); // 1500: both allocations
+        EXPECT_EQ(stats.GetTotalCurrent(), total + 1500); // 1500: both allocations
+        EXPECT_GE(stats.GetPeak(MemoryTag::HSP_BUFFER), before + 1500); // 1500: both allocations
+        stats.Release(MemoryTag::HSP_BUFFER, 1000); // 1000: bytes
+        EXPECT_EQ(stats.GetCurrent(MemoryTag::HSP_BUFFER), before + 500); // 500: what is left
+        EXPECT_GE(stats.GetPeak(MemoryTag::HSP_BUFFER), before + 1500); // 1500: the peak stays
+        stats.Release(MemoryTag::HSP_BUFFER, 500); // 500: bytes
+        EXPECT_EQ(stats.GetCurrent(MemoryTag::HSP_BUFFER), before);
+        EXPECT_EQ(stats.GetTotalCurrent(), total);
+    }
+
+    TEST(MemoryStatsTest, SetBufferTest)
+    {
+        MemoryStats& stats = MemoryStats::GetInstance();
+        stats.SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, 0);
+        int64_t total = stats.GetTotalCurrent();
+        stats.SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, 4000); // 4000: bytes
+        stats.SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, 3000); // 3000: the buffer is replaced, not added
+        EXPECT_EQ(stats.GetCurrent(MemoryTag::FIRST_IMAGE_BUFFER), 3000);
+        EXPECT_EQ(stats.GetTotalCurrent(), total + 3000); // 3000: bytes
+        EXPECT_GE(stats.GetPeak(MemoryTag::FIRST_IMAGE_BUFFER), 4000); // 4000: the high-water mark
+        stats.SetBuffer(MemoryTag::FIRST_IMAGE_BUFFER, 0);
+        EXPECT_EQ(stats.GetCurrent(MemoryTag::FIRST_IMAGE_BUFFER), 0);
+        EXPECT_EQ(stats.GetTotalCurrent(), total);
+    }
+
+    TEST(MemoryStatsTest, ResetPeakTest)
+    {
+        MemoryStats& stats = MemoryStats::GetInstance();
+        stats.SetBuffer(MemoryTag::LOAD_DOC_TEMP_BUFFER, 8000); // 8000: bytes
+        stats.SetBuffer(MemoryTag::LOAD_DOC_TEMP_BUFFER, 2000); // 2000: bytes
+        EXPECT_GE(stats.GetPeak(MemoryTag::LOAD_DOC_TEMP_BUFFER), 8000); // 8000: the high-water mark
+        stats.ResetPeak();
+        EXPECT_EQ(stats.GetPeak(MemoryTag::LOAD_DOC_TEMP_BUFFER), 2000); // 2000: what is held now
+        EXPECT_EQ(stats.GetTotalPeak(), stats.GetTotalCurrent());
+        stats.SetBuffer(MemoryTag::LOAD_DOC_TEMP_BUFFER, 0);
+    }
+
+    TEST(MemoryStatsTest, InvalidTagTest)
+    {
+        MemoryStats& stats = MemoryStats::GetInstance();
+        int64_t total = stats.GetTotalCurrent();
+        stats.Allocate(MemoryTag::COUNT, 100); // 100: bytes
+        stats.SetBuffer(MemoryTag::COUNT, 100); // 100: bytes
+        EXPECT_EQ(stats.GetTotalCurrent(), total);
+        EXPECT_EQ(stats.GetCurrent(MemoryTag::COUNT), 0);
+        EXPECT_EQ(std::string(MemoryStats::GetTagName(MemoryTag::COUNT)), "");
+    }
+
+    TEST(MemoryStatsTest, ToJsonTest)
+    {
+        MemoryStats& stats = MemoryStats::GetInstance();
+        stats.SetBuffer(MemoryTag::SCREEN_BUFFER, 1234); // 1234: bytes
+        Json2::Value result = JsonReader::CreateObject();
+        stats.ToJson(result);
+        EXPECT_TRUE(result["current"].IsInt());
+        EXPECT_TRUE(result["peak"].IsInt());
+        ASSERT_TRUE(result["tags"].IsObject());
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::COUNT); i++) {
+            EXPECT_TRUE(result["tags"].IsMember(MemoryStats::GetTagName(static_cast<MemoryTag>(i))));
+        }
+        EXPECT_EQ(result["tags"]["screenBuffer"]["current"].AsInt(), 1234); // 1234: bytes
+        stats.SetBuffer(MemoryTag::SCREEN_BUFFER, 0);
+    }
+
+    TEST(MemoryStatsTest, JsonHooksTest)
+    {
+        MemoryStats& stats = MemoryStats::GetInstance();
+        MemoryStats::InstallJsonHooks();
+        int64_t before = stats.current[static_cast<size_t>(MemoryTag::JSON)].load();
+        cJSON* json = cJSON_Parse(R"({"name":"previewer","values":[1,2,3],"nested":{"key":"value"}})");
+        ASSERT_NE(json, nullptr);
+        EXPECT_GT(stats.current[static_cast<size_t>(MemoryTag::JSON)].load(), before);
+        cJSON_Delete(json);
+        EXPECT_EQ(stats.current[static_cast<size_t>(MemoryTag::JSON)].load(), before);
+        cJSON_InitHooks(nullptr);
+    }
+}
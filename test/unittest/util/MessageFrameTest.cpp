@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "MessageFrame.h"
+
+namespace {
+    TEST(MessageFrameTest, EncodeDecodeHeaderTest)
+    {
+        MessageFrameHeader header = { MessageFrame::MAGIC, 1024, MessageFrame::TYPE_JSON, 0, 0x01020304 };
+        uint8_t buffer[MessageFrame::HEADER_SIZE];
+        MessageFrame::EncodeHeader(header, buffer);
+        // the magic is sent in network byte order
+        EXPECT_EQ(buffer[0], 'P');
+        EXPECT_EQ(buffer[3], 'W');
+        MessageFrameHeader decoded = {};
+        EXPECT_TRUE(MessageFrame::DecodeHeader(buffer, decoded));
+        EXPECT_EQ(decoded.magic, header.magic);
+        EXPECT_EQ(decoded.length, header.length);
+        EXPECT_EQ(decoded.type, header.type);
+        EXPECT_EQ(decoded.requestId, header.requestId);
+    }
+
+    TEST(MessageFrameTest, DecodeHeaderTest_Err)
+    {
+        uint8_t buffer[MessageFrame::HEADER_SIZE];
+        MessageFrameHeader decoded = {};
+        // invalid magic
+        MessageFrameHeader header = { 0x12345678, 0, MessageFrame::TYPE_JSON, 0, 0 };
+        MessageFrame::EncodeHeader(header, buffer);
+        EXPECT_FALSE(MessageFrame::DecodeHeader(buffer, decoded));
+        // payload too long
+        header = { MessageFrame::MAGIC, MessageFrame::MAX_PAYLOAD_LENGTH + 1, MessageFrame::TYPE_JSON, 0, 0 };
+        MessageFrame::EncodeHeader(header, buffer);
+        EXPECT_FALSE(MessageFrame::DecodeHeader(buffer, decoded));
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "MpscRing.h"
+
+namespace {
+    TEST(MpscRingTest, ReadInWriteOrderTest)
+    {
+        MpscRing<int, 4> ring;
+        int value = 0;
+        EXPECT_FALSE(ring.TryRead([&value](const int& item) { value = item; }));
+        for (int i = 1; i <= 4; i++) {
+            EXPECT_TRUE(ring.TryWrite([i](int& item) { item = i; }));
+        }
+        // full ring rejects the write instead of overwriting
+        EXPECT_FALSE(ring.TryWrite([](int& item) { item = 5; }));
+        EXPECT_TRUE(ring.TryRead([&value](const int& item) { value = item; }));
+        EXPECT_EQ(value, 1);
+        EXPECT_TRUE(ring.TryWrite([](int& item) { item = 5; }));
+        for (int i = 2; i <= 5; i++) {
+            EXPECT_TRUE(ring.TryRead([&value](const int& item) { value = item; }));
+            EXPECT_EQ(value, i);
+        }
+        EXPECT_FALSE(ring.TryRead([&value](const int& item) { value = item; }));
+    }
+
+    TEST(MpscRingTest, MultiProducerTest)
+    {
+        const int producerCount = 4;
+        const int itemCount = 20000;
+        MpscRing<int, 256> ring;
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < producerCount; producer++) {
+            producers.emplace_back([&ring, producer, itemCount]() {
+                for (int i = 0; i < itemCount; i++) {
+                    while (!ring.TryWrite([producer, i, itemCount](int& item) { item = producer * itemCount + i; })) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        // every item arrives exactly once and each producer's items keep their order
+        std::vector<int> lastItem(producerCount, -1);
+        int received = 0;
+        while (received < producerCount * itemCount) {
+            bool isRead = ring.TryRead([&lastItem](const int& item) {
+                int producer = item / itemCount;
+                EXPECT_EQ(item % itemCount, lastItem[producer] + 1);
+                lastItem[producer] = item % itemCount;
+            });
+            if (isRead) {
+                received++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        for (int producer = 0; producer < producerCount; producer++) {
+            EXPECT_EQ(lastItem[producer], itemCount - 1);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "PerfStats.h"
+
+namespace {
+    TEST(PerfStatsTest, BucketIndexTest)
+    {
+        // small values have a bucket each
+        for (uint64_t value = 0; value < PerfHistogram::SUB_BUCKET_COUNT; value++) {
+            EXPECT_EQ(PerfHistogram::GetBucketIndex(value), value);
+            EXPECT_EQ(PerfHistogram::GetBucketMaxValue(value), value);
+        }
+        // every value lies in its bucket and the bucket is at most 1/16 of the value wide
+        std::vector<uint64_t> values = { 16, 17, 31, 32, 33, 100, 1000, 4095, 4096, 123456789, (1ULL << 39) + 5 };
+        for (uint64_t value : values) {
+            size_t index = PerfHistogram::GetBucketIndex(value);
+            ASSERT_LT(index, PerfHistogram::BUCKET_COUNT);
+            uint64_t maxValue = PerfHistogram::GetBucketMaxValue(index);
+            EXPECT_GE(maxValue, value);
+            EXPECT_LE(maxValue - value, value / PerfHistogram::SUB_BUCKET_COUNT);
+            EXPECT_GT(value, index > 0 ? PerfHistogram::GetBucketMaxValue(index - 1) : 0);
+        }
+        EXPECT_EQ(PerfHistogram::GetBucketIndex(1ULL << 40), PerfHistogram::BUCKET_COUNT - 1);
+        EXPECT_EQ(PerfHistogram::GetBucketIndex(UINT64_MAX), PerfHistogram::BUCKET_COUNT - 1);
+    }
+
+    TEST(PerfStatsTest, PercentileTest)
+    {
+        PerfHistogram histogram;
+        EXPECT_EQ(histogram.GetData().GetPercentile(50), 0);
+        for (uint64_t value = 1; value <= 1000; value++) {
+            histogram.Record(value);
+        }
+        PerfHistogram::Data data = histogram.GetData();
+        EXPECT_EQ(data.count, 1000);
+        EXPECT_EQ(data.sum, 500500);
+        EXPECT_EQ(data.max, 1000);
+        EXPECT_NEAR(data.GetPercentile(50), 500, 500 / PerfHistogram::SUB_BUCKET_COUNT);
+        EXPECT_NEAR(data.GetPercentile(99), 990, 990 / PerfHistogram::SUB_BUCKET_COUNT);
+        EXPECT_EQ(data.GetPercentile(100), 1000);
+    }
+
+    TEST(PerfStatsTest, SubtractTest)
+    {
+        PerfHistogram histogram;
+        histogram.Record(5000);
+        PerfHistogram::Data before = histogram.GetData();
+        histogram.Record(10);
+        histogram.Record(20);
+        PerfHistogram::Data delta = histogram.GetData().Subtract(before);
+        EXPECT_EQ(delta.count, 2);
+        EXPECT_EQ(delta.sum, 30);
+        // the max of the interval comes from its buckets, not from the older 5000
+        EXPECT_EQ(delta.max, 20);
+        EXPECT_EQ(delta.GetPercentile(100), 20);
+    }
+
+    TEST(PerfStatsTest, SnapshotTest)
+    {
+        PerfStats& stats = PerfStats::GetInstance();
+        EXPECT_EQ(&stats.GetCounter("test.counter"), &stats.GetCounter("test.counter"));
+        stats.GetCounter("test.counter").Add(3);
+        stats.GetGauge("test.gauge").Set(7);
+        stats.GetCommandLatency("Test").Record(100);
+        PerfStats::Snapshot first = stats.TakeSnapshot();
+        EXPECT_EQ(first.counters["test.counter"], 3);
+        EXPECT_EQ(first.gauges["test.gauge"], 7);
+        EXPECT_EQ(first.histograms["command.Test.latencyUs"].count, 1);
+
+        stats.GetCounter("test.counter").Add(2);
+        stats.GetCounter(PerfMetric::FRAME_SENT).Add(30);
+        stats.GetGauge("test.gauge").Set(4);
+        PerfStats::Snapshot second = stats.TakeSnapshot();
+        second.time = first.time + 500; // 500: half a second
+        Json2::Value delta = JsonReader::CreateObject();
+        stats.ToJson(second, &first, delta);
+        EXPECT_EQ(delta["intervalMs"].AsInt64(), 500);
+        EXPECT_EQ(delta["counters"]["test.counter"].AsInt64(), 2);
+        EXPECT_EQ(delta["counters"][PerfMetric::FRAME_SENT].AsInt64(), 30);
+        EXPECT_DOUBLE_EQ(delta["fps"].AsDouble(), 60.0);
+        EXPECT_EQ(delta["gauges"]["test.gauge"].AsInt64(), 4);
+        EXPECT_EQ(delta["histograms"]["command.Test.latencyUs"]["count"].AsInt64(), 0);
+
+        Json2::Value totals = JsonReader::CreateObject();
+        stats.ToJson(second, nullptr, totals);
+        EXPECT_EQ(totals["counters"]["test.counter"].AsInt64(), 5);
+        EXPECT_EQ(totals["histograms"]["command.Test.latencyUs"]["p50"].AsInt64(), 100);
+    }
+
+    TEST(PerfStatsTest, MultiThreadTest)
+    {
+        PerfHistogram& histogram = PerfStats::GetInstance().GetHistogram("test.multiThread");
+        PerfCounter& counter = PerfStats::GetInstance().GetCounter("test.multiThread");
+        const int threadCount = 4;
+        const int recordCount = 10000;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++) {
+            threads.emplace_back([&histogram, &counter, recordCount]() {
+                for (int j = 0; j < recordCount; j++) {
+                    histogram.Record(j);
+                    counter.Add();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(histogram.GetData().count, threadCount * recordCount);
+        EXPECT_EQ(histogram.GetData().max, recordCount - 1);
+        EXPECT_EQ(counter.Get(), threadCount * recordCount);
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "gtest/gtest.h"
+#include "AsyncLogger.h"
+#include "PreviewerEngineLog.h"
+
+namespace {
+    std::string CaptureLog(void (*emit)())
+    {
+        FILE* file = tmpfile();
+        if (file == nullptr) {
+            return "";
+        }
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(file);
+        emit();
+        AsyncLogger::GetInstance().Flush();
+        AsyncLogger::GetInstance().SetOutput(stdout);
+        std::string content;
+        char chunk[4096];
+        rewind(file);
+        size_t length = 0;
+        while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            content.append(chunk, length);
+        }
+        fclose(file);
+        return content;
+    }
+
+    size_t CountLines(const std::string& content, const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = content.find(pattern); pos != std::string::npos; pos = content.find(pattern, pos + 1)) {
+            count++;
+        }
+        return count;
+    }
+
+    void EmitRateLimited()
+    {
+        for (int i = 0; i < 100; i++) {
+            ILOG("RateLimitTest %d", i);
+        }
+    }
+
+    class PreviewerEngineLogTest : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            level = PreviewerLog::GetLevel();
+            rateLimit = PreviewerLog::GetRateLimit();
+        }
+        void TearDown() override
+        {
+            PreviewerLog::SetLevel(level);
+            PreviewerLog::SetRateLimit(rateLimit);
+        }
+        int32_t level = PreviewerLog::LEVEL_INFO;
+        uint32_t rateLimit = PreviewerLog::DEFAULT_RATE_LIMIT;
+    };
+
+    TEST_F(PreviewerEngineLogTest, ParseLevelTest)
+    {
+        int32_t value = -1;
+        EXPECT_TRUE(PreviewerLog::ParseLevel("warn", value));
+        EXPECT_EQ(value, PreviewerLog::LEVEL_WARN);
+        EXPECT_STREQ(PreviewerLog::GetLevelName(value), "warn");
+        EXPECT_FALSE(PreviewerLog::ParseLevel("WARNING", value));
+        EXPECT_EQ(value, PreviewerLog::LEVEL_WARN);
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_FATAL + 1);
+        EXPECT_EQ(PreviewerLog::GetLevel(), PreviewerLog::LEVEL_FATAL);
+    }
+
+    TEST_F(PreviewerEngineLogTest, LevelFilterTest)
+    {
+        PreviewerLog::SetRateLimit(0);
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_WARN);
+        std::string content = CaptureLog([]() {
+            DLOG("LevelFilterTest debug");
+            ILOG("LevelFilterTest info");
+            WLOG("LevelFilterTest warn");
+            ELOG("LevelFilterTest error");
+        });
+        EXPECT_EQ(CountLines(content, "LevelFilterTest debug"), 0);
+        EXPECT_EQ(CountLines(content, "LevelFilterTest info"), 0);
+        EXPECT_EQ(CountLines(content, "[WARN]"), 1);
+        EXPECT_EQ(CountLines(content, "[ERROR]"), 1);
+    }
+
+    TEST_F(PreviewerEngineLogTest, RateLimitTest)
+    {
+        const uint32_t rate = 10;
+        PreviewerLog::SetRateLimit(rate);
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_INFO);
+        // one call site: the bucket lets one second of lines through, then refuses
+        std::string content = CaptureLog(EmitRateLimited);
+        EXPECT_EQ(CountLines(content, "RateLimitTest "), rate);
+        content = CaptureLog([]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(150));
+            EmitRateLimited();
+        });
+        // the first line after the refill reports what was dropped before it
+        EXPECT_EQ(CountLines(content, "90 similar lines suppressed"), 1);
+        EXPECT_GE(CountLines(content, "RateLimitTest "), 1);
+    }
+
+    TEST_F(PreviewerEngineLogTest, RateLimitTest_Default)
+    {
+        PreviewerLog::SetRateLimit(PreviewerLog::DEFAULT_RATE_LIMIT);
+        PreviewerLog::SetLevel(PreviewerLog::LEVEL_INFO);
+        // without -logRate no line is dropped
+        std::string content = CaptureLog(EmitRateLimited);
+        EXPECT_EQ(CountLines(content, "RateLimitTest "), 100); // 100 lines emitted
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "gtest/gtest.h"
+#define private public
+#include "TraceEvent.h"
+
+namespace {
+    size_t CountOf(const std::string& content, const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = content.find(pattern); pos != std::string::npos; pos = content.find(pattern, pos + 1)) {
+            count++;
+        }
+        return count;
+    }
+
+    void RecordSpans(int count)
+    {
+        for (int i = 0; i < count; i++) {
+            TRACE_EVENT_SCOPE("TraceEventTest");
+        }
+    }
+
+    TEST(TraceEventTest, DisabledTest)
+    {
+        TraceEvent::GetInstance().SetEnabled(true);
+        TraceEvent::GetInstance().SetEnabled(false);
+        RecordSpans(10);
+        EXPECT_EQ(TraceEvent::GetInstance().GetEventCount(), 0);
+    }
+
+    TEST(TraceEventTest, ToJsonTest)
+    {
+        TraceEvent::GetInstance().SetEnabled(true);
+        RecordSpans(3);
+        std::thread(RecordSpans, 2).join();
+        TraceEvent::GetInstance().SetEnabled(false);
+        size_t eventCount = 0;
+        std::string json = TraceEvent::GetInstance().ToJson(eventCount);
+        EXPECT_EQ(eventCount, 5);
+        EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+        EXPECT_EQ(CountOf(json, "\"name\":\"TraceEventTest\",\"cat\":\"previewer\",\"ph\":\"X\""), 5);
+        // spans of the two threads carry different thread ids
+        EXPECT_EQ(CountOf(json, "\"tid\":"), 5);
+        // a new recording drops the spans of the previous one
+        TraceEvent::GetInstance().SetEnabled(true);
+        RecordSpans(1);
+        TraceEvent::GetInstance().SetEnabled(false);
+        EXPECT_EQ(TraceEvent::GetInstance().GetEventCount(), 1);
+    }
+
+    TEST(TraceEventTest, RingOverwriteTest)
+    {
+        TraceEvent::GetInstance().SetEnabled(true);
+        RecordSpans(TraceEvent::RING_CAPACITY + 100);
+        TraceEvent::GetInstance().SetEnabled(false);
+        EXPECT_EQ(TraceEvent::GetInstance().GetEventCount(), TraceEvent::RING_CAPACITY);
+    }
+
+    TEST(TraceEventTest, DumpTest)
+    {
+        TraceEvent::GetInstance().SetEnabled(true);
+        RecordSpans(4);
+        TraceEvent::GetInstance().SetEnabled(false);
+        std::string path = "trace_event_test.json";
+        EXPECT_EQ(TraceEvent::GetInstance().Dump(path), 4);
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        EXPECT_EQ(CountOf(content.str(), "\"ph\":\"X\""), 4);
+        std::remove(path.c_str());
+        EXPECT_EQ(TraceEvent::GetInstance().Dump("/nonexistent_dir/trace_event_test.json"), -1);
+    }
+}
@@ -13,9 +13,13 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <string>
+#include <thread>
 #include "gtest/gtest.h"
 #define private public
 #include "TraceTool.h"
+#include "MockGlobalResult.h"
 
 namespace {
     TEST(TraceToolTest, HandleTraceTest)
@@ -32,4 +36,53 @@ namespace {
         TraceTool::GetInstance().HandleTrace("sendmsg");
         EXPECT_FALSE(TraceTool::GetInstance().isReady);
     }
-}
\ No newline at end of file
+
+    TEST(TraceToolTest, HandleTraceTest_Flush)
+    {
+        TraceTool::GetInstance().InitPipe();
+        g_output = false;
+        TraceTool::GetInstance().HandleTrace("sendmsg");
+        TraceTool::GetInstance().Flush();
+        EXPECT_TRUE(g_output);
+        EXPECT_FALSE(TraceTool::GetInstance().ring.TryRead([](const TraceTool::TraceRecord&) {}));
+    }
+
+    TEST(TraceToolTest, HandleTraceTest_Truncate)
+    {
+        TraceTool::GetInstance().InitPipe();
+        TraceTool::GetInstance().StopWriter();
+        std::string action(TraceTool::MAX_ACTION_LENGTH * 2, 'a');
+        TraceTool::GetInstance().HandleTrace(action.c_str());
+        size_t length = 0;
+        EXPECT_TRUE(TraceTool::GetInstance().ring.TryRead([&length](const TraceTool::TraceRecord& record) {
+            length = record.length;
+        }));
+        EXPECT_EQ(length, TraceTool::MAX_ACTION_LENGTH);
+    }
+
+    TEST(TraceToolTest, HandleTraceTest_DropWhenFull)
+    {
+        TraceTool::GetInstance().InitPipe();
+        // without the writer thread nothing drains the ring
+        TraceTool::GetInstance().StopWriter();
+        uint64_t dropped = TraceTool::GetInstance().GetDroppedCount();
+        for (size_t i = 0; i < TraceTool::RING_CAPACITY + 10; i++) {
+            TraceTool::GetInstance().HandleTrace("sendmsg");
+        }
+        EXPECT_EQ(TraceTool::GetInstance().GetDroppedCount(), dropped + 10);
+        TraceTool::GetInstance().Flush();
+        EXPECT_FALSE(TraceTool::GetInstance().ring.TryRead([](const TraceTool::TraceRecord&) {}));
+    }
+
+    TEST(TraceToolTest, HandleTraceTest_WakeWriter)
+    {
+        TraceTool::GetInstance().InitPipe();
+        g_output = false;
+        TraceTool::GetInstance().HandleTrace("sendmsg");
+        // the idle writer is woken up by the record, no Flush
+        for (int i = 0; i < 1000 && !g_output; i++) { // 1000: waits 1 s at most
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_TRUE(g_output);
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#include "MpscRing.h"
+#include "WakeSignal.h"
+
+namespace {
+    TEST(WakeSignalTest, NotifyTest)
+    {
+        WakeSignal signal;
+        // nobody waits, nothing is signalled
+        signal.Notify();
+        EXPECT_FALSE(signal.isSignalled);
+        signal.PrepareWait();
+        signal.CancelWait();
+        signal.Notify();
+        EXPECT_FALSE(signal.isSignalled);
+        signal.PrepareWait();
+        std::thread producer([&signal]() { signal.Notify(); });
+        signal.Wait();
+        producer.join();
+        EXPECT_FALSE(signal.isSignalled);
+        EXPECT_FALSE(signal.isWaiting);
+    }
+
+    TEST(WakeSignalTest, StopTest)
+    {
+        WakeSignal signal;
+        std::thread consumer([&signal]() {
+            signal.PrepareWait();
+            signal.Wait();
+        });
+        signal.Stop();
+        consumer.join();
+        EXPECT_TRUE(signal.IsStopped());
+        signal.Restart();
+        EXPECT_FALSE(signal.IsStopped());
+    }
+
+    TEST(WakeSignalTest, NoLostWakeupTest)
+    {
+        const int producerCount = 4;
+        const int itemCount = 20000;
+        MpscRing<int, 64> ring;
+        WakeSignal signal;
+        std::atomic<int> received(0);
+        std::thread consumer([&ring, &signal, &received]() {
+            auto read = [&received](const int& item) { received++; };
+            while (!signal.IsStopped()) {
+                signal.PrepareWait();
+                if (ring.TryRead(read)) {
+                    signal.CancelWait();
+                    continue;
+                }
+                signal.Wait();
+            }
+        });
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < producerCount; producer++) {
+            producers.emplace_back([&ring, &signal, itemCount]() {
+                for (int i = 0; i < itemCount; i++) {
+                    while (!ring.TryWrite([i](int& item) { item = i; })) {
+                        std::this_thread::yield();
+                    }
+                    signal.Notify();
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        // every item is read without a further Notify, a lost wakeup would hang here
+        while (received < producerCount * itemCount) {
+            std::this_thread::yield();
+        }
+        signal.Stop();
+        consumer.join();
+        EXPECT_EQ(received, producerCount * itemCount);
+    }
+}
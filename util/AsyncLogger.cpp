@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncLogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+#include "TimeTool.h"
+#include "securec.h"
+
+namespace {
+    constexpr size_t TIME_TEXT_SIZE = 32;
+    constexpr int64_t MILLISECOND_PERSECOND = 1000;
+    constexpr int DECIMAL_BASE = 10;
+    constexpr size_t MILLISECOND_DIGITS = 3;
+}
+
+// Trivially destructible, so they stay usable while the thread's other thread_locals are destroyed.
+static thread_local void* g_threadBuffer = nullptr;
+static thread_local bool g_isThreadExited = false;
+
+AsyncLogger& AsyncLogger::GetInstance()
+{
+    // Never destroyed: logs are still written while other singletons shut down.
+    static AsyncLogger* instance = new AsyncLogger();
+    return *instance;
+}
+
+AsyncLogger::AsyncLogger() : isRunning(true), output(stdout), outputFd(fileno(stdout))
+{
+    for (auto& buffer : crashBuffers) {
+        buffer = nullptr;
+    }
+    writer = std::thread(&AsyncLogger::RunWriter, this);
+    atexit([]() { AsyncLogger::GetInstance().Stop(); });
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    Stop();
+}
+
+void AsyncLogger::Write(const char* line, size_t length)
+{
+    if (!isRunning.load(std::memory_order_acquire)) {
+        WriteDirect(line, length);
+        return;
+    }
+    LineBuffer* buffer = GetThreadBuffer();
+    if (buffer == nullptr) {
+        WriteDirect(line, length);
+        return;
+    }
+    if (buffer->Write(line, length)) {
+        wakeSignal.Notify();
+        return;
+    }
+    // The ring is full: the caller drains the rings itself rather than lose the line.
+    Drain();
+    if (!buffer->Write(line, length)) {
+        WriteDirect(line, length);
+    }
+}
+
+void AsyncLogger::Flush()
+{
+    Drain();
+}
+
+void AsyncLogger::FlushOnCrash()
+{
+    // The crashed thread may hold any lock, including the one of the output FILE, so only
+    // atomics and write(2) are used here.
+    int fd = outputFd.load(std::memory_order_acquire);
+    if (fd < 0) {
+        return;
+    }
+    for (auto& slot : crashBuffers) {
+        LineBuffer* buffer = slot.load(std::memory_order_acquire);
+        if (buffer != nullptr) {
+            buffer->CopyOnCrash(fd);
+        }
+    }
+}
+
+void AsyncLogger::Stop()
+{
+    isRunning = false;
+    wakeSignal.Stop();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    Drain();
+}
+
+void AsyncLogger::SetOutput(FILE* file)
+{
+    std::lock_guard<std::mutex> lock(drainMutex);
+    output = file;
+    outputFd.store(file == nullptr ? -1 : fileno(file), std::memory_order_release);
+}
+
+const char* AsyncLogger::GetTimeText()
+{
+    static thread_local int64_t cachedSecond = -1;
+    static thread_local size_t millisecondOffset = 0;
+    static thread_local char timeText[TIME_TEXT_SIZE] = { 0 };
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    int64_t millisecond = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    int64_t second = millisecond / MILLISECOND_PERSECOND;
+    if (second != cachedSecond) {
+        std::string text = TimeTool::GetFormatTime(now);
+        if (text.length() < MILLISECOND_DIGITS + 1 || strcpy_s(timeText, sizeof(timeText), text.c_str()) != EOK) {
+            return "";
+        }
+        cachedSecond = second;
+        millisecondOffset = text.length() - MILLISECOND_DIGITS - 1; // digits before the closing ']'
+        return timeText;
+    }
+    int64_t rest = millisecond % MILLISECOND_PERSECOND;
+    for (size_t i = MILLISECOND_DIGITS; i > 0; i--) {
+        timeText[millisecondOffset + i - 1] = static_cast<char>('0' + rest % DECIMAL_BASE);
+        rest /= DECIMAL_BASE;
+    }
+    return timeText;
+}
+
+AsyncLogger::LineBuffer::LineBuffer() : isClosed(false), writePos(0), readPos(0) {}
+
+bool AsyncLogger::LineBuffer::Write(const char* line, size_t length)
+{
+    size_t pos = writePos.load(std::memory_order_relaxed);
+    size_t used = pos - readPos.load(std::memory_order_acquire);
+    if (length > CAPACITY - used) {
+        return false;
+    }
+    size_t offset = pos % CAPACITY;
+    size_t first = std::min(length, CAPACITY - offset);
+    if (memcpy_s(data + offset, CAPACITY - offset, line, first) != EOK ||
+        (length > first && memcpy_s(data, CAPACITY, line + first, length - first) != EOK)) {
+        return false;
+    }
+    writePos.store(pos + length, std::memory_order_release);
+    return true;
+}
+
+size_t AsyncLogger::LineBuffer::Read(FILE* file)
+{
+    size_t pos = readPos.load(std::memory_order_relaxed);
+    size_t end = writePos.load(std::memory_order_acquire);
+    size_t length = end - pos;
+    if (length == 0) {
+        return 0;
+    }
+    size_t offset = pos % CAPACITY;
+    size_t first = std::min(length, CAPACITY - offset);
+    if (file != nullptr) {
+        fwrite(data + offset, 1, first, file);
+        if (length > first) {
+            fwrite(data, 1, length - first, file);
+        }
+    }
+    readPos.store(end, std::memory_order_release);
+    return length;
+}
+
+void AsyncLogger::LineBuffer::CopyOnCrash(int fd) const
+{
+    size_t pos = readPos.load(std::memory_order_acquire);
+    size_t length = writePos.load(std::memory_order_acquire) - pos;
+    if (length == 0 || length > CAPACITY) {
+        return;
+    }
+    size_t offset = pos % CAPACITY;
+    size_t first = std::min(length, CAPACITY - offset);
+    ssize_t result = write(fd, data + offset, first);
+    if (result >= 0 && length > first) {
+        result = write(fd, data, length - first);
+    }
+    (void)result; // nothing left to report a failed write to
+}
+
+bool AsyncLogger::LineBuffer::IsEmpty() const
+{
+    return readPos.load(std::memory_order_acquire) == writePos.load(std::memory_order_acquire);
+}
+
+AsyncLogger::BufferOwner::~BufferOwner()
+{
+    if (buffer != nullptr) {
+        buffer->isClosed = true;
+    }
+    g_threadBuffer = nullptr;
+    g_isThreadExited = true;
+}
+
+AsyncLogger::LineBuffer* AsyncLogger::GetThreadBuffer()
+{
+    if (g_threadBuffer != nullptr) {
+        return static_cast<LineBuffer*>(g_threadBuffer);
+    }
+    if (g_isThreadExited) {
+        return nullptr;
+    }
+    static thread_local BufferOwner owner;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        // A drained ring of a finished thread is taken over, so rings are never freed under FlushOnCrash.
+        auto reusable = std::find_if(buffers.begin(), buffers.end(), [](const std::shared_ptr<LineBuffer>& buffer) {
+            return buffer->isClosed && buffer->IsEmpty();
+        });
+        if (reusable != buffers.end()) {
+            owner.buffer = *reusable;
+            owner.buffer->isClosed = false;
+        } else {
+            owner.buffer = std::make_shared<LineBuffer>();
+            buffers.push_back(owner.buffer);
+            if (buffers.size() <= MAX_CRASH_BUFFERS) {
+                crashBuffers[buffers.size() - 1].store(owner.buffer.get(), std::memory_order_release);
+            }
+        }
+    }
+    g_threadBuffer = owner.buffer.get();
+    return owner.buffer.get();
+}
+
+void AsyncLogger::WriteDirect(const char* line, size_t length)
+{
+    std::lock_guard<std::mutex> lock(drainMutex);
+    if (output == nullptr) {
+        return;
+    }
+    fwrite(line, 1, length, output);
+    fflush(output);
+}
+
+void AsyncLogger::RunWriter()
+{
+    while (!wakeSignal.IsStopped()) {
+        size_t length = Drain();
+        if (length >= MAX_BUSY_LENGTH) {
+            continue;
+        }
+        if (length > 0) {
+            wakeSignal.Sleep(FLUSH_INTERVAL);
+            continue;
+        }
+        // Checked again once producers know the writer may sleep, so no signal is missed.
+        wakeSignal.PrepareWait();
+        if (Drain() > 0) {
+            wakeSignal.CancelWait();
+            continue;
+        }
+        wakeSignal.Wait();
+    }
+}
+
+size_t AsyncLogger::Drain()
+{
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+    std::vector<std::shared_ptr<LineBuffer>> current;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        current = buffers;
+    }
+    size_t length = 0;
+    for (auto& buffer : current) {
+        length += buffer->Read(output);
+    }
+    if (length > 0 && output != nullptr) {
+        fflush(output);
+    }
+    return length;
+}
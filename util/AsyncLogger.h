@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNCLOGGER_H
+#define ASYNCLOGGER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WakeSignal.h"
+
+// Every logging thread appends complete lines to its own byte ring, and a writer thread
+// drains all rings to the output with one flush per pass. Callers take no lock unless
+// it is the thread's first line or its ring is full.
+class AsyncLogger {
+public:
+    static AsyncLogger& GetInstance();
+    // Any thread. Queues one complete line; only waits when the thread's ring is full.
+    // Once the logger is stopped the line is written directly instead.
+    void Write(const char* line, size_t length);
+    // Writes every queued line before returning.
+    void Flush();
+    // From a crash handler: copies the queued lines to the output with write(2) only, takes no lock and
+    // leaves the rings as they are, so a line being drained at that moment may appear twice.
+    void FlushOnCrash();
+    // Drains the rings and joins the writer thread. Runs at exit.
+    void Stop();
+    void SetOutput(FILE* file);
+    // "[time]" text of the current millisecond, rebuilt at most once per second per thread.
+    static const char* GetTimeText();
+
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+    AsyncLogger(const AsyncLogger&) = delete;
+
+    // Single-producer single-consumer ring; the owner thread writes, the writer thread reads.
+    class LineBuffer {
+    public:
+        LineBuffer();
+        bool Write(const char* line, size_t length);
+        size_t Read(FILE* file);
+        void CopyOnCrash(int fd) const;
+        bool IsEmpty() const;
+        std::atomic<bool> isClosed;
+
+    private:
+        static constexpr size_t CAPACITY = 256 * 1024;
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> writePos;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> readPos;
+        alignas(CACHE_LINE_SIZE) char data[CAPACITY];
+    };
+    // Closes the thread's ring when the thread exits so the next new thread can take it over.
+    struct BufferOwner {
+        ~BufferOwner();
+        std::shared_ptr<LineBuffer> buffer;
+    };
+    static constexpr int64_t FLUSH_INTERVAL = 5; // ms between the passes while lines keep coming
+    static constexpr size_t MAX_BUSY_LENGTH = 64 * 1024; // a pass this large goes round again at once
+    static constexpr size_t MAX_CRASH_BUFFERS = 64; // rings FlushOnCrash reaches, one per live logging thread
+
+    LineBuffer* GetThreadBuffer();
+    void WriteDirect(const char* line, size_t length);
+    void RunWriter();
+    size_t Drain();
+
+    std::atomic<bool> isRunning;
+    FILE* output;
+    std::mutex buffersMutex; // guards buffers
+    std::vector<std::shared_ptr<LineBuffer>> buffers; // never shrinks, a ring outlives its thread
+    // The first rings again, readable from a signal handler without buffersMutex.
+    std::atomic<LineBuffer*> crashBuffers[MAX_CRASH_BUFFERS];
+    std::atomic<int> outputFd; // descriptor of output, -1 when there is none
+    std::mutex drainMutex; // one reader at a time, and direct writes
+    WakeSignal wakeSignal; // Write wakes up the idle writer
+    std::thread writer;
+};
+
+#endif // ASYNCLOGGER_H
@@ -51,7 +51,11 @@ CommandParser::CommandParser()
 #endif // COMPONENT_TEST_ENABLED
       staticCard(false),
       sid(""),
-      srmPath("")
+      srmPath(""),
+      recordPath(""),
+      replayPath(""),
+      replaySpeed(1.0),
+      replayReportPath("")
 {
     Register("-j", 1, "Launch the js app in <directory>.");
     Register("-n", 1, "Set the js app name show on <window title>.");
@@ -99,6 +103,12 @@ CommandParser::CommandParser()
     Register("-sid", 1, "Set sid for websocket");
     Register("-ilt", 1, "Set enable file opertaion for mock");
     Register("-srmPath", 1, "Set system route path");
+    Register("-logLevel", 1, "Set the lowest log <level>: debug, info, warn, error or fatal.");
+    Register("-logRate", 1, "Set the max <lines> per second of one log call site, 0 means unlimited.");
+    Register("-record", 1, "Record the commands received to <path> for replay.");
+    Register("-replay", 1, "Replay the commands recorded in <path> instead of reading the command pipe.");
+    Register("-replaySpeed", 1, "Replay <factor> times as fast as recorded, 0 runs the commands back to back.");
+    Register("-replayReport", 1, "Write the latency and frame statistics of the replay to <path>.");
 }
 
 CommandParser& CommandParser::GetInstance()
@@ -130,7 +140,8 @@ bool CommandParser::ProcessCommand(std::vector<std::string> strs)
 
 bool CommandParser::IsCommandValid()
 {
-    bool partRet = IsDebugPortValid() && IsAppPathValid() && IsAppNameValid() && IsResolutionValid();
+    bool partRet = IsLogLevelValid() && IsLogRateValid();
+    partRet = partRet && IsDebugPortValid() && IsAppPathValid() && IsAppNameValid() && IsResolutionValid();
     partRet = partRet && IsConfigPathValid() && IsJsHeapValid() && IsJsHeapFlagValid() && IsScreenShapeValid();
     partRet = partRet && IsDeviceValid() && IsUrlValid() && IsRefreshValid() && IsCardValid() && IsProjectIDValid();
     partRet = partRet && IsColorModeValid() && IsOrientationValid() && IsWebSocketPortValid() && IsAceVersionValid();
@@ -141,6 +152,7 @@ bool CommandParser::IsCommandValid()
     partRet = partRet && IsAbilityNameValid() && IsLanguageValid() && IsTracePipeNameValid();
     partRet = partRet && IsLocalSocketNameValid() && IsConfigChangesValid() && IsScreenDensityValid();
     partRet = partRet && IsSidValid() && EnableFileOperationValid() && IsSrmPathValid();
+    partRet = partRet && IsRecordValid() && IsReplayValid();
     if (partRet) {
         return true;
     }
@@ -1122,4 +1134,112 @@ bool CommandParser::IsSrmPathValid()
     }
     srmPath = path;
     return true;
-}
\ No newline at end of file
+}
+
+std::string CommandParser::GetRecordPath() const
+{
+    return recordPath;
+}
+
+std::string CommandParser::GetReplayPath() const
+{
+    return replayPath;
+}
+
+double CommandParser::GetReplaySpeed() const
+{
+    return replaySpeed;
+}
+
+std::string CommandParser::GetReplayReportPath() const
+{
+    return replayReportPath;
+}
+
+bool CommandParser::IsRecordValid()
+{
+    if (!IsSet("record")) {
+        return true;
+    }
+    if (IsSet("replay")) {
+        errorInfo = std::string("Launch -record and -replay can not be used together.");
+        ELOG("Launch -record parameters abnormal!");
+        return false;
+    }
+    if (Value("record").empty()) {
+        errorInfo = std::string("The record path is empty.");
+        ELOG("Launch -record parameters abnormal!");
+        return false;
+    }
+    recordPath = Value("record");
+    return true;
+}
+
+bool CommandParser::IsReplayValid()
+{
+    if (!IsSet("replay")) {
+        if (IsSet("replaySpeed") || IsSet("replayReport")) {
+            errorInfo = std::string("Launch -replaySpeed and -replayReport need -replay.");
+            ELOG("Launch -replay parameters abnormal!");
+            return false;
+        }
+        return true;
+    }
+    if (!FileSystem::IsFileExists(Value("replay"))) {
+        errorInfo = std::string("The replay recording does not exist.");
+        ELOG("Launch -replay parameters abnormal!");
+        return false;
+    }
+    if (IsSet("replaySpeed")) {
+        if (CheckParamInvalidity(Value("replaySpeed"), true)) {
+            errorInfo = "Launch -replaySpeed parameter is not match regex.";
+            return false;
+        }
+        double speed = atof(Value("replaySpeed").c_str());
+        if (speed > MAX_REPLAY_SPEED) {
+            errorInfo = std::string("Replay speed out of range: 0-" + std::to_string(static_cast<int>(MAX_REPLAY_SPEED)) + ".");
+            ELOG("Launch -replaySpeed parameters abnormal!");
+            return false;
+        }
+        replaySpeed = speed;
+    }
+    if (IsSet("replayReport")) {
+        replayReportPath = Value("replayReport");
+    }
+    replayPath = Value("replay");
+    return true;
+}
+
+bool CommandParser::IsLogLevelValid()
+{
+    if (!IsSet("logLevel")) {
+        return true;
+    }
+    int32_t level = PreviewerLog::LEVEL_INFO;
+    if (!PreviewerLog::ParseLevel(Value("logLevel"), level)) {
+        errorInfo = "Launch -logLevel parameter supported: debug, info, warn, error or fatal.";
+        ELOG("Launch -logLevel parameter abnormal!");
+        return false;
+    }
+    PreviewerLog::SetLevel(level);
+    return true;
+}
+
+bool CommandParser::IsLogRateValid()
+{
+    if (!IsSet("logRate")) {
+        return true;
+    }
+    if (CheckParamInvalidity(Value("logRate"), true)) {
+        errorInfo = "Launch -logRate parameter is not match regex.";
+        return false;
+    }
+    long rate = atol(Value("logRate").c_str());
+    if (rate < 0 || rate > static_cast<long>(PreviewerLog::MAX_RATE_LIMIT)) {
+        errorInfo = std::string("Log rate out of range: 0-" + std::to_string(PreviewerLog::MAX_RATE_LIMIT) + ".");
+        ELOG("Launch -logRate parameter abnormal!");
+        return false;
+    }
+    PreviewerLog::SetRateLimit(static_cast<uint32_t>(rate));
+    return true;
+}
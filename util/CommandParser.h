@@ -103,6 +103,10 @@ public:
 #endif // COMPONENT_TEST_ENABLED
     std::string GetSid() const;
     std::string GetSrmPath() const;
+    std::string GetRecordPath() const;
+    std::string GetReplayPath() const;
+    double GetReplaySpeed() const;
+    std::string GetReplayReportPath() const;
 
 private:
     CommandParser();
@@ -132,6 +136,7 @@ private:
     const int MAX_JSHEAPSIZE = 512 * 1024;
     const int MIN_JSHEAPSIZE = 48 * 1024;
     const size_t MAX_NAME_LENGTH = 256;
+    const double MAX_REPLAY_SPEED = 1000.0;
     bool isSendJSHeap;
     int32_t orignalResolutionWidth;
     int32_t orignalResolutionHeight;
@@ -171,6 +176,10 @@ private:
     std::string loaderJsonPath;
     std::string sid;
     std::string srmPath;
+    std::string recordPath;
+    std::string replayPath;
+    double replaySpeed;
+    std::string replayReportPath;
 
     bool IsDebugPortValid();
     bool IsAppPathValid();
@@ -198,6 +207,8 @@ private:
     bool IsLanguageValid();
     bool IsTracePipeNameValid();
     bool IsLocalSocketNameValid();
+    bool IsLogLevelValid();
+    bool IsLogRateValid();
     bool IsScreenDensityValid();
     bool IsConfigChangesValid();
     bool IsContainerSdkPathValid();
@@ -212,6 +223,8 @@ private:
     bool IsLoaderJsonPathValid();
     bool IsSidValid();
     bool IsSrmPathValid();
+    bool IsRecordValid();
+    bool IsReplayValid();
     std::string HelpText();
     void ProcessingCommand(const std::vector<std::string>& strs);
 };
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Compression.h"
+
+#include <cstdint>
+
+#include "PreviewerEngineLog.h"
+#include "zlib.h"
+
+namespace {
+    const char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    constexpr size_t BASE64_GROUP_SIZE = 3;
+    constexpr size_t BASE64_CHARS_PER_GROUP = 4;
+    constexpr int BASE64_BITS_PER_CHAR = 6;
+    constexpr uint32_t BASE64_CHAR_MASK = 0x3F;
+    constexpr int BITS_PER_BYTE = 8;
+
+    int DecodeBase64Char(char c)
+    {
+        if (c >= 'A' && c <= 'Z') {
+            return c - 'A';
+        }
+        if (c >= 'a' && c <= 'z') {
+            return c - 'a' + 26; // 26 letters before lower case
+        }
+        if (c >= '0' && c <= '9') {
+            return c - '0' + 52; // 52 letters before digits
+        }
+        if (c == '+') {
+            return 62; // 62 is the index of '+'
+        }
+        if (c == '/') {
+            return 63; // 63 is the index of '/'
+        }
+        return -1;
+    }
+}
+
+namespace Compression {
+    bool Deflate(const std::string& input, std::string& output, int level)
+    {
+        uLongf length = compressBound(static_cast<uLong>(input.size()));
+        output.resize(length);
+        int ret = compress2(reinterpret_cast<Bytef*>(&output[0]), &length,
+            reinterpret_cast<const Bytef*>(input.data()), static_cast<uLong>(input.size()), level);
+        if (ret != Z_OK) {
+            ELOG("Compression::Deflate failed, ret: %d", ret);
+            output.clear();
+            return false;
+        }
+        output.resize(length);
+        return true;
+    }
+
+    bool Inflate(const std::string& input, size_t length, std::string& output)
+    {
+        if (length > MAX_INFLATED_LENGTH) {
+            ELOG("Compression::Inflate length must <= %zu", MAX_INFLATED_LENGTH);
+            return false;
+        }
+        output.resize(length);
+        uLongf outputLength = static_cast<uLongf>(length);
+        int ret = uncompress(reinterpret_cast<Bytef*>(&output[0]), &outputLength,
+            reinterpret_cast<const Bytef*>(input.data()), static_cast<uLong>(input.size()));
+        if (ret != Z_OK || outputLength != length) {
+            ELOG("Compression::Inflate failed, ret: %d", ret);
+            output.clear();
+            return false;
+        }
+        return true;
+    }
+
+    std::string EncodeBase64(const std::string& input)
+    {
+        std::string output;
+        output.reserve((input.size() + BASE64_GROUP_SIZE - 1) / BASE64_GROUP_SIZE * BASE64_CHARS_PER_GROUP);
+        size_t i = 0;
+        for (; i + BASE64_GROUP_SIZE <= input.size(); i += BASE64_GROUP_SIZE) {
+            uint32_t group = (static_cast<uint8_t>(input[i]) << (BITS_PER_BYTE * 2)) | // 2 bytes follow
+                (static_cast<uint8_t>(input[i + 1]) << BITS_PER_BYTE) | static_cast<uint8_t>(input[i + 2]);
+            output += BASE64_CHARS[(group >> (BASE64_BITS_PER_CHAR * 3)) & BASE64_CHAR_MASK]; // first of 4
+            output += BASE64_CHARS[(group >> (BASE64_BITS_PER_CHAR * 2)) & BASE64_CHAR_MASK]; // second of 4
+            output += BASE64_CHARS[(group >> BASE64_BITS_PER_CHAR) & BASE64_CHAR_MASK];
+            output += BASE64_CHARS[group & BASE64_CHAR_MASK];
+        }
+        size_t rest = input.size() - i;
+        if (rest > 0) {
+            uint32_t group = static_cast<uint8_t>(input[i]) << (BITS_PER_BYTE * 2); // 2 bytes follow
+            if (rest > 1) {
+                group |= static_cast<uint8_t>(input[i + 1]) << BITS_PER_BYTE;
+            }
+            output += BASE64_CHARS[(group >> (BASE64_BITS_PER_CHAR * 3)) & BASE64_CHAR_MASK]; // first of 4
+            output += BASE64_CHARS[(group >> (BASE64_BITS_PER_CHAR * 2)) & BASE64_CHAR_MASK]; // second of 4
+            output += (rest > 1) ? BASE64_CHARS[(group >> BASE64_BITS_PER_CHAR) & BASE64_CHAR_MASK] : '=';
+            output += '=';
+        }
+        return output;
+    }
+
+    bool DecodeBase64(const std::string& input, std::string& output)
+    {
+        if (input.size() % BASE64_CHARS_PER_GROUP != 0) {
+            return false;
+        }
+        output.clear();
+        output.reserve(input.size() / BASE64_CHARS_PER_GROUP * BASE64_GROUP_SIZE);
+        uint32_t group = 0;
+        int bits = 0;
+        for (size_t i = 0; i < input.size(); i++) {
+            if (input[i] == '=') {
+                // padding is only allowed in the last two places
+                return i + 2 >= input.size() && (i + 1 == input.size() || input[i + 1] == '='); // 2 padding chars
+            }
+            int value = DecodeBase64Char(input[i]);
+            if (value < 0) {
+                return false;
+            }
+            group = (group << BASE64_BITS_PER_CHAR) | static_cast<uint32_t>(value);
+            bits += BASE64_BITS_PER_CHAR;
+            if (bits >= BITS_PER_BYTE) {
+                bits -= BITS_PER_BYTE;
+                output += static_cast<char>((group >> bits) & 0xFF);
+            }
+        }
+        return true;
+    }
+};
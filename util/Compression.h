@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <cstddef>
+#include <string>
+
+// zlib (RFC 1950) compression for large command replies, plus the base64 encoding needed to
+// carry the compressed bytes in a text protocol message.
+namespace Compression {
+    constexpr int FAST_LEVEL = 1; // the IDE waits for the reply, favour speed over ratio
+    constexpr size_t MAX_INFLATED_LENGTH = 256 * 1024 * 1024;
+
+    bool Deflate(const std::string& input, std::string& output, int level = FAST_LEVEL);
+    // length is the size of the original data, it is sent along with the compressed data.
+    bool Inflate(const std::string& input, size_t length, std::string& output);
+    std::string EncodeBase64(const std::string& input);
+    bool DecodeBase64(const std::string& input, std::string& output);
+}; // namespace Compression
+
+#endif // COMPRESSION_H
@@ -76,3 +76,14 @@ void CppTimer::RunTimerTick(CallbackQueue& queue)
         shotTimes--;
     }
 }
+
+int64_t CppTimer::GetRemainingTime() const
+{
+    if (interval == 0 || !isRunning || shotTimes == 0) {
+        return -1;
+    }
+
+    auto endTime = std::chrono::system_clock::now();
+    int64_t timePassed = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    return (timePassed >= interval) ? 0 : interval - timePassed;
+}
@@ -73,6 +73,9 @@ public:
 
     void RunTimerTick(CallbackQueue& queue);
 
+    // Milliseconds until the timer is due, -1 if it will not fire.
+    int64_t GetRemainingTime() const;
+
 private:
     int64_t interval;
     int32_t shotTimes;
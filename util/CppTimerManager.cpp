@@ -57,3 +57,15 @@ void CppTimerManager::RunTimerTick()
 
     callbackQueue.ConsumingCallback();
 }
+
+int64_t CppTimerManager::GetNextTimeout() const
+{
+    int64_t nextTimeout = -1;
+    for (const CppTimer* timer : runningTimers) {
+        int64_t remaining = timer->GetRemainingTime();
+        if (remaining >= 0 && (nextTimeout < 0 || remaining < nextTimeout)) {
+            nextTimeout = remaining;
+        }
+    }
+    return nextTimeout;
+}
@@ -37,6 +37,8 @@ public:
     void RemoveCppTimer(CppTimer& timer);
 
     void RunTimerTick();
+    // Milliseconds until the earliest running timer is due, -1 if no timer will fire.
+    int64_t GetNextTimeout() const;
 
 private:
     std::list<CppTimer*> runningTimers;
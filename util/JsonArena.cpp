@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JsonArena.h"
+
+#include <cstdlib>
+
+#include "cJSON.h"
+
+namespace {
+    thread_local bool g_isScopeOpen = false;
+    std::atomic<bool> g_isInstalled(false);
+    void* (*g_heapMalloc)(size_t) = malloc;
+    void (*g_heapFree)(void*) = free;
+}
+
+JsonArena::Scope::Scope() : isOuter(!g_isScopeOpen)
+{
+    g_isScopeOpen = true;
+}
+
+JsonArena::Scope::~Scope()
+{
+    if (isOuter) {
+        g_isScopeOpen = false;
+    }
+}
+
+JsonArena::JsonArena()
+    : arenaAllocations(PerfStats::GetInstance().GetCounter(PerfMetric::JSON_ARENA_ALLOCATIONS)),
+      heapAllocations(PerfStats::GetInstance().GetCounter(PerfMetric::JSON_ARENA_HEAP_ALLOCATIONS))
+{
+}
+
+JsonArena& JsonArena::GetInstance()
+{
+    static JsonArena instance;
+    return instance;
+}
+
+void JsonArena::InstallHooks(void* (*heapMalloc)(size_t), void (*heapFree)(void*))
+{
+    g_heapMalloc = heapMalloc != nullptr ? heapMalloc : malloc;
+    g_heapFree = heapFree != nullptr ? heapFree : free;
+    GetInstance(); // not created inside the first allocation
+    cJSON_Hooks hooks = { Malloc, Free };
+    cJSON_InitHooks(&hooks);
+    g_isInstalled = true;
+}
+
+bool JsonArena::IsInstalled()
+{
+    return g_isInstalled;
+}
+
+size_t JsonArena::GetLiveCount() const
+{
+    return liveCount.load(std::memory_order_relaxed);
+}
+
+void* JsonArena::Allocate(size_t size)
+{
+    char* start = block.load(std::memory_order_relaxed);
+    if (start == nullptr) {
+        start = static_cast<char*>(g_heapMalloc(BLOCK_SIZE));
+        if (start == nullptr) {
+            return nullptr;
+        }
+        block.store(start, std::memory_order_release);
+    }
+    // Only this thread adds to liveCount, nothing carved can come alive meanwhile.
+    if (liveCount.load(std::memory_order_acquire) == 0) {
+        offset = 0;
+    }
+    size_t alignedSize = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (alignedSize > BLOCK_SIZE - offset) {
+        heapAllocations.Add();
+        return nullptr;
+    }
+    void* pointer = start + offset;
+    offset += alignedSize;
+    liveCount.fetch_add(1, std::memory_order_relaxed);
+    arenaAllocations.Add();
+    return pointer;
+}
+
+bool JsonArena::Release(void* pointer)
+{
+    uintptr_t start = reinterpret_cast<uintptr_t>(block.load(std::memory_order_acquire));
+    uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    if (start == 0 || address < start || address - start >= BLOCK_SIZE) {
+        return false;
+    }
+    liveCount.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void* JsonArena::Malloc(size_t size)
+{
+    if (g_isScopeOpen) {
+        void* pointer = GetInstance().Allocate(size);
+        if (pointer != nullptr) {
+            return pointer;
+        }
+    }
+    return g_heapMalloc(size);
+}
+
+void JsonArena::Free(void* pointer)
+{
+    if (pointer == nullptr || GetInstance().Release(pointer)) {
+        return;
+    }
+    g_heapFree(pointer);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JSONARENA_H
+#define JSONARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "PerfStats.h"
+
+// A bump allocator for the cJSON trees of command messages, which live only until their command ran.
+// While a Scope is open on a thread, cJSON allocations of that thread are carved from one block; a free
+// only counts down, and the block starts over once nothing carved from it is alive. What does not fit,
+// or is allocated outside a Scope, comes from the heap, so a tree kept longer never breaks: at worst it
+// holds the block and later messages go to the heap.
+class JsonArena {
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    // Opens the arena on this thread. One thread at a time, the command thread.
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool isOuter;
+    };
+
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+    static JsonArena& GetInstance();
+    // Routes cJSON allocations through the arena, heapMalloc and heapFree serve the others, malloc and free
+    // when null. Call at startup, before the first json is parsed.
+    static void InstallHooks(void* (*heapMalloc)(size_t) = nullptr, void (*heapFree)(void*) = nullptr);
+    static bool IsInstalled();
+    // Allocations carved from the block and not freed yet.
+    size_t GetLiveCount() const;
+
+private:
+    JsonArena();
+    ~JsonArena() = default;
+    void* Allocate(size_t size);
+    bool Release(void* pointer);
+    static void* Malloc(size_t size);
+    static void Free(void* pointer);
+
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+    std::atomic<char*> block { nullptr }; // allocated on first use, kept for the whole run
+    size_t offset = 0; // only touched by the thread in the scope
+    std::atomic<size_t> liveCount { 0 };
+    PerfCounter& arenaAllocations;
+    PerfCounter& heapAllocations; // made in a scope, but did not fit into the block
+};
+
+#endif // JSONARENA_H
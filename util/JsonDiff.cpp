@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JsonDiff.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "PreviewerEngineLog.h"
+#include "cJSON.h"
+
+namespace {
+    void DiffNode(const cJSON* from, const cJSON* to, const std::string& path, cJSON* patch);
+
+    void AddOperation(cJSON* patch, const char* op, const std::string& path, const cJSON* value)
+    {
+        cJSON* operation = cJSON_CreateObject();
+        if (operation == nullptr) {
+            return;
+        }
+        cJSON_AddStringToObject(operation, "op", op);
+        cJSON_AddStringToObject(operation, "path", path.c_str());
+        if (value != nullptr) {
+            cJSON_AddItemToObject(operation, "value", cJSON_Duplicate(value, true));
+        }
+        cJSON_AddItemToArray(patch, operation);
+    }
+
+    std::vector<const cJSON*> GetChildren(const cJSON* node)
+    {
+        std::vector<const cJSON*> children;
+        for (const cJSON* item = node->child; item != nullptr; item = item->next) {
+            children.push_back(item);
+        }
+        return children;
+    }
+
+    void DiffObject(const cJSON* from, const cJSON* to, const std::string& path, cJSON* patch)
+    {
+        for (const cJSON* item = from->child; item != nullptr; item = item->next) {
+            std::string itemPath = path + "/" + JsonDiff::EscapePointerToken(item->string);
+            const cJSON* target = cJSON_GetObjectItemCaseSensitive(to, item->string);
+            if (target == nullptr) {
+                AddOperation(patch, "remove", itemPath, nullptr);
+            } else {
+                DiffNode(item, target, itemPath, patch);
+            }
+        }
+        for (const cJSON* item = to->child; item != nullptr; item = item->next) {
+            if (cJSON_GetObjectItemCaseSensitive(from, item->string) == nullptr) {
+                AddOperation(patch, "add", path + "/" + JsonDiff::EscapePointerToken(item->string), item);
+            }
+        }
+    }
+
+    // Operations are ordered so that every index is valid at the time it is applied:
+    // changed items first, then removals from the back, then insertions from the front.
+    void DiffArray(const cJSON* from, const cJSON* to, const std::string& path, cJSON* patch)
+    {
+        std::vector<const cJSON*> source = GetChildren(from);
+        std::vector<const cJSON*> target = GetChildren(to);
+        size_t prefix = 0;
+        while (prefix < source.size() && prefix < target.size() &&
+            cJSON_Compare(source[prefix], target[prefix], true)) {
+            prefix++;
+        }
+        size_t suffix = 0;
+        while (suffix < source.size() - prefix && suffix < target.size() - prefix &&
+            cJSON_Compare(source[source.size() - 1 - suffix], target[target.size() - 1 - suffix], true)) {
+            suffix++;
+        }
+        size_t sourceCount = source.size() - prefix - suffix;
+        size_t targetCount = target.size() - prefix - suffix;
+        size_t common = std::min(sourceCount, targetCount);
+        for (size_t i = prefix; i < prefix + common; i++) {
+            DiffNode(source[i], target[i], path + "/" + std::to_string(i), patch);
+        }
+        for (size_t i = prefix + sourceCount; i > prefix + common; i--) {
+            AddOperation(patch, "remove", path + "/" + std::to_string(i - 1), nullptr);
+        }
+        for (size_t i = prefix + common; i < prefix + targetCount; i++) {
+            AddOperation(patch, "add", path + "/" + std::to_string(i), target[i]);
+        }
+    }
+
+    void DiffNode(const cJSON* from, const cJSON* to, const std::string& path, cJSON* patch)
+    {
+        if (cJSON_Compare(from, to, true)) {
+            return;
+        }
+        if (cJSON_IsObject(from) && cJSON_IsObject(to)) {
+            DiffObject(from, to, path, patch);
+        } else if (cJSON_IsArray(from) && cJSON_IsArray(to)) {
+            DiffArray(from, to, path, patch);
+        } else {
+            AddOperation(patch, "replace", path, to);
+        }
+    }
+}
+
+namespace JsonDiff {
+    bool Diff(const Json2::Value& from, const Json2::Value& to, Json2::Value& patch)
+    {
+        if (!from.IsValid() || !to.IsValid() || !patch.IsArray()) {
+            ELOG("JsonDiff: invalid document or patch.");
+            return false;
+        }
+        DiffNode(from.GetJsonPtr(), to.GetJsonPtr(), "", const_cast<cJSON*>(patch.GetJsonPtr()));
+        return true;
+    }
+
+    std::string EscapePointerToken(const std::string& token)
+    {
+        std::string escaped;
+        escaped.reserve(token.size());
+        for (char c : token) {
+            if (c == '~') {
+                escaped += "~0";
+            } else if (c == '/') {
+                escaped += "~1";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+};
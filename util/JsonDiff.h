@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JSONDIFF_H
+#define JSONDIFF_H
+
+#include <string>
+
+#include "JsonReader.h"
+
+// Structural diff of two JSON documents in RFC 6902 (JSON Patch) form. Only "add", "remove"
+// and "replace" are produced; array changes are reduced to the span between the common
+// prefix and suffix, so a node inserted into a long children list becomes a single "add".
+namespace JsonDiff {
+    // Appends the operations turning "from" into "to" to the "patch" array.
+    bool Diff(const Json2::Value& from, const Json2::Value& to, Json2::Value& patch);
+    // Escapes a member name as a JSON Pointer reference token ('~' -> "~0", '/' -> "~1").
+    std::string EscapePointerToken(const std::string& token);
+}; // namespace JsonDiff
+
+#endif // JSONDIFF_H
@@ -15,18 +15,129 @@
 
 #include "JsonReader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <limits>
 #include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
 #include "PreviewerEngineLog.h"
 #include "cJSON.h"
 
+namespace {
+    // Scanning is as fast as hashing for a few members, and a Value looked up once does not pay for an index.
+    constexpr size_t INDEX_MIN_MEMBERS = 16;
+    constexpr uint8_t INDEX_MIN_LOOKUPS = 2;
+    constexpr size_t PRINT_MIN_BUFFER = 256;
+
+    using ChangeCount = std::atomic<uint64_t>;
+
+    // Counts the changes made through Add, Replace and Clear to every object that has a member index, so an
+    // index sees the changes made through other Values of its object. Kept beside the json: while no index
+    // exists a change costs one atomic load, otherwise a lock and a hash lookup.
+    class ChangeCounts {
+    public:
+        static ChangeCounts& GetInstance()
+        {
+            // Never destroyed: Values are still changed while other singletons shut down.
+            static ChangeCounts* instance = new ChangeCounts();
+            return *instance;
+        }
+
+        std::shared_ptr<const ChangeCount> Get(const cJSON* object)
+        {
+            std::lock_guard<std::mutex> lock(countsMutex);
+            for (auto iter = counts.begin(); iter != counts.end();) { // drops the objects no index looks at
+                iter = iter->second.expired() ? counts.erase(iter) : std::next(iter);
+            }
+            std::shared_ptr<ChangeCount> count = std::make_shared<ChangeCount>(0);
+            counts.emplace(object, count);
+            size = counts.size();
+            return count;
+        }
+
+        void OnChanged(const cJSON* object)
+        {
+            if (size.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(countsMutex);
+            auto range = counts.equal_range(object);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                if (std::shared_ptr<ChangeCount> count = iter->second.lock()) {
+                    count->fetch_add(1, std::memory_order_release);
+                }
+            }
+        }
+
+    private:
+        std::mutex countsMutex; // guards counts
+        std::unordered_multimap<const cJSON*, std::weak_ptr<ChangeCount>> counts; // one per index
+        std::atomic<size_t> size { 0 };
+    };
+
+    // Matches keys the way cJSON_HasObjectItem does in the C locale, ignoring the case of ASCII letters.
+    inline unsigned char FoldCase(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : static_cast<unsigned char>(c);
+    }
+
+    struct FoldedHash {
+        size_t operator()(std::string_view key) const
+        {
+            size_t hash = 0;
+            for (char c : key) {
+                hash = hash * 31 + FoldCase(c); // 31: the usual string hash multiplier
+            }
+            return hash;
+        }
+    };
+
+    struct FoldedEqual {
+        bool operator()(std::string_view left, std::string_view right) const
+        {
+            return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin(),
+                [](char a, char b) { return FoldCase(a) == FoldCase(b); });
+        }
+    };
+}
+
 namespace Json2 {
+    struct Value::MemberIndex {
+        const cJSON* object = nullptr;
+        std::shared_ptr<const ChangeCount> changes; // of the object, null when it has too few members
+        uint64_t changeCount = 0; // when the index was built
+        std::unordered_map<std::string_view, cJSON*> members; // empty when the object has too few members
+        std::unordered_set<std::string_view, FoldedHash, FoldedEqual> foldedKeys; // for IsMember
+    };
+
     Value::Value(cJSON* object) : jsonPtr(object), rootNode(true) {}
 
     Value::Value(cJSON* object, bool isRoot) : jsonPtr(object), rootNode(isRoot) {}
 
+    Value::Value(Value&& other) noexcept
+        : jsonPtr(other.jsonPtr), rootNode(other.rootNode), scanCount(other.scanCount),
+          memberIndex(std::move(other.memberIndex))
+    {
+        other.jsonPtr = nullptr;
+    }
+
+    Value& Value::operator=(Value&& other) noexcept
+    {
+        // The json held before goes with other and is freed there if this owned it.
+        std::swap(jsonPtr, other.jsonPtr);
+        std::swap(rootNode, other.rootNode);
+        std::swap(scanCount, other.scanCount);
+        std::swap(memberIndex, other.memberIndex);
+        return *this;
+    }
+
     Value::~Value()
     {
         if (!jsonPtr) {
@@ -40,34 +151,22 @@ namespace Json2 {
 
     Value Value::operator[](const char* key)
     {
-        if (!cJSON_HasObjectItem(jsonPtr, key)) {
-            return Value();
-        }
-        return Value(cJSON_GetObjectItemCaseSensitive(jsonPtr, key), false);
+        return Value(FindMember(key), false);
     }
 
     const Value Value::operator[](const char* key) const
     {
-        if (!cJSON_HasObjectItem(jsonPtr, key)) {
-            return Value();
-        }
-        return Value(cJSON_GetObjectItemCaseSensitive(jsonPtr, key), false);
+        return Value(FindMember(key), false);
     }
 
     Value Value::operator[](const std::string& key)
     {
-        if (!cJSON_HasObjectItem(jsonPtr, key.c_str())) {
-            return Value();
-        }
-        return Value(cJSON_GetObjectItemCaseSensitive(jsonPtr, key.c_str()), false);
+        return Value(FindMember(key.c_str()), false);
     }
 
     const Value Value::operator[](const std::string& key) const
     {
-        if (!cJSON_HasObjectItem(jsonPtr, key.c_str())) {
-            return Value();
-        }
-        return Value(cJSON_GetObjectItemCaseSensitive(jsonPtr, key.c_str()), false);
+        return Value(FindMember(key.c_str()), false);
     }
 
     Value::Members Value::GetMemberNames() const
@@ -113,6 +212,44 @@ namespace Json2 {
         return ret;
     }
 
+    Value::PrintBuffer& Value::GetPrintBuffer()
+    {
+        static thread_local PrintBuffer printBuffer;
+        return printBuffer;
+    }
+
+    bool Value::PrintTo(std::string& buffer) const
+    {
+        buffer.clear();
+        if (!jsonPtr) {
+            return false;
+        }
+        // cJSON fails rather than grow a preallocated buffer, a json that does not fit is printed once by
+        // cJSON, and the print buffer grows to it for the next print.
+        PrintBuffer& printBuffer = GetPrintBuffer();
+        if (printBuffer.size == 0) {
+            printBuffer.data.reset(new char[PRINT_MIN_BUFFER]);
+            printBuffer.size = PRINT_MIN_BUFFER;
+        }
+        int size = static_cast<int>(std::min(printBuffer.size, static_cast<size_t>(INT_MAX)));
+        if (cJSON_PrintPreallocated(jsonPtr, printBuffer.data.get(), size, false)) {
+            buffer.assign(printBuffer.data.get());
+            return true;
+        }
+        char* jsonData = cJSON_PrintUnformatted(jsonPtr);
+        if (!jsonData) {
+            ELOG("Value::PrintTo print failed");
+            return false;
+        }
+        size_t length = strlen(jsonData);
+        buffer.assign(jsonData, length);
+        cJSON_free(jsonData);
+        // 2: cJSON needs spare bytes, and the same json tends to grow a bit
+        printBuffer.size = length + length / 2;
+        printBuffer.data.reset(new char[printBuffer.size]);
+        return true;
+    }
+
     const cJSON* Value::GetJsonPtr() const
     {
         return jsonPtr;
@@ -204,7 +341,12 @@ namespace Json2 {
 
     bool Value::IsMember(const char* key) const
     {
-        return cJSON_HasObjectItem(jsonPtr, key);
+        // A member differing only in case counts as well.
+        const MemberIndex* index = key != nullptr ? GetMemberIndex() : nullptr;
+        if (index == nullptr || index->members.empty()) {
+            return cJSON_HasObjectItem(jsonPtr, key);
+        }
+        return index->members.count(key) > 0 || index->foldedKeys.count(key) > 0;
     }
 
     int32_t Value::GetInt(const char* key, int32_t defaultVal) const
@@ -256,7 +398,7 @@ namespace Json2 {
 
     Value Value::GetValue(const char* key) const
     {
-        return Value(cJSON_GetObjectItemCaseSensitive(jsonPtr, key), false);
+        return Value(FindMember(key), false);
     }
 
     int32_t Value::AsInt() const
@@ -313,6 +455,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToObject(jsonPtr, key, child);
         return true;
     }
@@ -326,6 +469,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToObject(jsonPtr, key, child);
         return true;
     }
@@ -354,6 +498,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToObject(jsonPtr, key, child);
         return true;
     }
@@ -367,6 +512,7 @@ namespace Json2 {
         if (jsonObject == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToObject(jsonPtr, key, jsonObject);
         return true;
     }
@@ -380,6 +526,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToArray(jsonPtr, child);
         return true;
     }
@@ -393,6 +540,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToArray(jsonPtr, child);
         return true;
     }
@@ -421,6 +569,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToArray(jsonPtr, child);
         return true;
     }
@@ -435,6 +584,7 @@ namespace Json2 {
         if (jsonObject == nullptr) {
             return false;
         }
+        OnChanged();
         cJSON_AddItemToArray(jsonPtr, jsonObject);
         return true;
     }
@@ -448,6 +598,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         if (!cJSON_ReplaceItemInObjectCaseSensitive(jsonPtr, key, child)) {
             cJSON_Delete(child);
             return false;
@@ -479,6 +630,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         if (!cJSON_ReplaceItemInObjectCaseSensitive(jsonPtr, key, child)) {
             cJSON_Delete(child);
             return false;
@@ -495,6 +647,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         if (!cJSON_ReplaceItemInObjectCaseSensitive(jsonPtr, key, child)) {
             cJSON_Delete(child);
             return false;
@@ -512,6 +665,7 @@ namespace Json2 {
             return false;
         }
 
+        OnChanged();
         if (!cJSON_ReplaceItemInObjectCaseSensitive(jsonPtr, key, jsonObject)) {
             cJSON_Delete(jsonObject);
             return false;
@@ -528,6 +682,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         if (!cJSON_ReplaceItemInArray(jsonPtr, index, child)) {
             cJSON_Delete(child);
             return false;
@@ -559,6 +714,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         if (!cJSON_ReplaceItemInArray(jsonPtr, index, child)) {
             cJSON_Delete(child);
             return false;
@@ -575,6 +731,7 @@ namespace Json2 {
         if (child == nullptr) {
             return false;
         }
+        OnChanged();
         if (!cJSON_ReplaceItemInArray(jsonPtr, index, child)) {
             cJSON_Delete(child);
             return false;
@@ -592,6 +749,7 @@ namespace Json2 {
             return false;
         }
 
+        OnChanged();
         if (!cJSON_ReplaceItemInArray(jsonPtr, index, jsonObject)) {
             cJSON_Delete(jsonObject);
             return false;
@@ -611,10 +769,77 @@ namespace Json2 {
 
     void Value::Clear()
     {
+        OnChanged();
+        // An object only drops its members, so clearing a reused result allocates nothing.
+        if (cJSON_IsObject(jsonPtr)) {
+            cJSON_Delete(jsonPtr->child);
+            jsonPtr->child = nullptr;
+            return;
+        }
         cJSON_Delete(jsonPtr);
         jsonPtr = cJSON_CreateObject();
     }
 
+    const Value::MemberIndex* Value::GetMemberIndex() const
+    {
+        if (!cJSON_IsObject(jsonPtr)) {
+            return nullptr;
+        }
+        if (memberIndex != nullptr && (memberIndex->object != jsonPtr || (memberIndex->changes != nullptr &&
+            memberIndex->changes->load(std::memory_order_acquire) != memberIndex->changeCount))) {
+            memberIndex.reset();
+            scanCount = 0;
+        }
+        if (memberIndex == nullptr && scanCount < INDEX_MIN_LOOKUPS) {
+            scanCount++;
+        }
+        if (memberIndex == nullptr && scanCount >= INDEX_MIN_LOOKUPS) {
+            auto index = std::make_shared<MemberIndex>();
+            index->object = jsonPtr;
+            size_t count = 0;
+            for (cJSON* item = jsonPtr->child; item != nullptr; item = item->next) {
+                count++;
+            }
+            if (count >= INDEX_MIN_MEMBERS) {
+                // Taken before the members are read, a change from now on rebuilds the index.
+                index->changes = ChangeCounts::GetInstance().Get(jsonPtr);
+                index->changeCount = index->changes->load(std::memory_order_acquire);
+                index->members.reserve(count);
+                index->foldedKeys.reserve(count);
+                for (cJSON* item = jsonPtr->child; item != nullptr; item = item->next) {
+                    if (item->string != nullptr) {
+                        index->members.emplace(item->string, item); // keeps the first of a repeated key
+                        index->foldedKeys.emplace(item->string);
+                    }
+                }
+            }
+            memberIndex = std::move(index);
+        }
+        return memberIndex.get();
+    }
+
+    cJSON* Value::FindMember(const char* key) const
+    {
+        if (key == nullptr || !cJSON_IsObject(jsonPtr)) {
+            return nullptr;
+        }
+        const MemberIndex* index = GetMemberIndex();
+        if (index == nullptr || index->members.empty()) {
+            return cJSON_GetObjectItemCaseSensitive(jsonPtr, key);
+        }
+        auto iter = index->members.find(key);
+        return iter != index->members.end() ? iter->second : nullptr;
+    }
+
+    void Value::OnChanged()
+    {
+        if (cJSON_IsObject(jsonPtr)) {
+            ChangeCounts::GetInstance().OnChanged(jsonPtr);
+        }
+        memberIndex.reset();
+        scanCount = 0;
+    }
+
     std::string Value::GetKey()
     {
         if (jsonPtr && jsonPtr->string) {
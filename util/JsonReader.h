@@ -31,8 +31,15 @@ namespace Json2 {
         Value() = default;
         explicit Value(cJSON* object);
         Value(cJSON* object, bool isRoot);
+        Value(const Value& other) = default; // shares the json, only a child may be copied
+        Value& operator=(const Value& other) = default;
+        // Takes over the json, a root leaves its owner behind empty.
+        Value(Value&& other) noexcept;
+        Value& operator=(Value&& other) noexcept;
         ~Value();
         // 重载实现obj["key"]形式调用
+        // Member lookups, const ones included, may build the member index of this Value: a Value must not be
+        // looked up from several threads at once, give each thread its own copy.
         Value operator[](const char* key);
         const Value operator[](const char* key) const;
         Value operator[](const std::string& key);
@@ -43,6 +50,10 @@ namespace Json2 {
         // convert string functions
         std::string ToString() const;
         std::string ToStyledString() const;
+        // Writes the compact json into buffer, keeping its capacity: once the buffer has grown to the
+        // largest json written, printing allocates nothing and copies only the output. False and empty
+        // when the json is null.
+        bool PrintTo(std::string& buffer) const;
         const cJSON* GetJsonPtr() const;
         // check functions
         bool IsNull() const;
@@ -114,8 +125,26 @@ namespace Json2 {
         std::string GetKey();
 
     private:
+        struct MemberIndex;
+        // Where PrintTo lets cJSON print, one per thread. It stays at the largest json printed and grows
+        // without initialising its bytes, so a print writes only its own output.
+        struct PrintBuffer {
+            std::unique_ptr<char[]> data;
+            size_t size = 0;
+        };
+        static PrintBuffer& GetPrintBuffer();
+        // An object with many members that is looked up more than once through this Value gets a hash
+        // index, which is rebuilt once the object is changed through Add, Replace or Clear of any Value.
+        // Changes made with the cJSON functions on GetJsonPtr are not seen. Null when this is no object.
+        const MemberIndex* GetMemberIndex() const;
+        // Finds a member case-sensitively, the first one if the key repeats.
+        cJSON* FindMember(const char* key) const;
+        void OnChanged();
+
         cJSON* jsonPtr = nullptr;
         bool rootNode = true;
+        mutable uint8_t scanCount = 0; // lookups by scanning the members since the index was dropped
+        mutable std::shared_ptr<MemberIndex> memberIndex; // shared by copies, they look at the same object
     };
 }
 
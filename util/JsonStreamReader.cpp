@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "JsonStreamReader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "PreviewerEngineLog.h"
+
+namespace {
+    constexpr int END_OF_INPUT = -1;
+    constexpr size_t MAX_NUMBER_LENGTH = 64;
+    constexpr uint32_t HIGH_SURROGATE_BEGIN = 0xD800;
+    constexpr uint32_t LOW_SURROGATE_BEGIN = 0xDC00;
+    constexpr uint32_t SURROGATE_END = 0xE000;
+    constexpr char UTF8_BOM[] = "\xEF\xBB\xBF";
+    constexpr size_t UTF8_BOM_LENGTH = sizeof(UTF8_BOM) - 1;
+
+    bool IsDigit(int ch)
+    {
+        return ch >= '0' && ch <= '9';
+    }
+
+    void AppendUtf8(std::string& text, uint32_t code)
+    {
+        if (code < 0x80) { // 0x80: one byte
+            text += static_cast<char>(code);
+        } else if (code < 0x800) { // 0x800: two bytes
+            text += static_cast<char>(0xC0 | (code >> 6)); // 6: bits in a continuation byte
+            text += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) { // 0x10000: three bytes
+            text += static_cast<char>(0xE0 | (code >> 12)); // 12: bits in two continuation bytes
+            text += static_cast<char>(0x80 | ((code >> 6) & 0x3F)); // 6: bits in a continuation byte
+            text += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            text += static_cast<char>(0xF0 | (code >> 18)); // 18: bits in three continuation bytes
+            text += static_cast<char>(0x80 | ((code >> 12) & 0x3F)); // 12: bits in two continuation bytes
+            text += static_cast<char>(0x80 | ((code >> 6) & 0x3F)); // 6: bits in a continuation byte
+            text += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+}
+
+JsonStreamReader::JsonStreamReader(std::istream& input) : input(input), buffer(CHUNK_SIZE)
+{
+}
+
+bool JsonStreamReader::ParseFile(const std::string& path, JsonStreamHandler& handler)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        ELOG("JsonStreamReader: open %s failed.", path.c_str());
+        return false;
+    }
+    JsonStreamReader reader(file);
+    return reader.Parse(handler);
+}
+
+bool JsonStreamReader::ParseString(const std::string& json, JsonStreamHandler& handler)
+{
+    std::istringstream stream(json);
+    JsonStreamReader reader(stream);
+    return reader.Parse(handler);
+}
+
+size_t JsonStreamReader::GetOffset() const
+{
+    return consumed + position;
+}
+
+bool JsonStreamReader::Parse(JsonStreamHandler& handler)
+{
+    frames.clear();
+    path.clear();
+    skipDepth = 0;
+    isStopped = false;
+    isFailed = false;
+    if (!ReadValue(handler)) {
+        return isStopped;
+    }
+    while (!frames.empty()) {
+        Frame& frame = frames.back();
+        int ch = PeekToken();
+        if (ch == (frame.isArray ? ']' : '}')) {
+            Next();
+            if (!EndContainer(handler)) {
+                return isStopped;
+            }
+            continue;
+        }
+        if (frame.count > 0 && !Expect(',')) {
+            return false;
+        }
+        if (frame.isArray) {
+            path.back().index = frame.count;
+        } else if (PeekToken() != '"' || !ReadString(path.back().key, !frame.isSkipped) || !Expect(':')) {
+            return Fail("member key expected");
+        }
+        frame.count++;
+        if (!ReadValue(handler)) {
+            return isStopped;
+        }
+    }
+    if (PeekToken() != END_OF_INPUT) {
+        return Fail("unexpected data after the json");
+    }
+    return !isFailed;
+}
+
+bool JsonStreamReader::Fill()
+{
+    if (!input.good()) {
+        return false;
+    }
+    consumed += length;
+    input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    length = static_cast<size_t>(input.gcount());
+    position = 0;
+    // Skipped like cJSON_Parse does, editors on Windows save json with it.
+    if (consumed == 0 && length >= UTF8_BOM_LENGTH && std::equal(UTF8_BOM, UTF8_BOM + UTF8_BOM_LENGTH,
+        buffer.begin())) {
+        position = UTF8_BOM_LENGTH;
+    }
+    return length > 0;
+}
+
+int JsonStreamReader::Peek()
+{
+    if (position == length && !Fill()) {
+        return END_OF_INPUT;
+    }
+    return static_cast<unsigned char>(buffer[position]);
+}
+
+int JsonStreamReader::Next()
+{
+    int ch = Peek();
+    if (ch != END_OF_INPUT) {
+        position++;
+    }
+    return ch;
+}
+
+int JsonStreamReader::PeekToken()
+{
+    int ch = Peek();
+    while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+        position++;
+        ch = Peek();
+    }
+    return ch;
+}
+
+bool JsonStreamReader::Expect(char ch)
+{
+    if (PeekToken() != static_cast<unsigned char>(ch)) {
+        return Fail("unexpected character");
+    }
+    Next();
+    return true;
+}
+
+bool JsonStreamReader::ReadValue(JsonStreamHandler& handler)
+{
+    bool isSkipped = skipDepth > 0;
+    int ch = PeekToken();
+    if (ch == '{' || ch == '[') {
+        Next();
+        bool isArray = ch == '[';
+        if (frames.size() >= MAX_DEPTH) {
+            return Fail("json nested too deep");
+        }
+        JsonStreamAction action = isSkipped ? JsonStreamAction::SKIP : handler.OnContainerStart(path, isArray);
+        if (action == JsonStreamAction::STOP) {
+            return Report(action);
+        }
+        Frame frame;
+        frame.isArray = isArray;
+        frame.isSkipped = action == JsonStreamAction::SKIP;
+        frames.push_back(frame);
+        path.emplace_back();
+        skipDepth += frame.isSkipped ? 1 : 0;
+        return true;
+    }
+    if (ch == '"') {
+        value.type = JsonStreamValue::Type::STRING;
+        if (!ReadString(value.string, !isSkipped)) {
+            return false;
+        }
+    } else if (ch == 't' || ch == 'f') {
+        value.type = JsonStreamValue::Type::BOOL;
+        value.boolean = ch == 't';
+        if (!ReadLiteral(value.boolean ? "true" : "false")) {
+            return false;
+        }
+    } else if (ch == 'n') {
+        value.type = JsonStreamValue::Type::NULL_VALUE;
+        if (!ReadLiteral("null")) {
+            return false;
+        }
+    } else if (ch == '-' || IsDigit(ch)) {
+        value.type = JsonStreamValue::Type::NUMBER;
+        if (!ReadNumber(value.number)) {
+            return false;
+        }
+    } else {
+        return Fail("value expected");
+    }
+    return isSkipped || Report(handler.OnValue(path, value));
+}
+
+bool JsonStreamReader::EndContainer(JsonStreamHandler& handler)
+{
+    bool isArray = frames.back().isArray;
+    bool isSkipped = frames.back().isSkipped;
+    frames.pop_back();
+    path.pop_back();
+    if (isSkipped) {
+        skipDepth--;
+        return true;
+    }
+    return Report(handler.OnContainerEnd(path, isArray));
+}
+
+bool JsonStreamReader::ReadString(std::string& text, bool isStored)
+{
+    Next(); // the opening quote
+    text.clear();
+    size_t size = 0;
+    while (true) {
+        int ch = Next();
+        if (ch == '"') {
+            return true;
+        }
+        if (ch == END_OF_INPUT || ch < ' ') {
+            return Fail("unterminated string");
+        }
+        if (++size > MAX_STRING_LENGTH) {
+            return Fail("string too long");
+        }
+        if (ch == '\\') {
+            if (!ReadEscape(text, isStored)) {
+                return false;
+            }
+        } else if (isStored) {
+            text += static_cast<char>(ch);
+        }
+    }
+}
+
+bool JsonStreamReader::ReadEscape(std::string& text, bool isStored)
+{
+    int ch = Next();
+    char escaped = 0;
+    switch (ch) {
+        case '"':
+        case '\\':
+        case '/':
+            escaped = static_cast<char>(ch);
+            break;
+        case 'b':
+            escaped = '\b';
+            break;
+        case 'f':
+            escaped = '\f';
+            break;
+        case 'n':
+            escaped = '\n';
+            break;
+        case 'r':
+            escaped = '\r';
+            break;
+        case 't':
+            escaped = '\t';
+            break;
+        case 'u': {
+            uint32_t code = 0;
+            if (!ReadHex(code)) {
+                return false;
+            }
+            if (code >= HIGH_SURROGATE_BEGIN && code < LOW_SURROGATE_BEGIN) {
+                uint32_t low = 0;
+                if (Next() != '\\' || Next() != 'u' || !ReadHex(low) || low < LOW_SURROGATE_BEGIN ||
+                    low >= SURROGATE_END) {
+                    return Fail("invalid surrogate pair");
+                }
+                // 10: bits from each half, 0x10000: the first code point past the basic plane
+                code = 0x10000 + ((code - HIGH_SURROGATE_BEGIN) << 10) + (low - LOW_SURROGATE_BEGIN);
+            } else if (code >= LOW_SURROGATE_BEGIN && code < SURROGATE_END) {
+                return Fail("invalid surrogate pair");
+            }
+            if (isStored) {
+                AppendUtf8(text, code);
+            }
+            return true;
+        }
+        default:
+            return Fail("invalid escape");
+    }
+    if (isStored) {
+        text += escaped;
+    }
+    return true;
+}
+
+bool JsonStreamReader::ReadHex(uint32_t& code)
+{
+    code = 0;
+    for (int i = 0; i < 4; i++) { // 4: hex digits of an escaped code unit
+        int ch = Next();
+        uint32_t digit = 0;
+        if (IsDigit(ch)) {
+            digit = static_cast<uint32_t>(ch - '0');
+        } else if (ch >= 'a' && ch <= 'f') {
+            digit = static_cast<uint32_t>(ch - 'a' + 10); // 10: value of hex digit a
+        } else if (ch >= 'A' && ch <= 'F') {
+            digit = static_cast<uint32_t>(ch - 'A' + 10); // 10: value of hex digit A
+        } else {
+            return Fail("invalid unicode escape");
+        }
+        code = (code << 4) | digit; // 4: bits of a hex digit
+    }
+    return true;
+}
+
+bool JsonStreamReader::ReadLiteral(const char* literal)
+{
+    for (const char* ch = literal; *ch != '\0'; ch++) {
+        if (Next() != static_cast<unsigned char>(*ch)) {
+            return Fail("invalid literal");
+        }
+    }
+    return true;
+}
+
+bool JsonStreamReader::ReadNumber(double& number)
+{
+    char text[MAX_NUMBER_LENGTH + 1];
+    size_t size = 0;
+    auto take = [this, &text, &size]() {
+        if (size == MAX_NUMBER_LENGTH) {
+            return false;
+        }
+        text[size++] = static_cast<char>(Next());
+        return true;
+    };
+    auto takeDigits = [this, &take]() {
+        if (!IsDigit(Peek())) {
+            return false;
+        }
+        while (IsDigit(Peek())) {
+            if (!take()) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (Peek() == '-' && !take()) {
+        return Fail("invalid number");
+    }
+    if (Peek() == '0') {
+        take();
+    } else if (!takeDigits()) {
+        return Fail("invalid number");
+    }
+    if (Peek() == '.' && (!take() || !takeDigits())) {
+        return Fail("invalid number");
+    }
+    if (Peek() == 'e' || Peek() == 'E') {
+        if (!take() || ((Peek() == '+' || Peek() == '-') && !take()) || !takeDigits()) {
+            return Fail("invalid number");
+        }
+    }
+    text[size] = '\0';
+    number = strtod(text, nullptr);
+    return true;
+}
+
+bool JsonStreamReader::Fail(const char* message)
+{
+    if (!isFailed) {
+        ELOG("JsonStreamReader: %s at offset %zu.", message, GetOffset());
+    }
+    isFailed = true;
+    return false;
+}
+
+bool JsonStreamReader::Report(JsonStreamAction action)
+{
+    if (action == JsonStreamAction::STOP) {
+        isStopped = true;
+        return false;
+    }
+    return true;
+}
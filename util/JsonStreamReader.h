@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+// One step from the root to a value: the member key in an object, the item index in an array.
+struct JsonStreamPathItem {
+    std::string key;
+    int32_t index = -1;
+};
+using JsonStreamPath = std::vector<JsonStreamPathItem>;
+
+struct JsonStreamValue {
+    enum class Type { STRING, NUMBER, BOOL, NULL_VALUE };
+    Type type = Type::NULL_VALUE;
+    std::string string;
+    double number = 0.0;
+    bool boolean = false;
+};
+
+enum class JsonStreamAction {
+    CONTINUE,
+    SKIP, // an object or array starting: its members and its end are not reported
+    STOP // reading ends here, successfully
+};
+
+// The events of a JsonStreamReader, each with the path of the value it is about.
+class JsonStreamHandler {
+public:
+    virtual ~JsonStreamHandler() = default;
+    virtual JsonStreamAction OnContainerStart(const JsonStreamPath& path, bool isArray) = 0;
+    virtual JsonStreamAction OnContainerEnd(const JsonStreamPath& path, bool isArray) = 0;
+    virtual JsonStreamAction OnValue(const JsonStreamPath& path, const JsonStreamValue& value) = 0;
+};
+
+// Reads json in fixed size chunks and reports it as events, without building a tree. Memory is bounded by
+// the chunk, the longest string and the nesting depth, whatever the size of the input. Strings in skipped
+// containers are not even stored.
+class JsonStreamReader {
+public:
+    static constexpr size_t CHUNK_SIZE = 16 * 1024;
+    static constexpr size_t MAX_DEPTH = 128;
+    static constexpr size_t MAX_STRING_LENGTH = 1024 * 1024;
+
+    explicit JsonStreamReader(std::istream& input);
+    // False on malformed json or when a limit is exceeded, the handler may have seen events before.
+    bool Parse(JsonStreamHandler& handler);
+    static bool ParseFile(const std::string& path, JsonStreamHandler& handler);
+    static bool ParseString(const std::string& json, JsonStreamHandler& handler);
+    // The bytes read so far.
+    size_t GetOffset() const;
+
+private:
+    struct Frame {
+        bool isArray = false;
+        bool isSkipped = false; // skipped itself or inside a skipped container
+        int32_t count = 0;
+    };
+    bool Fill();
+    int Peek();
+    int Next();
+    int PeekToken(); // skips white space
+    bool Expect(char ch);
+    bool ReadValue(JsonStreamHandler& handler);
+    bool EndContainer(JsonStreamHandler& handler);
+    bool ReadString(std::string& text, bool isStored);
+    bool ReadEscape(std::string& text, bool isStored);
+    bool ReadHex(uint32_t& code);
+    bool ReadLiteral(const char* literal);
+    bool ReadNumber(double& number);
+    bool Fail(const char* message);
+    bool Report(JsonStreamAction action);
+
+    std::istream& input;
+    std::vector<char> buffer;
+    size_t position = 0;
+    size_t length = 0;
+    size_t consumed = 0; // bytes of the chunks before the current one
+    std::vector<Frame> frames;
+    JsonStreamPath path;
+    size_t skipDepth = 0; // skipped frames on the stack
+    JsonStreamValue value;
+    bool isStopped = false;
+    bool isFailed = false;
+};
+
+#endif // JSONSTREAMREADER_H
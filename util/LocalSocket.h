@@ -16,6 +16,7 @@
 #ifndef LOCALSOCKET_H
 #define LOCALSOCKET_H
 
+#include <atomic>
 #include <string>
 
 #ifdef _WIN32
@@ -24,6 +25,7 @@
 #endif // _WIN32
 
 #include "EndianUtil.h"
+#include "MessageFrame.h"
 
 class LocalSocket {
 public:
@@ -31,6 +33,12 @@ public:
 
     enum TransMode { TRANS_BYTE = 0, TRANS_MESSAGE };
 
+    // One piece of a gathered write, the data is referenced and not copied.
+    struct Segment {
+        const void* data;
+        size_t length;
+    };
+
     LocalSocket();
     virtual ~LocalSocket();
     LocalSocket& operator=(const LocalSocket&) = delete;
@@ -42,15 +50,32 @@ public:
     void DisconnectFromServer();
     int64_t ReadData(char* data, size_t length) const;
     size_t WriteData(const void* data, size_t length) const;
+    // Writes all segments in order as one contiguous stream, retrying on partial writes.
+    size_t WriteSegments(const Segment* segments, size_t count) const;
+    // Writes a message and its terminating '\0' without copying the payload,
+    // or a JSON frame carrying requestId once the framed protocol is enabled.
+    size_t WriteMessage(const std::string& message, uint32_t requestId = 0) const;
+    // Writes the frame header and the payload with one gathered write.
+    size_t WriteFrame(uint16_t type, uint32_t requestId, const void* payload, size_t length) const;
+    // Bytes written but not yet read by the peer, -1 if the platform can not tell.
+    int64_t GetPendingWriteBytes() const;
+
+    // Switched by the command thread between two commands, any thread may write meanwhile.
+    inline void SetMessageFramed(bool framed)
+    {
+        isMessageFramed.store(framed, std::memory_order_release);
+    }
+
+    inline bool IsMessageFramed() const
+    {
+        return isMessageFramed.load(std::memory_order_acquire);
+    }
 
     template <class T, class = typename std::enable_if<std::is_integral<T>::value>::type>
     const LocalSocket& operator<<(const T data) const
     {
         T dataToSend = EndianUtil::ToNetworkEndian<T>(data);
-        char* startPos = reinterpret_cast<char*>(&dataToSend);
-        char buffer[sizeof(T)];
-        std::copy(startPos, startPos + sizeof(dataToSend), buffer);
-        WriteData(buffer, sizeof(dataToSend));
+        WriteData(&dataToSend, sizeof(dataToSend));
         return *this;
     }
 
@@ -59,6 +84,8 @@ public:
     const LocalSocket& operator>>(std::string& data) const;
 
 private:
+    friend class Reactor;
+    std::atomic<bool> isMessageFramed;
 #ifdef _WIN32
     HANDLE pipeHandle;
     DWORD GetWinOpenMode(OpenMode mode) const;
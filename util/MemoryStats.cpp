@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryStats.h"
+
+#include <algorithm>
+#include <cstdlib>
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include "JsonArena.h"
+
+namespace {
+    const char* const TAG_NAMES[] = {
+        "screenBuffer",
+        "loadDocTempBuffer",
+        "loadDocCopyBuffer",
+        "firstImageBuffer",
+        "hspBuffer",
+        "json",
+    };
+    static_assert(sizeof(TAG_NAMES) / sizeof(TAG_NAMES[0]) == static_cast<size_t>(MemoryTag::COUNT),
+        "every memory tag needs a name");
+
+    // The size the allocator reserved for pointer, so a free needs no header in front of the block.
+    size_t GetAllocatedSize(void* pointer)
+    {
+#if defined(_WIN32)
+        return _msize(pointer);
+#elif defined(__APPLE__)
+        return malloc_size(pointer);
+#else
+        return malloc_usable_size(pointer);
+#endif
+    }
+}
+
+MemoryStats& MemoryStats::GetInstance()
+{
+    static MemoryStats instance;
+    return instance;
+}
+
+void MemoryStats::Allocate(MemoryTag tag, size_t bytes)
+{
+    Update(tag, static_cast<int64_t>(bytes));
+}
+
+void MemoryStats::Release(MemoryTag tag, size_t bytes)
+{
+    Update(tag, -static_cast<int64_t>(bytes));
+}
+
+void MemoryStats::SetBuffer(MemoryTag tag, size_t bytes)
+{
+    if (tag >= MemoryTag::COUNT) {
+        return;
+    }
+    int64_t before = buffers[static_cast<size_t>(tag)].exchange(static_cast<int64_t>(bytes),
+        std::memory_order_relaxed);
+    Update(tag, static_cast<int64_t>(bytes) - before);
+}
+
+void MemoryStats::Update(MemoryTag tag, int64_t delta)
+{
+    if (tag >= MemoryTag::COUNT || delta == 0) {
+        return;
+    }
+    size_t index = static_cast<size_t>(tag);
+    int64_t value = current[index].fetch_add(delta, std::memory_order_relaxed) + delta;
+    int64_t total = totalCurrent.fetch_add(delta, std::memory_order_relaxed) + delta;
+    if (delta > 0) {
+        UpdatePeak(peak[index], value);
+        UpdatePeak(totalPeak, total);
+    }
+}
+
+void MemoryStats::UpdatePeak(std::atomic<int64_t>& peak, int64_t value)
+{
+    int64_t highest = peak.load(std::memory_order_relaxed);
+    while (value > highest && !peak.compare_exchange_weak(highest, value, std::memory_order_relaxed)) {
+    }
+}
+
+int64_t MemoryStats::GetCurrent(MemoryTag tag) const
+{
+    if (tag >= MemoryTag::COUNT) {
+        return 0;
+    }
+    // Blocks allocated before the json hooks were installed are freed without having been counted.
+    return std::max<int64_t>(current[static_cast<size_t>(tag)].load(std::memory_order_relaxed), 0);
+}
+
+int64_t MemoryStats::GetPeak(MemoryTag tag) const
+{
+    if (tag >= MemoryTag::COUNT) {
+        return 0;
+    }
+    return peak[static_cast<size_t>(tag)].load(std::memory_order_relaxed);
+}
+
+int64_t MemoryStats::GetTotalCurrent() const
+{
+    return std::max<int64_t>(totalCurrent.load(std::memory_order_relaxed), 0);
+}
+
+int64_t MemoryStats::GetTotalPeak() const
+{
+    return totalPeak.load(std::memory_order_relaxed);
+}
+
+void MemoryStats::ResetPeak()
+{
+    for (size_t i = 0; i < TAG_COUNT; i++) {
+        peak[i].store(GetCurrent(static_cast<MemoryTag>(i)), std::memory_order_relaxed);
+    }
+    totalPeak.store(GetTotalCurrent(), std::memory_order_relaxed);
+}
+
+void MemoryStats::ToJson(Json2::Value& result) const
+{
+    Json2::Value tags = JsonReader::CreateObject();
+    for (size_t i = 0; i < TAG_COUNT; i++) {
+        MemoryTag tag = static_cast<MemoryTag>(i);
+        Json2::Value value = JsonReader::CreateObject();
+        value.Add("current", GetCurrent(tag));
+        value.Add("peak", GetPeak(tag));
+        tags.Add(GetTagName(tag), value);
+    }
+    result.Add("current", GetTotalCurrent());
+    result.Add("peak", GetTotalPeak());
+    result.Add("tags", tags);
+}
+
+const char* MemoryStats::GetTagName(MemoryTag tag)
+{
+    if (tag >= MemoryTag::COUNT) {
+        return "";
+    }
+    return TAG_NAMES[static_cast<size_t>(tag)];
+}
+
+void MemoryStats::InstallJsonHooks()
+{
+    // The arena takes its block from these hooks as well, so it is counted as one allocation.
+    JsonArena::InstallHooks(JsonMalloc, JsonFree);
+}
+
+void* MemoryStats::JsonMalloc(size_t size)
+{
+    void* pointer = malloc(size);
+    if (pointer != nullptr) {
+        GetInstance().Allocate(MemoryTag::JSON, GetAllocatedSize(pointer));
+    }
+    return pointer;
+}
+
+void MemoryStats::JsonFree(void* pointer)
+{
+    if (pointer == nullptr) {
+        return;
+    }
+    GetInstance().Release(MemoryTag::JSON, GetAllocatedSize(pointer));
+    free(pointer);
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "JsonReader.h"
+
+// The native memory held by each previewer subsystem.
+enum class MemoryTag {
+    SCREEN_BUFFER = 0, // the frame buffers of the virtual screen
+    LOAD_DOC_TEMP_BUFFER,
+    LOAD_DOC_COPY_BUFFER,
+    FIRST_IMAGE_BUFFER, // the last frame, resent to a newly connected client
+    HSP_BUFFER,
+    JSON, // cJSON trees, counted once the json hooks are installed
+    COUNT
+};
+
+// Bytes held per tag and in total, with their high-water marks. Updating is lock free.
+class MemoryStats {
+public:
+    static MemoryStats& GetInstance();
+    void Allocate(MemoryTag tag, size_t bytes);
+    void Release(MemoryTag tag, size_t bytes);
+    // For a tag owning a single buffer: replaces the size of the buffer held before.
+    void SetBuffer(MemoryTag tag, size_t bytes);
+    int64_t GetCurrent(MemoryTag tag) const;
+    int64_t GetPeak(MemoryTag tag) const;
+    int64_t GetTotalCurrent() const;
+    int64_t GetTotalPeak() const;
+    // The high-water marks start over from what is held now.
+    void ResetPeak();
+    void ToJson(Json2::Value& result) const;
+    static const char* GetTagName(MemoryTag tag);
+    // Counts cJSON allocations under JSON, behind the json arena. Call at startup, before the first json is parsed.
+    static void InstallJsonHooks();
+
+private:
+    MemoryStats() = default;
+    ~MemoryStats() = default;
+    MemoryStats& operator=(const MemoryStats&) = delete;
+    MemoryStats(const MemoryStats&) = delete;
+    void Update(MemoryTag tag, int64_t delta);
+    static void UpdatePeak(std::atomic<int64_t>& peak, int64_t value);
+    static void* JsonMalloc(size_t size);
+    static void JsonFree(void* pointer);
+
+    static constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+    std::atomic<int64_t> current[TAG_COUNT] {};
+    std::atomic<int64_t> peak[TAG_COUNT] {};
+    std::atomic<int64_t> buffers[TAG_COUNT] {}; // the size last given to SetBuffer
+    std::atomic<int64_t> totalCurrent { 0 };
+    std::atomic<int64_t> totalPeak { 0 };
+};
+
+#endif // MEMORYSTATS_H
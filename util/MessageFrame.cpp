@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageFrame.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "EndianUtil.h"
+#include "LocalSocket.h"
+#include "PreviewerEngineLog.h"
+
+namespace {
+    constexpr size_t MAGIC_OFFSET = 0;
+    constexpr size_t LENGTH_OFFSET = 4;
+    constexpr size_t TYPE_OFFSET = 8;
+    constexpr size_t RESERVED_OFFSET = 10;
+    constexpr size_t REQUEST_ID_OFFSET = 12;
+
+    template <class T>
+    void Put(uint8_t* buffer, size_t offset, T value)
+    {
+        T data = EndianUtil::ToNetworkEndian<T>(value);
+        std::memcpy(buffer + offset, &data, sizeof(T));
+    }
+
+    template <class T>
+    T Get(const uint8_t* buffer, size_t offset)
+    {
+        T data;
+        std::memcpy(&data, buffer + offset, sizeof(T));
+        return EndianUtil::ToNetworkEndian<T>(data); // the byte swap is its own inverse
+    }
+}
+
+void MessageFrame::EncodeHeader(const MessageFrameHeader& header, uint8_t (&buffer)[HEADER_SIZE])
+{
+    Put<uint32_t>(buffer, MAGIC_OFFSET, header.magic);
+    Put<uint32_t>(buffer, LENGTH_OFFSET, header.length);
+    Put<uint16_t>(buffer, TYPE_OFFSET, header.type);
+    Put<uint16_t>(buffer, RESERVED_OFFSET, header.reserved);
+    Put<uint32_t>(buffer, REQUEST_ID_OFFSET, header.requestId);
+}
+
+bool MessageFrame::DecodeHeader(const uint8_t (&buffer)[HEADER_SIZE], MessageFrameHeader& header)
+{
+    header.magic = Get<uint32_t>(buffer, MAGIC_OFFSET);
+    header.length = Get<uint32_t>(buffer, LENGTH_OFFSET);
+    header.type = Get<uint16_t>(buffer, TYPE_OFFSET);
+    header.reserved = Get<uint16_t>(buffer, RESERVED_OFFSET);
+    header.requestId = Get<uint32_t>(buffer, REQUEST_ID_OFFSET);
+    return header.magic == MAGIC && header.length <= MAX_PAYLOAD_LENGTH;
+}
+
+MessageFrameReader::MessageFrameReader()
+    : headerBuffer {}, headerReceived(0), header {}, payloadReceived(0), isSynchronized(true)
+{
+    payload.reserve(INITIAL_PAYLOAD_CAPACITY);
+}
+
+MessageFrameReader::Status MessageFrameReader::Read(const LocalSocket& socket)
+{
+    if (headerReceived < MessageFrame::HEADER_SIZE && !ReadHeader(socket)) {
+        return Status::PENDING;
+    }
+    while (payloadReceived < header.length) {
+        if (payloadReceived == payload.size()) {
+            // 2: doubles with each fill, up to the frame length
+            size_t size = payloadReceived < INITIAL_PAYLOAD_CAPACITY ? INITIAL_PAYLOAD_CAPACITY : payloadReceived * 2;
+            payload.resize(std::min(size, static_cast<size_t>(header.length)));
+        }
+        int64_t readSize = socket.ReadData(&payload[payloadReceived], payload.size() - payloadReceived);
+        if (readSize <= 0) {
+            return Status::PENDING;
+        }
+        payloadReceived += static_cast<size_t>(readSize);
+    }
+    return Status::READY;
+}
+
+void MessageFrameReader::Reset()
+{
+    headerReceived = 0;
+    header = {};
+    payload.clear();
+    payloadReceived = 0;
+}
+
+bool MessageFrameReader::ReadHeader(const LocalSocket& socket)
+{
+    while (headerReceived < MessageFrame::HEADER_SIZE) {
+        char* target = reinterpret_cast<char*>(headerBuffer) + headerReceived;
+        int64_t readSize = socket.ReadData(target, MessageFrame::HEADER_SIZE - headerReceived);
+        if (readSize <= 0) {
+            return false;
+        }
+        headerReceived += static_cast<size_t>(readSize);
+        if (headerReceived < MessageFrame::HEADER_SIZE) {
+            continue;
+        }
+        if (!MessageFrame::DecodeHeader(headerBuffer, header)) {
+            // Skip one byte and look for the next magic, the stream is out of sync.
+            if (isSynchronized) {
+                ELOG("MessageFrameReader::ReadHeader invalid frame header, length: %u", header.length);
+                isSynchronized = false;
+            }
+            std::memmove(headerBuffer, headerBuffer + 1, MessageFrame::HEADER_SIZE - 1);
+            headerReceived--;
+        }
+    }
+    isSynchronized = true;
+    payload.clear();
+    payloadReceived = 0;
+    return true;
+}
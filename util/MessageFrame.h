@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MESSAGEFRAME_H
+#define MESSAGEFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class LocalSocket;
+
+// Header in front of every command pipe message once the framed protocol is negotiated.
+// All fields are sent in network byte order.
+struct MessageFrameHeader {
+    uint32_t magic;
+    uint32_t length; // payload bytes following the header
+    uint16_t type;
+    uint16_t reserved;
+    uint32_t requestId; // echoed in the reply, 0 for unsolicited messages
+};
+
+namespace MessageFrame {
+    constexpr uint32_t TEXT_PROTOCOL_VERSION = 1; // '\0' terminated JSON, the default for older IDEs
+    constexpr uint32_t FRAMED_PROTOCOL_VERSION = 2;
+    constexpr uint32_t MAGIC = 0x50525657; // "PRVW"
+    constexpr size_t HEADER_SIZE = 16;
+    constexpr uint32_t MAX_PAYLOAD_LENGTH = 64 * 1024 * 1024;
+
+    // TYPE_JSON_DEFLATE is a JSON message compressed with Compression::Deflate.
+    enum Type : uint16_t { TYPE_JSON = 1, TYPE_BINARY = 2, TYPE_INPUT_EVENT = 3, TYPE_JSON_DEFLATE = 4 };
+
+    void EncodeHeader(const MessageFrameHeader& header, uint8_t (&buffer)[HEADER_SIZE]);
+    bool DecodeHeader(const uint8_t (&buffer)[HEADER_SIZE], MessageFrameHeader& header);
+} // namespace MessageFrame
+
+// Assembles frames from a non-blocking socket. The payload buffer grows with the bytes that
+// arrive, not with the length a header announces, and is reused between frames.
+class MessageFrameReader {
+public:
+    enum class Status { PENDING = 0, READY };
+
+    MessageFrameReader();
+    ~MessageFrameReader() {}
+    MessageFrameReader& operator=(const MessageFrameReader&) = delete;
+    MessageFrameReader(const MessageFrameReader&) = delete;
+
+    Status Read(const LocalSocket& socket);
+    // Drops the assembled frame, the payload capacity is kept for the next one.
+    void Reset();
+
+    inline const MessageFrameHeader& GetHeader() const
+    {
+        return header;
+    }
+
+    inline const std::string& GetPayload() const
+    {
+        return payload;
+    }
+
+private:
+    uint8_t headerBuffer[MessageFrame::HEADER_SIZE];
+    size_t headerReceived;
+    MessageFrameHeader header;
+    std::string payload;
+    size_t payloadReceived;
+    bool isSynchronized;
+    const static size_t INITIAL_PAYLOAD_CAPACITY = 4096;
+    bool ReadHeader(const LocalSocket& socket);
+};
+
+#endif // MESSAGEFRAME_H
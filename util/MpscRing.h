@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MPSCRING_H
+#define MPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for many producer threads and one consumer thread. Every slot carries
+// a sequence number telling whose turn it is, so producers only contend on one atomic counter
+// and never wait for each other. A full ring makes TryWrite fail instead of blocking.
+template <class T, size_t CAPACITY>
+class MpscRing {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+public:
+    MpscRing() : writePos(0), readPos(0)
+    {
+        for (size_t i = 0; i < CAPACITY; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~MpscRing() {}
+    MpscRing& operator=(const MpscRing&) = delete;
+    MpscRing(const MpscRing&) = delete;
+
+    // Any thread. writer(T&) fills the slot in place.
+    template <class Writer>
+    bool TryWrite(Writer&& writer)
+    {
+        size_t pos = writePos.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &slots[pos & (CAPACITY - 1)];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // the consumer has not read this slot yet
+            } else {
+                pos = writePos.load(std::memory_order_relaxed);
+            }
+        }
+        writer(slot->value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. reader(const T&) sees the oldest record before its slot is reused.
+    template <class Reader>
+    bool TryRead(Reader&& reader)
+    {
+        Slot& slot = slots[readPos & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != readPos + 1) {
+            return false;
+        }
+        reader(static_cast<const T&>(slot.value));
+        slot.sequence.store(readPos + CAPACITY, std::memory_order_release);
+        readPos++;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> writePos;
+    alignas(CACHE_LINE_SIZE) size_t readPos;
+    alignas(CACHE_LINE_SIZE) Slot slots[CAPACITY];
+};
+
+#endif // MPSCRING_H
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerfStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    constexpr double PERCENT = 100.0;
+    constexpr double MILLISECONDS_PER_SECOND = 1000.0;
+    constexpr double PERCENTILE_50 = 50.0;
+    constexpr double PERCENTILE_90 = 90.0;
+    constexpr double PERCENTILE_99 = 99.0;
+    const std::string COMMAND_LATENCY_PREFIX = "command.";
+    const std::string COMMAND_LATENCY_SUFFIX = ".latencyUs";
+
+    // Index of the highest set bit, value must not be 0.
+    uint32_t GetMagnitude(uint64_t value)
+    {
+        uint32_t magnitude = 0;
+        for (uint32_t shift = 32; shift > 0; shift /= 2) { // 32: half the bits of uint64_t
+            if ((value >> shift) != 0) {
+                value >>= shift;
+                magnitude += shift;
+            }
+        }
+        return magnitude;
+    }
+}
+
+void PerfHistogram::Record(uint64_t value)
+{
+    buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+PerfHistogram::Data PerfHistogram::GetData() const
+{
+    Data data;
+    data.buckets.resize(BUCKET_COUNT);
+    // The count is summed from the buckets so that it agrees with the percentiles while values are recorded.
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        data.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        data.count += data.buckets[i];
+    }
+    data.sum = sum.load(std::memory_order_relaxed);
+    data.max = max.load(std::memory_order_relaxed);
+    return data;
+}
+
+size_t PerfHistogram::GetBucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    uint32_t magnitude = GetMagnitude(value);
+    if (magnitude >= MAX_MAGNITUDE) {
+        return BUCKET_COUNT - 1;
+    }
+    uint32_t shift = magnitude - SUB_BUCKET_BITS;
+    size_t subBucket = static_cast<size_t>((value >> shift) & (SUB_BUCKET_COUNT - 1));
+    return (shift + 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t PerfHistogram::GetBucketMaxValue(size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    if (index >= BUCKET_COUNT - 1) {
+        return UINT64_MAX;
+    }
+    uint32_t shift = static_cast<uint32_t>(index / SUB_BUCKET_COUNT) - 1;
+    uint64_t lowest = static_cast<uint64_t>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+    return lowest + (static_cast<uint64_t>(1) << shift) - 1;
+}
+
+uint64_t PerfHistogram::Data::GetPercentile(double percent) const
+{
+    if (count == 0 || buckets.empty()) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(std::ceil(percent / PERCENT * static_cast<double>(count)));
+    target = std::max<uint64_t>(target, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            return std::min(GetBucketMaxValue(i), max);
+        }
+    }
+    return max;
+}
+
+PerfHistogram::Data PerfHistogram::Data::Subtract(const Data& previous) const
+{
+    Data data;
+    data.buckets.resize(buckets.size());
+    for (size_t i = 0; i < buckets.size(); i++) {
+        uint64_t before = i < previous.buckets.size() ? previous.buckets[i] : 0;
+        data.buckets[i] = buckets[i] - std::min(buckets[i], before);
+        data.count += data.buckets[i];
+        if (data.buckets[i] != 0) {
+            data.max = std::min(GetBucketMaxValue(i), max);
+        }
+    }
+    data.sum = sum - std::min(sum, previous.sum);
+    return data;
+}
+
+PerfStats::PerfStats() : startTime(GetSteadyTime()) {}
+
+PerfStats& PerfStats::GetInstance()
+{
+    static PerfStats instance;
+    return instance;
+}
+
+PerfCounter& PerfStats::GetCounter(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    std::unique_ptr<PerfCounter>& counter = counters[name];
+    if (counter == nullptr) {
+        counter = std::make_unique<PerfCounter>();
+    }
+    return *counter;
+}
+
+PerfGauge& PerfStats::GetGauge(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    std::unique_ptr<PerfGauge>& gauge = gauges[name];
+    if (gauge == nullptr) {
+        gauge = std::make_unique<PerfGauge>();
+    }
+    return *gauge;
+}
+
+PerfHistogram& PerfStats::GetHistogram(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    std::unique_ptr<PerfHistogram>& histogram = histograms[name];
+    if (histogram == nullptr) {
+        histogram = std::make_unique<PerfHistogram>();
+    }
+    return *histogram;
+}
+
+PerfHistogram& PerfStats::GetCommandLatency(const std::string& command)
+{
+    return GetHistogram(COMMAND_LATENCY_PREFIX + command + COMMAND_LATENCY_SUFFIX);
+}
+
+PerfStats::Snapshot PerfStats::TakeSnapshot()
+{
+    Snapshot snapshot;
+    snapshot.time = GetSteadyTime();
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    for (const auto& counter : counters) {
+        snapshot.counters[counter.first] = counter.second->Get();
+    }
+    for (const auto& gauge : gauges) {
+        snapshot.gauges[gauge.first] = gauge.second->Get();
+    }
+    for (const auto& histogram : histograms) {
+        snapshot.histograms[histogram.first] = histogram.second->GetData();
+    }
+    return snapshot;
+}
+
+void PerfStats::ToJson(const Snapshot& current, const Snapshot* previous, Json2::Value& result) const
+{
+    int64_t interval = current.time - (previous == nullptr ? startTime : previous->time);
+    Json2::Value counterValues = JsonReader::CreateObject();
+    for (const auto& counter : current.counters) {
+        uint64_t value = counter.second;
+        if (previous != nullptr) {
+            auto before = previous->counters.find(counter.first);
+            value -= before == previous->counters.end() ? 0 : std::min(value, before->second);
+        }
+        counterValues.Add(counter.first.c_str(), static_cast<int64_t>(value));
+        if (counter.first == PerfMetric::FRAME_SENT) {
+            double fps = interval > 0 ? value * MILLISECONDS_PER_SECOND / interval : 0;
+            result.Add("fps", fps);
+        }
+    }
+    Json2::Value gaugeValues = JsonReader::CreateObject();
+    for (const auto& gauge : current.gauges) {
+        gaugeValues.Add(gauge.first.c_str(), gauge.second);
+    }
+    Json2::Value histogramValues = JsonReader::CreateObject();
+    for (const auto& histogram : current.histograms) {
+        PerfHistogram::Data data = histogram.second;
+        if (previous != nullptr) {
+            auto before = previous->histograms.find(histogram.first);
+            if (before != previous->histograms.end()) {
+                data = histogram.second.Subtract(before->second);
+            }
+        }
+        Json2::Value value = JsonReader::CreateObject();
+        value.Add("count", static_cast<int64_t>(data.count));
+        value.Add("mean", data.count > 0 ? static_cast<double>(data.sum) / data.count : 0.0);
+        value.Add("p50", static_cast<int64_t>(data.GetPercentile(PERCENTILE_50)));
+        value.Add("p90", static_cast<int64_t>(data.GetPercentile(PERCENTILE_90)));
+        value.Add("p99", static_cast<int64_t>(data.GetPercentile(PERCENTILE_99)));
+        value.Add("max", static_cast<int64_t>(data.max));
+        histogramValues.Add(histogram.first.c_str(), value);
+    }
+    result.Add("intervalMs", interval);
+    result.Add("counters", counterValues);
+    result.Add("gauges", gaugeValues);
+    result.Add("histograms", histogramValues);
+}
+
+int64_t PerfStats::GetSteadyTime()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
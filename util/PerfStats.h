@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PERFSTATS_H
+#define PERFSTATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "JsonReader.h"
+
+// Names of the metrics recorded by the previewer.
+namespace PerfMetric {
+    constexpr const char* FRAME_VALID = "frame.valid";
+    constexpr const char* FRAME_INVALID = "frame.invalid";
+    constexpr const char* FRAME_SENT = "frame.sent";
+    constexpr const char* FRAME_DROPPED = "frame.dropped";
+    constexpr const char* FRAME_LATENCY = "frame.latencyUs"; // from the frame reaching the previewer until sent
+    constexpr const char* FRAME_BYTES = "frame.bytes"; // histogram of the bytes of each sent frame
+    constexpr const char* FRAME_ENCODE_TIME = "frame.encodeUs";
+    constexpr const char* INPUT_KEY = "input.key";
+    constexpr const char* INPUT_METHOD = "input.method";
+    constexpr const char* SOCKET_QUEUE_BYTES = "socket.queueBytes";
+    constexpr const char* COMMAND_QUEUE_INPUT = "commandQueue.input"; // commands waiting in each lane
+    constexpr const char* COMMAND_QUEUE_CONTROL = "commandQueue.control";
+    constexpr const char* COMMAND_QUEUE_BULK = "commandQueue.bulk";
+    constexpr const char* COMMAND_CANCELLED = "commandQueue.cancelled"; // superseded before they ran
+    constexpr const char* JSON_ARENA_ALLOCATIONS = "jsonArena.allocations"; // cJSON allocations of command messages
+    constexpr const char* JSON_ARENA_HEAP_ALLOCATIONS = "jsonArena.heapAllocations"; // did not fit into the arena
+    constexpr const char* JS_HEAP_TOTAL = "jsHeap.totalBytes";
+    constexpr const char* JS_HEAP_ALLOC = "jsHeap.allocBytes";
+    constexpr const char* JS_HEAP_PEAK = "jsHeap.peakAllocBytes";
+}; // namespace PerfMetric
+
+class PerfCounter {
+public:
+    inline void Add(uint64_t value = 1)
+    {
+        count.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    inline uint64_t Get() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> count { 0 };
+};
+
+class PerfGauge {
+public:
+    inline void Set(int64_t newValue)
+    {
+        value.store(newValue, std::memory_order_relaxed);
+    }
+
+    inline int64_t Get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> value { 0 };
+};
+
+// Log-linear buckets as in HdrHistogram: every power of two is split into SUB_BUCKET_COUNT
+// buckets, so a value is reported within 1/16 of what was recorded. Recording is lock free.
+class PerfHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_MAGNITUDE = 40; // values from 2^40 on share the last bucket
+    static constexpr size_t BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    struct Data {
+        std::vector<uint64_t> buckets;
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+        // Highest value of the bucket holding the given percentile, 0 if nothing was recorded.
+        uint64_t GetPercentile(double percent) const;
+        // Values recorded after previous was taken; max becomes that of the highest bucket.
+        Data Subtract(const Data& previous) const;
+    };
+
+    void Record(uint64_t value);
+    Data GetData() const;
+    static size_t GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketMaxValue(size_t index);
+
+private:
+    std::atomic<uint64_t> buckets[BUCKET_COUNT] {};
+    std::atomic<uint64_t> sum { 0 };
+    std::atomic<uint64_t> max { 0 };
+};
+
+// Registry of named metrics. A metric is never removed, so call sites may keep the reference.
+class PerfStats {
+public:
+    struct Snapshot {
+        int64_t time = 0; // ms, steady clock
+        std::map<std::string, uint64_t> counters;
+        std::map<std::string, int64_t> gauges;
+        std::map<std::string, PerfHistogram::Data> histograms;
+    };
+
+    static PerfStats& GetInstance();
+    PerfCounter& GetCounter(const std::string& name);
+    PerfGauge& GetGauge(const std::string& name);
+    PerfHistogram& GetHistogram(const std::string& name);
+    // Latency histogram of one command, in us.
+    PerfHistogram& GetCommandLatency(const std::string& command);
+    Snapshot TakeSnapshot();
+    // Adds the totals to result, or only what changed since previous when it is given.
+    // Gauges always hold their current value.
+    void ToJson(const Snapshot& current, const Snapshot* previous, Json2::Value& result) const;
+
+private:
+    PerfStats();
+    ~PerfStats() = default;
+    PerfStats& operator=(const PerfStats&) = delete;
+    PerfStats(const PerfStats&) = delete;
+    static int64_t GetSteadyTime();
+
+    int64_t startTime;
+    std::mutex metricsMutex; // guards the maps, not the metrics
+    std::map<std::string, std::unique_ptr<PerfCounter>> counters;
+    std::map<std::string, std::unique_ptr<PerfGauge>> gauges;
+    std::map<std::string, std::unique_ptr<PerfHistogram>> histograms;
+};
+
+#endif // PERFSTATS_H
@@ -15,7 +15,11 @@
 
 #include "PreviewerEngineLog.h"
 
+#include <algorithm>
+#include <cstdarg>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #ifdef _WIN32
 #include <windows.h>
@@ -23,38 +27,126 @@
 #include "unistd.h"
 #endif
 
-#include "LocalDate.h"
-#include "TimeTool.h"
+#include "AsyncLogger.h"
 #include "securec.h"
 
-void PrintLog(const char* level, const char* file, const char* func, int line, const char* fmt, ...)
-{
+namespace {
+    const size_t MAX_MESSAGE_LENGTH = 1024;
+    const size_t MAX_LINE_LENGTH = 1536;
+    const int64_t MICROSECOND_PERSECOND = 1000000;
+    const char* const LEVEL_NAMES[] = { "debug", "info", "warn", "error", "fatal" };
+}
+
+namespace PreviewerLog {
 #ifdef NDEBUG
-    std::string levelStr(level);
-    if (levelStr == "DEBUG") {
-        return;
-    }
+    std::atomic<int32_t> g_logLevel(LEVEL_INFO);
+#else
+    std::atomic<int32_t> g_logLevel(LEVEL_DEBUG);
 #endif
-    static char output[1024] = { 0 };
-    va_list argsList;
+    std::atomic<uint32_t> g_logRateLimit(DEFAULT_RATE_LIMIT);
+
+    void SetLevel(int32_t level)
+    {
+        g_logLevel.store(std::min(std::max(level, static_cast<int32_t>(LEVEL_DEBUG)),
+            static_cast<int32_t>(LEVEL_FATAL)), std::memory_order_relaxed);
+    }
+
+    int32_t GetLevel()
+    {
+        return g_logLevel.load(std::memory_order_relaxed);
+    }
+
+    bool ParseLevel(const std::string& name, int32_t& level)
+    {
+        for (int32_t i = LEVEL_DEBUG; i <= LEVEL_FATAL; i++) {
+            if (name == LEVEL_NAMES[i]) {
+                level = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* GetLevelName(int32_t level)
+    {
+        if (level < LEVEL_DEBUG || level > LEVEL_FATAL) {
+            return "";
+        }
+        return LEVEL_NAMES[level];
+    }
+
+    void SetRateLimit(uint32_t linesPerSecond)
+    {
+        g_logRateLimit.store(std::min(linesPerSecond, MAX_RATE_LIMIT), std::memory_order_relaxed);
+    }
+
+    uint32_t GetRateLimit()
+    {
+        return g_logRateLimit.load(std::memory_order_relaxed);
+    }
+
+    void PrintSuppressed(const char* level, const char* file, const char* func, int line, uint64_t suppressed)
+    {
+        if (suppressed > 0) {
+            PrintLog(level, file, func, line, "%llu similar lines suppressed",
+                static_cast<unsigned long long>(suppressed));
+        }
+    }
+
+    bool RateLimiter::Acquire(uint64_t& suppressed)
+    {
+        uint32_t rate = g_logRateLimit.load(std::memory_order_relaxed);
+        if (rate != 0) {
+            int64_t interval = MICROSECOND_PERSECOND / rate;
+            int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            int64_t current = fullTime.load(std::memory_order_relaxed);
+            int64_t next = 0;
+            do {
+                next = std::max(current, now) + interval;
+                if (next - now > MICROSECOND_PERSECOND) {
+                    suppressedCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            } while (!fullTime.compare_exchange_weak(current, next, std::memory_order_relaxed));
+        }
+        suppressed = 0;
+        if (suppressedCount.load(std::memory_order_relaxed) != 0) {
+            suppressed = suppressedCount.exchange(0, std::memory_order_relaxed);
+        }
+        return true;
+    }
+}; // namespace PreviewerLog
+
+void PrintLog(const char* level, const char* file, const char* func, int line, const char* fmt, ...)
+{
     if (fmt == nullptr || *fmt == '\0') {
         std::cerr << "PrintLog error: Format string is null or empty" << std::endl;
         return;
     }
+    const char* fileName = strrchr(file, '/');
+    fileName = (fileName == nullptr) ? file : fileName + 1;
+    // The header and the message are formatted straight into the line handed to the logger.
+    char text[MAX_LINE_LENGTH];
+    int headerLength = snprintf_s(text, sizeof(text), sizeof(text) - MAX_MESSAGE_LENGTH - 1, "[%s][%s][%s][%d]%s:",
+        level, fileName, func, line, AsyncLogger::GetTimeText());
+    if (headerLength < 0 || static_cast<size_t>(headerLength) >= sizeof(text) - MAX_MESSAGE_LENGTH) {
+        std::cout << "PrintLog function error";
+        return;
+    }
+    va_list argsList;
     va_start(argsList, fmt);
-    std::string fileStr(file);
-    int idx = fileStr.find_last_of("/");
-    fileStr = fileStr.substr(idx + 1);
-    int ret = vsnprintf_s(output, sizeof(output), sizeof(output), fmt, argsList);
-    if (ret == -1) {
+    int ret = vsnprintf_s(text + headerLength, MAX_MESSAGE_LENGTH, MAX_MESSAGE_LENGTH, fmt, argsList);
+    va_end(argsList);
+    if (ret < 0) {
         std::cout << "PrintLog function error";
-        va_end(argsList);
         return;
     }
-    if (stdout != nullptr) {
-        fprintf(stdout, "[%s][%s][%s][%d]%s:%s\n", level, fileStr.c_str(), func, line,
-                TimeTool::GetFormatTime().c_str(), output);
-        fflush(stdout);
+    // vsnprintf_s reports the untruncated length on some platforms
+    size_t length = static_cast<size_t>(headerLength) + std::min(static_cast<size_t>(ret), MAX_MESSAGE_LENGTH - 1);
+    text[length++] = '\n';
+    AsyncLogger::GetInstance().Write(text, length);
+    if (strcmp(level, "FATAL") == 0) {
+        AsyncLogger::GetInstance().Flush();
     }
-    va_end(argsList);
-}
\ No newline at end of file
+}
@@ -16,13 +16,74 @@
 #ifndef DEBUGLOG_H
 #define DEBUGLOG_H
 
-#define DLOG(...) PrintLog("DEBUG", __FILE__, __FUNCTION__, __LINE__, ##__VA_ARGS__)
-#define ILOG(...) PrintLog("INFO", __FILE__, __FUNCTION__, __LINE__, ##__VA_ARGS__)
-#define WLOG(...) PrintLog("WARN", __FILE__, __FUNCTION__, __LINE__, ##__VA_ARGS__)
-#define ELOG(...) PrintLog("ERROR", __FILE__, __FUNCTION__, __LINE__, ##__VA_ARGS__)
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Lines below the runtime level cost one relaxed load. Lines that pass go through a token
+// bucket of their own call site, and the first line let through after a refusal is preceded
+// by a count of the lines that were suppressed.
+#define PREVIEWER_LOG(level, levelName, ...) \
+    do { \
+        if (PreviewerLog::IsLevelEnabled(level)) { \
+            static PreviewerLog::RateLimiter logRateLimiter; \
+            uint64_t logSuppressed = 0; \
+            if (logRateLimiter.Acquire(logSuppressed)) { \
+                PreviewerLog::PrintSuppressed(levelName, __FILE__, __FUNCTION__, __LINE__, logSuppressed); \
+                PrintLog(levelName, __FILE__, __FUNCTION__, __LINE__, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define DLOG(...) PREVIEWER_LOG(PreviewerLog::LEVEL_DEBUG, "DEBUG", ##__VA_ARGS__)
+#define ILOG(...) PREVIEWER_LOG(PreviewerLog::LEVEL_INFO, "INFO", ##__VA_ARGS__)
+#define WLOG(...) PREVIEWER_LOG(PreviewerLog::LEVEL_WARN, "WARN", ##__VA_ARGS__)
+#define ELOG(...) PREVIEWER_LOG(PreviewerLog::LEVEL_ERROR, "ERROR", ##__VA_ARGS__)
 #define FLOG(...) PrintLog("FATAL", __FILE__, __FUNCTION__, __LINE__, ##__VA_ARGS__)
 
 void PrintLog(const char* level, const char* file, const char* func, int line,
               const char* fmt, ...);
 
+namespace PreviewerLog {
+    enum Level : int32_t {
+        LEVEL_DEBUG = 0,
+        LEVEL_INFO,
+        LEVEL_WARN,
+        LEVEL_ERROR,
+        LEVEL_FATAL
+    };
+    constexpr uint32_t DEFAULT_RATE_LIMIT = 0; // off unless -logRate is given
+    constexpr uint32_t MAX_RATE_LIMIT = 100000;
+
+    extern std::atomic<int32_t> g_logLevel;
+    extern std::atomic<uint32_t> g_logRateLimit;
+
+    inline bool IsLevelEnabled(int32_t level)
+    {
+        return level >= g_logLevel.load(std::memory_order_relaxed);
+    }
+    void SetLevel(int32_t level);
+    int32_t GetLevel();
+    // "debug", "info", "warn", "error" or "fatal".
+    bool ParseLevel(const std::string& name, int32_t& level);
+    const char* GetLevelName(int32_t level);
+    // 0 turns rate limiting off.
+    void SetRateLimit(uint32_t linesPerSecond);
+    uint32_t GetRateLimit();
+    void PrintSuppressed(const char* level, const char* file, const char* func, int line, uint64_t suppressed);
+
+    // Token bucket holding one second of lines. Its whole state is the time the bucket
+    // will be full again, so taking a token is a single compare-and-swap.
+    class RateLimiter {
+    public:
+        constexpr RateLimiter() : fullTime(0), suppressedCount(0) {}
+        // On success, suppressed receives the number of lines refused since the last success.
+        bool Acquire(uint64_t& suppressed);
+
+    private:
+        std::atomic<int64_t> fullTime; // us, steady clock
+        std::atomic<uint64_t> suppressedCount;
+    };
+}; // namespace PreviewerLog
+
 #endif // DEBUGLOG_H
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <cstdint>
+
+#include "LocalSocket.h"
+
+// Blocks the command loop until the command socket is readable or the next timer is due,
+// so an idle previewer does not wake up every millisecond.
+class Reactor {
+public:
+    Reactor();
+    virtual ~Reactor();
+    Reactor& operator=(const Reactor&) = delete;
+    Reactor(const Reactor&) = delete;
+
+    // Level triggered, only one socket is watched at a time.
+    bool WatchReadable(const LocalSocket& socket);
+    void Unwatch();
+    // Returns true if the watched socket became readable, timeout < 0 waits without limit.
+    bool Wait(int64_t timeout);
+    // Makes a pending or the next Wait return early, may be called from any thread.
+    void Wakeup() const;
+
+private:
+#ifndef _WIN32
+    int watchHandle;
+#ifdef __linux__
+    int epollHandle;
+    int timerHandle;
+    int wakeupHandle;
+    bool ArmTimer(int64_t timeout) const;
+#else
+    int wakeupHandles[2]; // self-pipe, read end first
+#endif // __linux__
+    void DrainWakeup() const;
+#endif // _WIN32
+};
+
+#endif // REACTOR_H
@@ -31,15 +31,30 @@ std::string TimeTool::GetFormatTime()
     return formatTime;
 }
 
+std::string TimeTool::GetFormatTime(std::chrono::system_clock::time_point time)
+{
+    return "[" + FormatTime(time) + "]";
+}
+
 std::string TimeTool::GetTraceFormatTime()
 {
     std::string traceTimeNow = FormateTimeNow();
     return traceTimeNow;
 }
 
+std::string TimeTool::GetTraceFormatTime(std::chrono::system_clock::time_point time)
+{
+    return FormatTime(time);
+}
+
 std::string TimeTool::FormateTimeNow()
 {
-    std::pair<tm, int64_t> timePair = GetCurrentTime();
+    return FormatTime(std::chrono::system_clock::now());
+}
+
+std::string TimeTool::FormatTime(std::chrono::system_clock::time_point time)
+{
+    std::pair<tm, int64_t> timePair = GetLocalTime(time);
     struct tm utcTime = timePair.first;
     int64_t msTime = timePair.second;
     const int fixedTimeWidth2 = 2;
@@ -75,9 +90,13 @@ std::string TimeTool::FixedTime(int32_t time, int32_t width)
 }
 
 std::pair<tm, int64_t> TimeTool::GetCurrentTime()
+{
+    return GetLocalTime(std::chrono::system_clock::now());
+}
+
+std::pair<tm, int64_t> TimeTool::GetLocalTime(std::chrono::system_clock::time_point now)
 {
     const std::time_t e8zone = 8 * 60 * 60 * 1000; // Time offset of GMT+08:00, in milliseconds, 8h*60m*60s*1000ms
-    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
     std::chrono::milliseconds millsec = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
     std::time_t ms = millsec.count() + e8zone;
     millsec = std::chrono::milliseconds(ms);
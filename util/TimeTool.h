@@ -16,17 +16,22 @@
 #ifndef TIMETOOL_H
 #define TIMETOOL_H
 
+#include <chrono>
 #include <string>
 
 class TimeTool {
 public:
     static std::string GetFormatTime();
+    static std::string GetFormatTime(std::chrono::system_clock::time_point time);
     static std::string GetTraceFormatTime();
+    static std::string GetTraceFormatTime(std::chrono::system_clock::time_point time);
 
 private:
     static std::string FormateTimeNow();
+    static std::string FormatTime(std::chrono::system_clock::time_point time);
     static std::string FixedTime(int32_t time, int32_t width);
     static std::pair<tm, int64_t> GetCurrentTime();
+    static std::pair<tm, int64_t> GetLocalTime(std::chrono::system_clock::time_point time);
 };
 
 #endif // TIMETOOL_H
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TraceEvent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "PreviewerEngineLog.h"
+
+std::atomic<bool> TraceEvent::isEnabled(false);
+
+// Trivially destructible, so it stays usable while the thread's other thread_locals are destroyed.
+static thread_local void* g_threadRing = nullptr;
+static thread_local bool g_isTraceThreadExited = false;
+
+TraceEvent& TraceEvent::GetInstance()
+{
+    static TraceEvent instance;
+    return instance;
+}
+
+void TraceEvent::SetEnabled(bool enabled)
+{
+    if (enabled && !isEnabled.load(std::memory_order_relaxed)) {
+        recordStart.store(Now(), std::memory_order_relaxed);
+    }
+    isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceEvent::Record(const char* name, int64_t start, int64_t end)
+{
+    Ring* ring = GetThreadRing();
+    if (ring != nullptr) {
+        ring->Write(name, start, end - start);
+    }
+}
+
+int64_t TraceEvent::Now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+size_t TraceEvent::GetEventCount()
+{
+    return CollectSpans().size();
+}
+
+int64_t TraceEvent::Dump(const std::string& path)
+{
+    size_t eventCount = 0;
+    std::string json = ToJson(eventCount);
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        ELOG("TraceEvent::Dump open %s failed", path.c_str());
+        return -1;
+    }
+    file.write(json.data(), json.size());
+    if (!file.good()) {
+        ELOG("TraceEvent::Dump write %s failed", path.c_str());
+        return -1;
+    }
+    ILOG("TraceEvent::Dump %zu events to %s", eventCount, path.c_str());
+    return static_cast<int64_t>(eventCount);
+}
+
+std::string TraceEvent::ToJson(size_t& eventCount)
+{
+    std::vector<Span> spans = CollectSpans();
+    std::sort(spans.begin(), spans.end(), [](const Span& lhs, const Span& rhs) { return lhs.start < rhs.start; });
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < spans.size(); i++) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "{\"name\":\"";
+        json += spans[i].name;
+        json += "\",\"cat\":\"previewer\",\"ph\":\"X\",\"ts\":";
+        json += std::to_string(spans[i].start);
+        json += ",\"dur\":";
+        json += std::to_string(spans[i].duration);
+        json += ",\"pid\":1,\"tid\":";
+        json += std::to_string(spans[i].threadId);
+        json += "}";
+    }
+    json += "]}";
+    eventCount = spans.size();
+    return json;
+}
+
+void TraceEvent::Ring::Write(const char* name, int64_t start, int64_t duration)
+{
+    uint64_t pos = writePos.load(std::memory_order_relaxed);
+    Slot& slot = slots[pos % RING_CAPACITY];
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed); // odd while the slot is written
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release); // 2: back to even once written
+    writePos.store(pos + 1, std::memory_order_release);
+}
+
+void TraceEvent::Ring::Read(int64_t since, std::vector<Span>& spans) const
+{
+    size_t count = static_cast<size_t>(std::min<uint64_t>(writePos.load(std::memory_order_acquire), RING_CAPACITY));
+    for (size_t i = 0; i < count; i++) {
+        const Slot& slot = slots[i];
+        uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        Span span = { slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+            slot.duration.load(std::memory_order_relaxed), threadId };
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((sequence & 1) != 0 || sequence != slot.sequence.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        if (span.name != nullptr && span.start >= since) {
+            spans.push_back(span);
+        }
+    }
+}
+
+TraceEvent::RingOwner::~RingOwner()
+{
+    if (ring != nullptr) {
+        ring->isClosed = true;
+    }
+    g_threadRing = nullptr;
+    g_isTraceThreadExited = true;
+}
+
+TraceEvent::Ring* TraceEvent::GetThreadRing()
+{
+    if (g_threadRing != nullptr) {
+        return static_cast<Ring*>(g_threadRing);
+    }
+    if (g_isTraceThreadExited) {
+        return nullptr;
+    }
+    static thread_local RingOwner owner;
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    if (rings.size() >= MAX_RING_COUNT) {
+        // Threads come and go; only the spans of exited threads are given up.
+        auto closed = std::find_if(rings.begin(), rings.end(), [](const std::shared_ptr<Ring>& ring) {
+            return ring->isClosed.load();
+        });
+        if (closed == rings.end()) {
+            return nullptr;
+        }
+        rings.erase(closed);
+    }
+    owner.ring = std::make_shared<Ring>(nextThreadId++);
+    rings.push_back(owner.ring);
+    g_threadRing = owner.ring.get();
+    return owner.ring.get();
+}
+
+std::vector<TraceEvent::Span> TraceEvent::CollectSpans()
+{
+    std::vector<std::shared_ptr<Ring>> current;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        current = rings;
+    }
+    std::vector<Span> spans;
+    int64_t since = recordStart.load(std::memory_order_relaxed);
+    for (const auto& ring : current) {
+        ring->Read(since, spans);
+    }
+    return spans;
+}
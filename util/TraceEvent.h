@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACEEVENT_H
+#define TRACEEVENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define TRACE_EVENT_CONCAT_INNER(a, b) a##b
+#define TRACE_EVENT_CONCAT(a, b) TRACE_EVENT_CONCAT_INNER(a, b)
+// Records the enclosing scope as a span. name must be a string literal.
+#define TRACE_EVENT_SCOPE(name) TraceEventScope TRACE_EVENT_CONCAT(traceEventScope, __LINE__)(name)
+
+// Spans are kept in a ring per recording thread, the newest overwriting the oldest,
+// and exported as a Chrome trace_event file that chrome://tracing and Perfetto can open.
+class TraceEvent {
+public:
+    static TraceEvent& GetInstance();
+    static bool IsEnabled()
+    {
+        return isEnabled.load(std::memory_order_relaxed);
+    }
+    // Enabling starts a new recording: spans from before it are no longer exported.
+    void SetEnabled(bool enabled);
+    // Owner thread only. name must outlive the recorder.
+    void Record(const char* name, int64_t start, int64_t end);
+    static int64_t Now(); // us, steady clock
+    size_t GetEventCount();
+    // Writes the recorded spans and returns how many were written, -1 if the file can not be written.
+    int64_t Dump(const std::string& path);
+    std::string ToJson(size_t& eventCount);
+
+private:
+    TraceEvent() = default;
+    ~TraceEvent() = default;
+    TraceEvent& operator=(const TraceEvent&) = delete;
+    TraceEvent(const TraceEvent&) = delete;
+
+    static constexpr size_t RING_CAPACITY = 8192;
+    static constexpr size_t MAX_RING_COUNT = 64;
+    struct Span {
+        const char* name;
+        int64_t start;
+        int64_t duration;
+        uint32_t threadId;
+    };
+    // A slot is rewritten in place, so the reader checks its sequence before and after
+    // copying and skips the slot if the owner thread was writing it.
+    struct Slot {
+        std::atomic<uint32_t> sequence { 0 };
+        std::atomic<const char*> name { nullptr };
+        std::atomic<int64_t> start { 0 };
+        std::atomic<int64_t> duration { 0 };
+    };
+    struct Ring {
+        explicit Ring(uint32_t threadId) : threadId(threadId) {}
+        void Write(const char* name, int64_t start, int64_t duration);
+        void Read(int64_t since, std::vector<Span>& spans) const;
+        uint32_t threadId;
+        std::atomic<uint64_t> writePos { 0 };
+        std::atomic<bool> isClosed { false };
+        Slot slots[RING_CAPACITY];
+    };
+    struct RingOwner {
+        ~RingOwner();
+        std::shared_ptr<Ring> ring;
+    };
+    Ring* GetThreadRing();
+    std::vector<Span> CollectSpans();
+
+    static std::atomic<bool> isEnabled;
+    std::atomic<int64_t> recordStart { 0 };
+    std::mutex ringsMutex; // guards rings and nextThreadId
+    std::vector<std::shared_ptr<Ring>> rings;
+    uint32_t nextThreadId = 1;
+};
+
+class TraceEventScope {
+public:
+    explicit TraceEventScope(const char* name) : name(name), start(0)
+    {
+        if (TraceEvent::IsEnabled()) {
+            start = TraceEvent::Now();
+        }
+    }
+    ~TraceEventScope()
+    {
+        if (start != 0) {
+            TraceEvent::GetInstance().Record(name, start, TraceEvent::Now());
+        }
+    }
+    TraceEventScope& operator=(const TraceEventScope&) = delete;
+    TraceEventScope(const TraceEventScope&) = delete;
+
+private:
+    const char* name;
+    int64_t start;
+};
+
+#endif // TRACEEVENT_H
@@ -14,6 +14,8 @@
  */
 
 #include "TraceTool.h"
+#include <chrono>
+#include <cstring>
 #include "JsonReader.h"
 #include "CommandParser.h"
 #include "PreviewerEngineLog.h"
@@ -22,6 +24,8 @@
 
 void TraceTool::InitPipe()
 {
+    StopWriter();
+    isReady = false;
     if (socket != nullptr) {
         socket.reset();
         ELOG("TraceTool::InitPipe socket is not null");
@@ -38,6 +42,7 @@ void TraceTool::InitPipe()
         return;
     }
     isReady = true;
+    StartWriter();
     ELOG("TraceTool::pipe connect successed");
 }
 
@@ -49,33 +54,51 @@ TraceTool& TraceTool::GetInstance()
 
 void TraceTool::SendTraceData(const Json2::Value& value)
 {
-    *(GetInstance().socket) << value.ToString();
+    if (GetInstance().socket == nullptr) {
+        ELOG("TraceTool::SendTraceData socket is null");
+        return;
+    }
+    GetInstance().socket->WriteMessage(value.ToString());
 }
 
-void TraceTool::HandleTrace(const std::string msg) const
+void TraceTool::HandleTrace(const char* msg)
 {
-    if (!isReady) {
+    if (!isReady.load(std::memory_order_relaxed)) {
         ILOG("Trace pipe is not prepared");
         return;
     }
-    Json2::Value val = JsonReader::CreateObject();
-    val.Add("sid", "10007");
-    Json2::Value detail = JsonReader::CreateObject();
-    detail.Add("ProjectId", CommandParser::GetInstance().GetProjectID().c_str());
-    detail.Add("device", CommandParser::GetInstance().GetDeviceType().c_str());
-    detail.Add("time", TimeTool::GetTraceFormatTime().c_str());
-    val.Add("detail", detail);
-    val.Add("action", msg.c_str());
-    SendTraceData(val);
+    int64_t time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    bool isWritten = ring.TryWrite([time, msg](TraceRecord& record) {
+        record.time = time;
+        record.length = strnlen(msg, MAX_ACTION_LENGTH);
+        memcpy(record.action, msg, record.length);
+    });
+    if (!isWritten) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    wakeSignal.Notify();
+}
+
+void TraceTool::Flush()
+{
+    while (WriteBatch() > 0) {}
 }
 
-TraceTool::TraceTool() : socket(nullptr), isReady(false)
+uint64_t TraceTool::GetDroppedCount() const
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+TraceTool::TraceTool() : socket(nullptr), isReady(false), droppedCount(0), reportedDropCount(0)
 {
     InitPipe();
 }
 
 TraceTool::~TraceTool()
 {
+    StopWriter();
     if (socket != nullptr) {
         socket->DisconnectFromServer();
         socket = nullptr;
@@ -86,3 +109,74 @@ std::string TraceTool::GetTracePipeName() const
 {
     return CommandParser::GetInstance().Value("ts");
 }
+
+void TraceTool::StartWriter()
+{
+    wakeSignal.Restart();
+    writer = std::thread(&TraceTool::RunWriter, this);
+}
+
+void TraceTool::StopWriter()
+{
+    wakeSignal.Stop();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    Flush();
+}
+
+void TraceTool::RunWriter()
+{
+    while (!wakeSignal.IsStopped()) {
+        size_t count = WriteBatch();
+        if (count == MAX_BATCH_SIZE) {
+            continue;
+        }
+        if (count > 0) {
+            wakeSignal.Sleep(FLUSH_INTERVAL);
+            continue;
+        }
+        // Checked again once producers know the writer may sleep, so no signal is missed.
+        wakeSignal.PrepareWait();
+        if (WriteBatch() > 0) {
+            wakeSignal.CancelWait();
+            continue;
+        }
+        wakeSignal.Wait();
+    }
+}
+
+size_t TraceTool::WriteBatch()
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+    std::string projectId = CommandParser::GetInstance().GetProjectID();
+    std::string device = CommandParser::GetInstance().GetDeviceType();
+    std::string buffer;
+    size_t count = 0;
+    while (count < MAX_BATCH_SIZE && ring.TryRead([&buffer, &projectId, &device](const TraceRecord& record) {
+        std::chrono::system_clock::time_point time { std::chrono::milliseconds(record.time) };
+        Json2::Value val = JsonReader::CreateObject();
+        val.Add("sid", "10007");
+        Json2::Value detail = JsonReader::CreateObject();
+        detail.Add("ProjectId", projectId.c_str());
+        detail.Add("device", device.c_str());
+        detail.Add("time", TimeTool::GetTraceFormatTime(time).c_str());
+        val.Add("detail", detail);
+        val.Add("action", std::string(record.action, record.length).c_str());
+        buffer += val.ToString();
+        buffer.push_back('\0');
+    })) {
+        count++;
+    }
+    uint64_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != reportedDropCount) {
+        ELOG("TraceTool dropped %llu trace records", static_cast<unsigned long long>(dropped - reportedDropCount));
+        reportedDropCount = dropped;
+    }
+    if (count == 0 || socket == nullptr) {
+        return count;
+    }
+    LocalSocket::Segment segment = { buffer.data(), buffer.length() };
+    socket->WriteSegments(&segment, 1);
+    return count;
+}
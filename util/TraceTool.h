@@ -16,7 +16,13 @@
 #ifndef TRACETOOL_H
 #define TRACETOOL_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "MpscRing.h"
+#include "WakeSignal.h"
 
 namespace Json2 {
     class Value;
@@ -29,14 +35,37 @@ public:
     static TraceTool& GetInstance();
     static void SendTraceData(const Json2::Value& value);
     void InitPipe();
-    void HandleTrace(const std::string msg) const;
+    // Queues the action for the writer thread. Never blocks: the record is dropped if the ring is full.
+    void HandleTrace(const char* msg);
+    // Writes every queued record before returning.
+    void Flush();
+    uint64_t GetDroppedCount() const;
 
 private:
     TraceTool();
     ~TraceTool();
+    static constexpr size_t MAX_ACTION_LENGTH = 48;
+    static constexpr size_t RING_CAPACITY = 1024;
+    static constexpr size_t MAX_BATCH_SIZE = 64;
+    static constexpr int64_t FLUSH_INTERVAL = 10; // ms between the batches of a busy ring
+    struct TraceRecord {
+        int64_t time; // ms since epoch
+        size_t length;
+        char action[MAX_ACTION_LENGTH];
+    };
     std::unique_ptr<LocalSocket> socket;
     std::string GetTracePipeName() const;
-    bool isReady;
+    void StartWriter();
+    void StopWriter();
+    void RunWriter();
+    size_t WriteBatch();
+    std::atomic<bool> isReady;
+    std::atomic<uint64_t> droppedCount;
+    uint64_t reportedDropCount;
+    MpscRing<TraceRecord, RING_CAPACITY> ring;
+    std::mutex writerMutex; // serializes WriteBatch between the writer thread and Flush
+    WakeSignal wakeSignal; // HandleTrace wakes up the idle writer
+    std::thread writer;
 };
 
 #endif // TRACETOOL_H
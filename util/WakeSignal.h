@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef WAKESIGNAL_H
+#define WAKESIGNAL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Wakes a consumer thread that sleeps while its queues are empty. Producers only take the lock
+// when the consumer said it is about to sleep, otherwise a Notify costs them one fence and a load.
+class WakeSignal {
+public:
+    WakeSignal() : isWaiting(false), isSignalled(false), isStopped(false) {}
+    ~WakeSignal() {}
+    WakeSignal& operator=(const WakeSignal&) = delete;
+    WakeSignal(const WakeSignal&) = delete;
+
+    // Any thread, after the item is queued.
+    void Notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!isWaiting.load(std::memory_order_relaxed) || !isWaiting.exchange(false)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isSignalled = true;
+        }
+        condition.notify_one();
+    }
+
+    // Consumer thread, before it checks its queues one last time. An item queued after this is
+    // either seen by that check or wakes up the Wait that follows.
+    void PrepareWait()
+    {
+        isWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // Consumer thread, the last check found work.
+    void CancelWait()
+    {
+        isWaiting.store(false, std::memory_order_relaxed);
+    }
+
+    // Consumer thread, sleeps until Notify or Stop.
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return isSignalled || isStopped; });
+        isSignalled = false;
+    }
+
+    // Consumer thread, sleeps for the interval or until Stop. Lets a busy consumer gather more work per pass.
+    void Sleep(int64_t milliseconds)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait_for(lock, std::chrono::milliseconds(milliseconds), [this]() { return isStopped; });
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopped = true;
+        }
+        condition.notify_all();
+    }
+
+    // Before a new consumer thread is started.
+    void Restart()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopped = false;
+        isSignalled = false;
+    }
+
+    bool IsStopped()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return isStopped;
+    }
+
+private:
+    std::atomic<bool> isWaiting;
+    std::mutex mutex; // guards the members below
+    std::condition_variable condition;
+    bool isSignalled;
+    bool isStopped;
+};
+
+#endif // WAKESIGNAL_H
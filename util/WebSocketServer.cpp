@@ -16,7 +16,9 @@
 #include <atomic>
 #include <thread>
 #include "CommandLineInterface.h"
+#include "PerfStats.h"
 #include "PreviewerEngineLog.h"
+#include "TraceEvent.h"
 #include "WebSocketServer.h"
 
 lws* WebSocketServer::webSocket = nullptr;
@@ -165,10 +167,13 @@ void WebSocketServer::Run()
 
 size_t WebSocketServer::WriteData(unsigned char* data, size_t length)
 {
+    TRACE_EVENT_SCOPE("WriteWebSocket");
     while (webSocketWritable != WebSocketState::WRITEABLE) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
     if (webSocket != nullptr && webSocketWritable == WebSocketState::WRITEABLE) {
+        static PerfHistogram& frameBytes = PerfStats::GetInstance().GetHistogram(PerfMetric::FRAME_BYTES);
+        frameBytes.Record(length);
         return lws_write(webSocket, data, length, LWS_WRITE_BINARY);
     }
     return 0;
@@ -21,6 +21,7 @@
 #include <sstream>
 #include <unistd.h>
 
+#include "AsyncLogger.h"
 #include "PreviewerEngineLog.h"
 #include "PublicMethods.h"
 
@@ -51,4 +52,7 @@ void CrashHandler::ApplicationCrashHandler(int signal)
 
     int8_t crashEndLog[] = "\n[JsEngine Crash]Engine Crash Info End.\n";
     write(STDERR_FILENO, crashEndLog, sizeof(crashEndLog) - 1);
+    // The last lines before the crash are still queued, written after the report so a fault in
+    // the logger cannot cost the backtrace.
+    AsyncLogger::GetInstance().FlushOnCrash();
 }
\ No newline at end of file
@@ -15,14 +15,20 @@
 
 #include "LocalSocket.h"
 
+#include <cerrno>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 
 #include "PreviewerEngineLog.h"
 
-LocalSocket::LocalSocket() : socketHandle(-1) {}
+namespace {
+    constexpr int MAX_WRITE_SEGMENTS = 16; // iovec entries handed to one writev call
+}
+
+LocalSocket::LocalSocket() : isMessageFramed(false), socketHandle(-1) {}
 
 LocalSocket::~LocalSocket()
 {
@@ -103,23 +109,103 @@ int64_t LocalSocket::ReadData(char* data, size_t length) const
     return readSize;
 }
 
+int64_t LocalSocket::GetPendingWriteBytes() const
+{
+    int pendingBytes = 0;
+#ifdef __APPLE__
+    socklen_t length = sizeof(pendingBytes);
+    if (getsockopt(socketHandle, SOL_SOCKET, SO_NWRITE, &pendingBytes, &length) < 0) {
+        return -1;
+    }
+#else
+    if (ioctl(socketHandle, TIOCOUTQ, &pendingBytes) < 0) {
+        return -1;
+    }
+#endif // __APPLE__
+    return pendingBytes;
+}
+
 size_t LocalSocket::WriteData(const void* data, size_t length) const
 {
     if (length > UINT32_MAX) {
         ELOG("LocalSocket::WriteData length must < %d", UINT32_MAX);
         return 0;
     }
-    std::string str((const char*)data);
-    ssize_t writeSize = send(socketHandle, str.c_str(), length, 0);
-    if (writeSize == 0) {
-        ELOG("LocalSocket::WriteData Server is shut down");
+    Segment segment = { data, length };
+    return WriteSegments(&segment, 1);
+}
+
+size_t LocalSocket::WriteSegments(const Segment* segments, size_t count) const
+{
+    if (segments == nullptr || count == 0) {
+        return 0;
+    }
+    if (socketHandle < 0) {
+        return 0; // never connected, as when replaying a recorded session
+    }
+    size_t totalSize = 0;
+    size_t index = 0;
+    size_t offset = 0; // bytes of segments[index] already written
+    while (index < count) {
+        struct iovec iov[MAX_WRITE_SEGMENTS];
+        int iovCount = 0;
+        for (size_t i = index; i < count && iovCount < MAX_WRITE_SEGMENTS; i++) {
+            size_t skip = (i == index) ? offset : 0;
+            if (segments[i].length <= skip) {
+                continue;
+            }
+            iov[iovCount].iov_base = const_cast<char*>(static_cast<const char*>(segments[i].data)) + skip;
+            iov[iovCount].iov_len = segments[i].length - skip;
+            iovCount++;
+        }
+        if (iovCount == 0) {
+            break;
+        }
+        ssize_t writeSize = writev(socketHandle, iov, iovCount);
+        if (writeSize < 0 && errno == EINTR) {
+            continue;
+        }
+        if (writeSize == 0) {
+            ELOG("LocalSocket::WriteSegments Server is shut down");
+            break;
+        }
+        if (writeSize < 0) {
+            ELOG("LocalSocket::WriteSegments writev failed, errno: %d", errno);
+            break;
+        }
+        totalSize += static_cast<size_t>(writeSize);
+        // Skip the segments that are completely written, a partial one is resumed at offset.
+        size_t remain = static_cast<size_t>(writeSize);
+        while (index < count && remain >= segments[index].length - offset) {
+            remain -= segments[index].length - offset;
+            index++;
+            offset = 0;
+        }
+        offset += remain;
     }
+    return totalSize;
+}
 
-    if (writeSize < 0) {
-        ELOG("LocalSocket::WriteData ReadFile failed");
+size_t LocalSocket::WriteMessage(const std::string& message, uint32_t requestId) const
+{
+    if (IsMessageFramed()) {
+        return WriteFrame(MessageFrame::TYPE_JSON, requestId, message.c_str(), message.length());
     }
+    Segment segment = { message.c_str(), message.length() + 1 };
+    return WriteSegments(&segment, 1);
+}
 
-    return writeSize;
+size_t LocalSocket::WriteFrame(uint16_t type, uint32_t requestId, const void* payload, size_t length) const
+{
+    if (length > MessageFrame::MAX_PAYLOAD_LENGTH) {
+        ELOG("LocalSocket::WriteFrame length must <= %u", MessageFrame::MAX_PAYLOAD_LENGTH);
+        return 0;
+    }
+    MessageFrameHeader header = { MessageFrame::MAGIC, static_cast<uint32_t>(length), type, 0, requestId };
+    uint8_t headerBuffer[MessageFrame::HEADER_SIZE];
+    MessageFrame::EncodeHeader(header, headerBuffer);
+    Segment segments[] = { { headerBuffer, sizeof(headerBuffer) }, { payload, length } };
+    return WriteSegments(segments, sizeof(segments) / sizeof(segments[0]));
 }
 
 const LocalSocket& LocalSocket::operator>>(std::string& data) const
@@ -133,6 +219,6 @@ const LocalSocket& LocalSocket::operator>>(std::string& data) const
 
 const LocalSocket& LocalSocket::operator<<(const std::string data) const
 {
-    WriteData(data.c_str(), data.length() + 1);
+    WriteMessage(data);
     return *this;
 }
\ No newline at end of file
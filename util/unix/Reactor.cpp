@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Reactor.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <fcntl.h>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif // __linux__
+
+#include "PreviewerEngineLog.h"
+
+namespace {
+    constexpr int64_t MILLISECONDS_PER_SECOND = 1000;
+#ifdef __linux__
+    constexpr int64_t NANOSECONDS_PER_MILLISECOND = 1000000;
+    constexpr int MAX_EVENTS = 3; // command socket, timer and wakeup
+#endif // __linux__
+}
+
+#ifdef __linux__
+Reactor::Reactor() : watchHandle(-1), epollHandle(-1), timerHandle(-1), wakeupHandle(-1)
+{
+    epollHandle = epoll_create1(EPOLL_CLOEXEC);
+    if (epollHandle < 0) {
+        ELOG("Reactor::Reactor epoll_create1 failed, errno: %d", errno);
+        return;
+    }
+    timerHandle = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerHandle < 0) {
+        ELOG("Reactor::Reactor timerfd_create failed, errno: %d", errno);
+        return;
+    }
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = timerHandle;
+    if (epoll_ctl(epollHandle, EPOLL_CTL_ADD, timerHandle, &event) < 0) {
+        ELOG("Reactor::Reactor watch timer failed, errno: %d", errno);
+    }
+    wakeupHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeupHandle < 0) {
+        ELOG("Reactor::Reactor eventfd failed, errno: %d", errno);
+        return;
+    }
+    event.data.fd = wakeupHandle;
+    if (epoll_ctl(epollHandle, EPOLL_CTL_ADD, wakeupHandle, &event) < 0) {
+        ELOG("Reactor::Reactor watch wakeup failed, errno: %d", errno);
+    }
+}
+
+Reactor::~Reactor()
+{
+    if (wakeupHandle >= 0) {
+        close(wakeupHandle);
+    }
+    if (timerHandle >= 0) {
+        close(timerHandle);
+    }
+    if (epollHandle >= 0) {
+        close(epollHandle);
+    }
+}
+
+bool Reactor::WatchReadable(const LocalSocket& socket)
+{
+    Unwatch();
+    if (epollHandle < 0 || socket.socketHandle < 0) {
+        return false;
+    }
+    struct epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = socket.socketHandle;
+    if (epoll_ctl(epollHandle, EPOLL_CTL_ADD, socket.socketHandle, &event) < 0) {
+        ELOG("Reactor::WatchReadable epoll_ctl failed, errno: %d", errno);
+        return false;
+    }
+    watchHandle = socket.socketHandle;
+    return true;
+}
+
+void Reactor::Unwatch()
+{
+    if (watchHandle >= 0 && epollHandle >= 0) {
+        epoll_ctl(epollHandle, EPOLL_CTL_DEL, watchHandle, nullptr);
+    }
+    watchHandle = -1;
+}
+
+bool Reactor::ArmTimer(int64_t timeout) const
+{
+    // Setting the timer also clears expirations left over from the previous wait.
+    struct itimerspec spec = {};
+    if (timeout > 0) {
+        spec.it_value.tv_sec = timeout / MILLISECONDS_PER_SECOND;
+        spec.it_value.tv_nsec = (timeout % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND;
+    }
+    return timerfd_settime(timerHandle, 0, &spec, nullptr) == 0;
+}
+
+bool Reactor::Wait(int64_t timeout)
+{
+    if (epollHandle < 0 || timerHandle < 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return false;
+    }
+    if (!ArmTimer(timeout)) {
+        ELOG("Reactor::Wait timerfd_settime failed, errno: %d", errno);
+        return false;
+    }
+    struct epoll_event events[MAX_EVENTS];
+    int count = epoll_wait(epollHandle, events, MAX_EVENTS, (timeout == 0) ? 0 : -1);
+    bool readable = false;
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.fd == wakeupHandle) {
+            DrainWakeup();
+        }
+        if (events[i].data.fd != watchHandle) {
+            continue;
+        }
+        readable = true;
+        if ((events[i].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) != 0) {
+            // A closed peer stays readable forever, stop watching it to avoid a busy loop.
+            ELOG("Reactor::Wait command socket is closed by peer");
+            Unwatch();
+        }
+    }
+    return readable;
+}
+
+void Reactor::Wakeup() const
+{
+    uint64_t value = 1;
+    if (wakeupHandle >= 0 && write(wakeupHandle, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+        ELOG("Reactor::Wakeup write failed, errno: %d", errno);
+    }
+}
+
+void Reactor::DrainWakeup() const
+{
+    uint64_t value = 0;
+    if (read(wakeupHandle, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+        ELOG("Reactor::DrainWakeup read failed, errno: %d", errno);
+    }
+}
+#else
+Reactor::Reactor() : watchHandle(-1), wakeupHandles {-1, -1}
+{
+    if (pipe(wakeupHandles) < 0) {
+        ELOG("Reactor::Reactor pipe failed, errno: %d", errno);
+        wakeupHandles[0] = -1;
+        wakeupHandles[1] = -1;
+        return;
+    }
+    for (int handle : wakeupHandles) {
+        fcntl(handle, F_SETFL, fcntl(handle, F_GETFL) | O_NONBLOCK);
+        fcntl(handle, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+Reactor::~Reactor()
+{
+    for (int handle : wakeupHandles) {
+        if (handle >= 0) {
+            close(handle);
+        }
+    }
+}
+
+bool Reactor::WatchReadable(const LocalSocket& socket)
+{
+    watchHandle = socket.socketHandle;
+    return watchHandle >= 0;
+}
+
+void Reactor::Unwatch()
+{
+    watchHandle = -1;
+}
+
+bool Reactor::Wait(int64_t timeout)
+{
+    if (timeout == 0) {
+        return false;
+    }
+    if (watchHandle < 0 && wakeupHandles[0] < 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout < 0 ? MILLISECONDS_PER_SECOND : timeout));
+        return false;
+    }
+    struct pollfd fds[] = { { watchHandle, POLLIN, 0 }, { wakeupHandles[0], POLLIN, 0 } };
+    int count = poll(fds, sizeof(fds) / sizeof(fds[0]), (timeout < 0) ? -1 : static_cast<int>(timeout));
+    if (count <= 0) {
+        return false;
+    }
+    if ((fds[1].revents & POLLIN) != 0) {
+        DrainWakeup();
+    }
+    if (fds[0].revents == 0) {
+        return false;
+    }
+    if ((fds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) != 0) {
+        // A closed peer stays readable forever, stop watching it to avoid a busy loop.
+        ELOG("Reactor::Wait command socket is closed by peer");
+        Unwatch();
+    }
+    return true;
+}
+
+void Reactor::Wakeup() const
+{
+    char value = 1;
+    if (wakeupHandles[1] >= 0 && write(wakeupHandles[1], &value, sizeof(value)) < 0 && errno != EAGAIN) {
+        ELOG("Reactor::Wakeup write failed, errno: %d", errno);
+    }
+}
+
+void Reactor::DrainWakeup() const
+{
+    char buffer[64]; // 64 wakeups per read
+    while (read(wakeupHandles[0], buffer, sizeof(buffer)) > 0) {
+    }
+}
+#endif // __linux__
@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <windows.h>
 
+#include "AsyncLogger.h"
 #include "PreviewerEngineLog.h"
 #include "PublicMethods.h"
 
@@ -110,6 +111,9 @@ LONG CrashHandler::ApplicationCrashHandler(EXCEPTION_POINTERS *exception)
 
     int8_t crashEndLog[] = "\n[JsEngine Crash]Engine Crash Info End.\n";
     write(STDERR_FILENO, crashEndLog, sizeof(crashEndLog) - 1);
+    // The last lines before the crash are still queued, written after the report so a fault in
+    // the logger cannot cost the backtrace.
+    AsyncLogger::GetInstance().FlushOnCrash();
     return 0;
 }
 
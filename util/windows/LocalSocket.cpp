@@ -17,7 +17,7 @@
 
 #include "PreviewerEngineLog.h"
 
-LocalSocket::LocalSocket() : pipeHandle(nullptr) {}
+LocalSocket::LocalSocket() : isMessageFramed(false), pipeHandle(nullptr) {}
 
 LocalSocket::~LocalSocket() {}
 
@@ -85,6 +85,12 @@ int64_t LocalSocket::ReadData(char* data, size_t length) const
     return readSize;
 }
 
+int64_t LocalSocket::GetPendingWriteBytes() const
+{
+    // A named pipe does not report what its client has not read yet.
+    return -1;
+}
+
 size_t LocalSocket::WriteData(const void* data, size_t length) const
 {
     if (length > UINT32_MAX) {
@@ -101,9 +107,59 @@ size_t LocalSocket::WriteData(const void* data, size_t length) const
     return writeSize;
 }
 
+size_t LocalSocket::WriteSegments(const Segment* segments, size_t count) const
+{
+    if (segments == nullptr || count == 0) {
+        return 0;
+    }
+    if (pipeHandle == nullptr || pipeHandle == INVALID_HANDLE_VALUE) {
+        return 0; // never connected, as when replaying a recorded session
+    }
+    // Named pipes have no gathered write, so every segment is written in place without staging.
+    size_t totalSize = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char* data = static_cast<const char*>(segments[i].data);
+        size_t remain = segments[i].length;
+        while (remain > 0) {
+            DWORD chunkSize = static_cast<DWORD>(remain > UINT32_MAX ? UINT32_MAX : remain);
+            DWORD writeSize = 0;
+            if (!WriteFile(pipeHandle, data, chunkSize, &writeSize, nullptr) || writeSize == 0) {
+                ELOG("LocalSocket::WriteSegments WriteFile failed: %d", GetLastError());
+                return totalSize;
+            }
+            data += writeSize;
+            remain -= writeSize;
+            totalSize += writeSize;
+        }
+    }
+    return totalSize;
+}
+
+size_t LocalSocket::WriteMessage(const std::string& message, uint32_t requestId) const
+{
+    if (IsMessageFramed()) {
+        return WriteFrame(MessageFrame::TYPE_JSON, requestId, message.c_str(), message.length());
+    }
+    Segment segment = { message.c_str(), message.length() + 1 };
+    return WriteSegments(&segment, 1);
+}
+
+size_t LocalSocket::WriteFrame(uint16_t type, uint32_t requestId, const void* payload, size_t length) const
+{
+    if (length > MessageFrame::MAX_PAYLOAD_LENGTH) {
+        ELOG("LocalSocket::WriteFrame length must <= %u", MessageFrame::MAX_PAYLOAD_LENGTH);
+        return 0;
+    }
+    MessageFrameHeader header = { MessageFrame::MAGIC, static_cast<uint32_t>(length), type, 0, requestId };
+    uint8_t headerBuffer[MessageFrame::HEADER_SIZE];
+    MessageFrame::EncodeHeader(header, headerBuffer);
+    Segment segments[] = { { headerBuffer, sizeof(headerBuffer) }, { payload, length } };
+    return WriteSegments(segments, sizeof(segments) / sizeof(segments[0]));
+}
+
 const LocalSocket& LocalSocket::operator<<(const std::string data) const
 {
-    WriteData(data.c_str(), data.length() + 1);
+    WriteMessage(data);
     return *this;
 }
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Reactor.h"
+
+#include <chrono>
+#include <thread>
+
+Reactor::Reactor() {}
+
+Reactor::~Reactor() {}
+
+bool Reactor::WatchReadable(const LocalSocket& socket)
+{
+    (void)socket;
+    return true;
+}
+
+void Reactor::Unwatch() {}
+
+// The command pipe is opened without FILE_FLAG_OVERLAPPED and cannot be waited on,
+// keep polling it every millisecond.
+bool Reactor::Wait(int64_t timeout)
+{
+    if (timeout != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+// Wait returns after a millisecond anyway.
+void Reactor::Wakeup() const {}